@@ -0,0 +1,112 @@
+#include "benchmark/benchmark_api.h"
+#include "chd.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// 32 MiB of hard disk data compressed with chdman's default codecs
+constexpr uint32_t BENCH_HUNK_BYTES = 4096 * 4;
+constexpr uint32_t BENCH_HUNKS = 2048;
+
+class bench_compressor : public chd_file_compressor
+{
+protected:
+	virtual uint32_t read_data(void *dest, uint64_t offset, uint32_t length) override
+	{
+		// compressible but not trivially so: text-like runs with some noise,
+		// and every eighth hunk repeating an earlier one
+		auto *const bytes = reinterpret_cast<uint8_t *>(dest);
+		for (uint32_t index = 0; index < length; index++)
+		{
+			uint64_t const pos = offset + index;
+			uint64_t const hunk = pos / BENCH_HUNK_BYTES;
+			uint64_t const seed = (hunk % 8) ? hunk : (hunk / 2);
+			uint32_t value = uint32_t((seed * 2654435761U) ^ ((pos % BENCH_HUNK_BYTES) * 40503U));
+			value ^= value >> 13;
+			bytes[index] = ((value & 7) == 0) ? uint8_t(value >> 8) : uint8_t('a' + (value % 26));
+		}
+		return length;
+	}
+};
+
+class bench_chd
+{
+public:
+	bench_chd() : m_file(std::tmpfile())
+	{
+		chd_codec_type const compression[4] = { CHD_CODEC_LZMA, CHD_CODEC_ZLIB, CHD_CODEC_HUFFMAN, CHD_CODEC_FLAC };
+		bench_compressor compressor;
+		if (compressor.create(util::stdio_read_write_noclose(m_file), uint64_t(BENCH_HUNKS) * BENCH_HUNK_BYTES, BENCH_HUNK_BYTES, 512, compression))
+			return;
+		compressor.compress_begin();
+		double progress, ratio;
+		std::error_condition err;
+		while ((err = compressor.compress_continue(progress, ratio)) == chd_file::error::WALKING_PARENT || err == chd_file::error::COMPRESSING) { }
+		compressor.close();
+		if (!err)
+			m_chd.open(util::stdio_read_write_noclose(m_file));
+	}
+
+	~bench_chd()
+	{
+		m_chd.close();
+		if (m_file)
+			std::fclose(m_file);
+	}
+
+	chd_file &chd() { return m_chd; }
+
+private:
+	FILE *m_file;
+	chd_file m_chd;
+};
+
+chd_file &bench_file()
+{
+	static bench_chd s_chd;
+	return s_chd.chd();
+}
+
+} // anonymous namespace
+
+static void BM_chd_read_serial(benchmark::State& state) {
+	chd_file &chd = bench_file();
+	if (!chd.opened()) {
+		state.SkipWithError("couldn't create CHD");
+		return;
+	}
+	std::vector<uint8_t> buffer(chd.hunk_bytes());
+	while (state.KeepRunning()) {
+		for (uint32_t hunknum = 0; hunknum < chd.hunk_count(); hunknum++)
+			if (chd.read_hunk(hunknum, &buffer[0])) {
+				state.SkipWithError("read_hunk failed");
+				return;
+			}
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * chd.logical_bytes());
+}
+BENCHMARK(BM_chd_read_serial)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// the argument is the batch size in hunks; chdman uses 1 MiB batches
+static void BM_chd_read_parallel(benchmark::State& state) {
+	chd_file &chd = bench_file();
+	if (!chd.opened()) {
+		state.SkipWithError("couldn't create CHD");
+		return;
+	}
+	uint32_t const batch = state.range(0);
+	std::vector<uint8_t> buffer(uint64_t(batch) * chd.hunk_bytes());
+	chd_parallel_reader reader(chd);
+	while (state.KeepRunning()) {
+		for (uint32_t hunknum = 0; hunknum < chd.hunk_count(); hunknum += batch)
+			if (reader.read_hunks(hunknum, std::min(batch, chd.hunk_count() - hunknum), &buffer[0])) {
+				state.SkipWithError("read_hunks failed");
+				return;
+			}
+	}
+	state.SetBytesProcessed(int64_t(state.iterations()) * chd.logical_bytes());
+}
+BENCHMARK(BM_chd_read_parallel)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,76 @@
+#include "benchmark/benchmark_api.h"
+#include "soundsimd.h"
+
+#include <vector>
+
+// the argument is the run length in samples; a stream update at 48 kHz
+// covers 960 samples
+namespace {
+
+struct sound_buffers {
+	sound_buffers(int count) : src(count), dest(count), right(count) {
+		for (int index = 0; index < count; index++)
+			src[index] = float(index % 97) / 97.0f - 0.5f;
+	}
+	std::vector<float> src, dest, right;
+};
+
+} // anonymous namespace
+
+static void BM_sound_mix_scalar(benchmark::State& state) {
+	sound_buffers buf(state.range(0));
+	while (state.KeepRunning()) {
+		float *const dest = &buf.dest[0];
+		float const *const src = &buf.src[0];
+		for (int index = 0; index < state.range(0); index++)
+			dest[index] += src[index] * 0.5f;
+		benchmark::DoNotOptimize(buf.dest[0]);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sound_mix_scalar)->Arg(64)->Arg(960);
+
+static void BM_sound_mix(benchmark::State& state) {
+	sound_buffers buf(state.range(0));
+	while (state.KeepRunning()) {
+		emu::sound_simd::mix(&buf.dest[0], &buf.src[0], 0.5f, state.range(0));
+		benchmark::DoNotOptimize(buf.dest[0]);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+	state.SetLabel(emu::sound_simd::isa_name());
+}
+BENCHMARK(BM_sound_mix)->Arg(64)->Arg(960);
+
+static void BM_sound_mix_pan(benchmark::State& state) {
+	sound_buffers buf(state.range(0));
+	while (state.KeepRunning()) {
+		emu::sound_simd::mix_pan(&buf.dest[0], &buf.right[0], &buf.src[0], 0.3f, 0.7f, state.range(0));
+		benchmark::DoNotOptimize(buf.dest[0]);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+	state.SetLabel(emu::sound_simd::isa_name());
+}
+BENCHMARK(BM_sound_mix_pan)->Arg(64)->Arg(960);
+
+static void BM_sound_sum_scalar(benchmark::State& state) {
+	sound_buffers buf(state.range(0));
+	while (state.KeepRunning()) {
+		float result = 0.0f;
+		for (int index = 0; index < state.range(0); index++)
+			result += buf.src[index];
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_sound_sum_scalar)->Arg(64)->Arg(960);
+
+static void BM_sound_sum(benchmark::State& state) {
+	sound_buffers buf(state.range(0));
+	while (state.KeepRunning()) {
+		float result = emu::sound_simd::sum(&buf.src[0], state.range(0));
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+	state.SetLabel(emu::sound_simd::isa_name());
+}
+BENCHMARK(BM_sound_sum)->Arg(64)->Arg(960);
@@ -64,6 +64,9 @@ function cheatfind.startplugin()
 					return nil
 				end
 			end
+		elseif data.shift == 0 and getmetatable(space).__name:match("addr_space") then
+			-- byte wide space, read it all in one go
+			data.block = space:read_block(start, size + 1)
 		else
 			local block = ""
 			local temp = {}
@@ -173,18 +176,46 @@ function cheatfind.startplugin()
 			val = 0
 		end
 
+		local function getaddr(i)
+			local addr = i - 1
+			if olddata.shift ~= 0 then
+				local s = olddata.shift
+				addr = (s < 0) and addr >> -s or (s > 0) and addr << s
+			end
+			return addr + olddata.start
+		end
+
+		-- plain comparisons are done natively, bitwise and bcd ones need the lua path
+		local nativeop = { lt = "lt", gt = "gt", eq = "eq", ne = "ne", ltv = "ltv", gtv = "gtv", eqv = "eqv", nev = "nev" }
+		local width = tonumber(format:sub(3, 3))
+		if not bcd and nativeop[oper] and type(val) == "number" and (val == 0 or oper ~= "ne") and width then
+			local cond, cval = nativeop[oper], val
+			if oper == "lt" and val > 0 then
+				cond, cval = "delta", -val
+			elseif oper == "gt" and val > 0 then
+				cond = "delta"
+			end
+			local length = math.min(#olddata.block, #newdata.block, olddata.size + width - 1)
+			local search = emu.memory_search(math.max(length, 0), width,
+				(format:sub(1, 1) == ">") and "big" or "little", format:sub(2, 2) == "i", step)
+			search:filter(cond, newdata.block, olddata.block, cval)
+			for num, offs in ipairs(search:matches()) do
+				local addr = getaddr(offs + 1)
+				ret[#ret + 1] = { addr = addr,
+				oldval = string.unpack(format, olddata.block, offs + 1),
+				newval = string.unpack(format, newdata.block, offs + 1) }
+				ref[addr] = #ret
+			end
+			return ret, ref
+		end
+
 		for i = 1, olddata.size, step do
 			local oldstat, old = pcall(string.unpack, format, olddata.block, i)
 			local newstat, new = pcall(string.unpack, format, newdata.block, i)
 			if oldstat and newstat then
 				local oldc, newc = old, new
 				local comp = false
-				local addr = i - 1
-				if olddata.shift ~= 0 then
-					local s = olddata.shift
-					addr = (s < 0) and addr >> -s or (s > 0) and addr << s
-				end
-				addr = addr + olddata.start
+				local addr = getaddr(i)
 				if not bcd or (check_bcd(old) and check_bcd(new)) then
 					if bcd then
 						oldc = frombcd(old)
@@ -50,6 +50,31 @@ def sha1sum(path):
 		f.close()
 	return sha1.hexdigest()
 
+def infoSha1(path):
+	exitcode, stdout, stderr = runProcess([chdmanBin, "info", "-i", path])
+	if not exitcode == 0:
+		return None
+	for line in stdout.splitlines():
+		if line.startswith("SHA1:"):
+			return line.split(":", 1)[1].strip()
+	return None
+
+def copyAndCompare():
+	global failure
+	copyFile = os.path.join(tempFilePath, "copy.chd")
+	exitcode, stdout, stderr = runProcess([chdmanBin, "copy", "-f", "-i", tempFile, "-o", copyFile])
+	if not exitcode == 0:
+		print(d + " - copy failed with " + str(exitcode) + " (" + stderr + ")")
+		failure = True
+		return
+
+	sha1_before = infoSha1(tempFile)
+	sha1_after = infoSha1(copyFile)
+	if sha1_before is None or not sha1_before == sha1_after:
+		print("expected: " + str(sha1_before) + " found: " + str(sha1_after))
+		print(d + " - SHA1 mismatch (copy)")
+		failure = True
+
 def extractcdAndCompare(type):
 	global failure
 	extractFileDir = os.path.join(tempFilePath, type + "_output")
@@ -201,6 +226,13 @@ for root, dirs, files in os.walk(inputPath):
 			print(d + " - verify failed with " + str(exitcode) + " (" + stderr + ")")
 			failure = True
 			
+		# a plain copy must not change the SHA1 that hash files check against
+		copyAndCompare()
+
+		# round-trip only cases have no reference output
+		if not os.path.exists(outFile):
+			continue
+
 		# compare info
 		# TODO: store expected output of reference file as well and compare
 		exitcode, info1, stderr = runProcess([chdmanBin, "info", "-v", "-i", tempFile])
@@ -216,6 +216,10 @@ project "zstd"
 		MAME_DIR .. "3rdparty/zstd/lib/decompress/zstd_ddict.c",
 		MAME_DIR .. "3rdparty/zstd/lib/decompress/zstd_decompress_block.c",
 		MAME_DIR .. "3rdparty/zstd/lib/decompress/zstd_decompress.c",
+		MAME_DIR .. "3rdparty/zstd/lib/dictBuilder/cover.c",
+		MAME_DIR .. "3rdparty/zstd/lib/dictBuilder/divsufsort.c",
+		MAME_DIR .. "3rdparty/zstd/lib/dictBuilder/fastcover.c",
+		MAME_DIR .. "3rdparty/zstd/lib/dictBuilder/zdict.c",
 	}
 else
 links {
@@ -59,16 +59,29 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"utils",
+		ext_lib("expat"),
+		"7z",
+		"ocore_" .. _OPTIONS["osd"],
+		ext_lib("zlib"),
+		ext_lib("zstd"),
+		ext_lib("flac"),
+		ext_lib("utf8proc"),
 	}
 
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/lib/util",
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
+		MAME_DIR .. "benchmarks/chd_read.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/sound_simd.cpp",
+		MAME_DIR .. "src/emu/soundsimd.cpp",
 	}
 
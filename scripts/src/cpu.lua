@@ -2054,6 +2054,8 @@ if CPUS["M680X0"] then
 		MAME_DIR .. "src/devices/cpu/m68000/m68kops.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kfpu.cpp",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kmmu.h",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kcov.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kcov.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kmusashi.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kcommon.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kcommon.cpp",
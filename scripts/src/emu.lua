@@ -162,10 +162,15 @@ files {
 	MAME_DIR .. "src/emu/input.h",
 	MAME_DIR .. "src/emu/inputdev.cpp",
 	MAME_DIR .. "src/emu/inputdev.h",
+	MAME_DIR .. "src/emu/iopoll.cpp",
+	MAME_DIR .. "src/emu/iopoll.h",
 	MAME_DIR .. "src/emu/ioport.cpp",
 	MAME_DIR .. "src/emu/ioport.h",
 	MAME_DIR .. "src/emu/inpttype.ipp",
 	MAME_DIR .. "src/emu/inpttype.h",
+	MAME_DIR .. "src/emu/journal.cpp",
+	MAME_DIR .. "src/emu/journal.h",
+	MAME_DIR .. "src/emu/journalfmt.h",
 	MAME_DIR .. "src/emu/logmacro.h",
 	MAME_DIR .. "src/emu/machine.cpp",
 	MAME_DIR .. "src/emu/machine.h",
@@ -210,6 +215,8 @@ files {
 	MAME_DIR .. "src/emu/softlist_dev.h",
 	MAME_DIR .. "src/emu/sound.cpp",
 	MAME_DIR .. "src/emu/sound.h",
+	MAME_DIR .. "src/emu/soundsimd.cpp",
+	MAME_DIR .. "src/emu/soundsimd.h",
 	MAME_DIR .. "src/emu/speaker.cpp",
 	MAME_DIR .. "src/emu/speaker.h",
 	MAME_DIR .. "src/emu/tilemap.cpp",
@@ -253,8 +260,12 @@ files {
 	MAME_DIR .. "src/emu/debug/dvtext.h",
 	MAME_DIR .. "src/emu/debug/express.cpp",
 	MAME_DIR .. "src/emu/debug/express.h",
+	MAME_DIR .. "src/emu/debug/memsearch.cpp",
+	MAME_DIR .. "src/emu/debug/memsearch.h",
 	MAME_DIR .. "src/emu/debug/points.cpp",
 	MAME_DIR .. "src/emu/debug/points.h",
+	MAME_DIR .. "src/emu/debug/reverse.cpp",
+	MAME_DIR .. "src/emu/debug/reverse.h",
 	MAME_DIR .. "src/emu/debug/textbuf.cpp",
 	MAME_DIR .. "src/emu/debug/textbuf.h",
 	MAME_DIR .. "src/emu/drivers/empty.cpp",
@@ -273,9 +284,11 @@ files {
 }
 
 pchsource(MAME_DIR .. "src/emu/main.cpp")
--- 2 files do not include emu.h
+-- 4 files do not include emu.h
 nopch(MAME_DIR .. "src/emu/attotime.cpp")
+nopch(MAME_DIR .. "src/emu/debug/memsearch.cpp")
 nopch(MAME_DIR .. "src/emu/debug/textbuf.cpp")
+nopch(MAME_DIR .. "src/emu/soundsimd.cpp")
 
 dependency {
 	--------------------------------------------------
@@ -55,6 +55,15 @@ project("mametests")
 	}
 
 	files {
+		MAME_DIR .. "src/emu/attotime.cpp",
+		MAME_DIR .. "src/emu/attotime.h",
+		MAME_DIR .. "src/emu/emucore.cpp",
+		MAME_DIR .. "src/emu/emucore.h",
+		MAME_DIR .. "src/emu/debug/express.cpp",
+		MAME_DIR .. "src/emu/debug/express.h",
+		MAME_DIR .. "src/emu/debug/memsearch.cpp",
+		MAME_DIR .. "src/emu/debug/memsearch.h",
+		MAME_DIR .. "src/emu/journalfmt.h",
 		MAME_DIR .. "src/emu/video/rgbsse.cpp",
 		MAME_DIR .. "src/emu/video/rgbsse.h",
 		MAME_DIR .. "src/emu/video/rgbvmx.cpp",
@@ -66,6 +75,9 @@ project("mametests")
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
 		MAME_DIR .. "tests/lib/util/options.cpp",
 		MAME_DIR .. "tests/emu/attotime.cpp",
+		MAME_DIR .. "tests/emu/debug/express.cpp",
+		MAME_DIR .. "tests/emu/debug/memsearch.cpp",
+		MAME_DIR .. "tests/emu/journal.cpp",
 		MAME_DIR .. "tests/emu/video/rgbutil.cpp",
 	}
 
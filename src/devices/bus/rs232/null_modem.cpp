@@ -14,6 +14,7 @@ null_modem_device::null_modem_device(const machine_config &mconfig, const char *
 	m_rs232_parity(*this, "RS232_PARITY"),
 	m_rs232_stopbits(*this, "RS232_STOPBITS"),
 	m_flow(*this, "FLOW_CONTROL"),
+	m_speed(*this, "TX_SPEED"),
 	m_input_count(0),
 	m_input_index(0),
 	m_timer_poll(nullptr),
@@ -41,6 +42,11 @@ static INPUT_PORTS_START(null_modem)
 	PORT_CONFSETTING(   0x01, "RTS")
 	PORT_CONFSETTING(   0x02, "DTR")
 	PORT_CONFSETTING(   0x04, "XON/XOFF")
+
+	PORT_START("TX_SPEED")
+	PORT_CONFNAME(0x01, 0x00, "TX Speed")
+	PORT_CONFSETTING(   0x00, "Baud Rate")
+	PORT_CONFSETTING(   0x01, "Unthrottled")
 INPUT_PORTS_END
 
 ioport_constructor null_modem_device::device_input_ports() const
@@ -88,17 +94,42 @@ TIMER_CALLBACK_MEMBER(null_modem_device::update_queue)
 {
 	if (is_transmit_register_empty())
 	{
-		if (m_input_index == m_input_count)
+		bool const unthrottled = m_speed->read();
+		while (true)
 		{
-			m_input_index = 0;
-			m_input_count = m_stream->input(m_input_buffer, sizeof(m_input_buffer));
-		}
+			if (m_input_index == m_input_count)
+			{
+				m_input_index = 0;
+				m_input_count = m_stream->input(m_input_buffer, sizeof(m_input_buffer));
+			}
+
+			if (m_input_count == 0)
+			{
+				// sleep until the host has more data if it can tell us, otherwise poll
+				if (m_stream->notify_input(delegate<void ()>(&null_modem_device::input_ready, this)))
+				{
+					m_timer_poll->adjust(attotime::never);
+					return;
+				}
+				break;
+			}
 
-		if (m_input_count != 0)
-		{
 			uint8_t const fc = m_flow->read();
+			if (!(fc == 0 || (fc == 1 && m_rts == 0) || (fc == 2 && m_dtr == 0) || (fc == 4 && m_xoff == 0)))
+				break;
 
-			if (fc == 0 || (fc == 1 && m_rts == 0) || (fc == 2 && m_dtr == 0) || (fc == 4 && m_xoff == 0))
+			if (unthrottled && transmit_character_unthrottled(m_input_buffer[m_input_index]))
+			{
+				// keep going until the receiving UART is full
+				m_input_index++;
+			}
+			else if (unthrottled && character_peer_compatible())
+			{
+				// wait for the receiving UART to make room, which calls tra_peer_ready
+				m_timer_poll->adjust(attotime::from_hz(convert_baud(m_rs232_txbaud->read())));
+				return;
+			}
+			else
 			{
 				transmit_register_setup(m_input_buffer[m_input_index++]);
 				m_timer_poll->adjust(attotime::never);
@@ -107,10 +138,20 @@ TIMER_CALLBACK_MEMBER(null_modem_device::update_queue)
 		}
 
 		int const txbaud = convert_baud(m_rs232_txbaud->read());
-		m_timer_poll->adjust(attotime::from_hz(txbaud));
+		m_timer_poll->adjust(unthrottled ? attotime::from_msec(1) : attotime::from_hz(txbaud));
 	}
 }
 
+void null_modem_device::tra_peer_ready()
+{
+	m_timer_poll->adjust(attotime::zero);
+}
+
+void null_modem_device::input_ready()
+{
+	update_queue(0);
+}
+
 void null_modem_device::tra_callback()
 {
 	output_rxd(transmit_register_get_data_bit());
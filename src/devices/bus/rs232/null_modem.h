@@ -31,9 +31,12 @@ protected:
 	virtual void tra_callback() override;
 	virtual void tra_complete() override;
 	virtual void rcv_complete() override;
+	virtual bool character_mode_ok() const override { return true; }
+	virtual void tra_peer_ready() override;
 
 private:
 	TIMER_CALLBACK_MEMBER(update_queue);
+	void input_ready();
 
 	required_device<bitbanger_device> m_stream;
 
@@ -43,6 +46,7 @@ private:
 	required_ioport m_rs232_parity;
 	required_ioport m_rs232_stopbits;
 	required_ioport m_flow;
+	required_ioport m_speed;
 
 	uint8_t m_input_buffer[1000];
 	uint32_t m_input_count;
@@ -18,6 +18,7 @@ pseudo_terminal_device::pseudo_terminal_device(const machine_config &mconfig, co
 	m_rs232_parity(*this, "RS232_PARITY"),
 	m_rs232_stopbits(*this, "RS232_STOPBITS"),
 	m_flow(*this, "FLOW_CONTROL"),
+	m_speed(*this, "TX_SPEED"),
 	m_input_count(0),
 	m_input_index(0),
 	m_timer_poll(nullptr),
@@ -65,6 +66,11 @@ static INPUT_PORTS_START(pseudo_terminal)
 	PORT_CONFSETTING(   0x01, "RTS")
 	PORT_CONFSETTING(   0x02, "DTR")
 	PORT_CONFSETTING(   0x04, "XON/XOFF")
+
+	PORT_START("TX_SPEED")
+	PORT_CONFNAME(0x01, 0x00, "TX Speed")
+	PORT_CONFSETTING(   0x00, "Baud Rate")
+	PORT_CONFSETTING(   0x01, "Unthrottled")
 INPUT_PORTS_END
 
 ioport_constructor pseudo_terminal_device::device_input_ports() const
@@ -132,21 +138,46 @@ TIMER_CALLBACK_MEMBER(pseudo_terminal_device::update_queue)
 {
 	if (is_transmit_register_empty())
 	{
-		if (m_input_index == m_input_count)
+		bool const unthrottled = m_speed->read();
+		while (true)
 		{
-			m_input_index = 0;
-			int const tmp = read(m_input_buffer, sizeof(m_input_buffer));
-			if (tmp > 0)
-				m_input_count = tmp;
-			else
-				m_input_count = 0;
-		}
+			if (m_input_index == m_input_count)
+			{
+				m_input_index = 0;
+				int const tmp = read(m_input_buffer, sizeof(m_input_buffer));
+				if (tmp > 0)
+					m_input_count = tmp;
+				else
+					m_input_count = 0;
+			}
+
+			if (m_input_count == 0)
+			{
+				// sleep until the host has more data if it can tell us, otherwise poll
+				if (notify_readable(delegate<void ()>(&pseudo_terminal_device::input_ready, this)))
+				{
+					m_timer_poll->adjust(attotime::never);
+					return;
+				}
+				break;
+			}
 
-		if (m_input_count != 0)
-		{
 			uint8_t const fc = m_flow->read();
+			if (!(fc == 0 || (fc == 1 && m_rts == 0) || (fc == 2 && m_dtr == 0) || (fc == 4 && m_xoff == 0)))
+				break;
 
-			if (fc == 0 || (fc == 1 && m_rts == 0) || (fc == 2 && m_dtr == 0) || (fc == 4 && m_xoff == 0))
+			if (unthrottled && transmit_character_unthrottled(m_input_buffer[m_input_index]))
+			{
+				// keep going until the receiving UART is full
+				m_input_index++;
+			}
+			else if (unthrottled && character_peer_compatible())
+			{
+				// wait for the receiving UART to make room, which calls tra_peer_ready
+				m_timer_poll->adjust(attotime::from_hz(convert_baud(m_rs232_txbaud->read())));
+				return;
+			}
+			else
 			{
 				transmit_register_setup(m_input_buffer[m_input_index++]);
 				m_timer_poll->adjust(attotime::never);
@@ -155,8 +186,18 @@ TIMER_CALLBACK_MEMBER(pseudo_terminal_device::update_queue)
 		}
 
 		int const txbaud = convert_baud(m_rs232_txbaud->read());
-		m_timer_poll->adjust(attotime::from_hz(txbaud));
+		m_timer_poll->adjust(unthrottled ? attotime::from_msec(1) : attotime::from_hz(txbaud));
 	}
 }
 
+void pseudo_terminal_device::tra_peer_ready()
+{
+	m_timer_poll->adjust(attotime::zero);
+}
+
+void pseudo_terminal_device::input_ready()
+{
+	update_queue(0);
+}
+
 DEFINE_DEVICE_TYPE(PSEUDO_TERMINAL, pseudo_terminal_device, "pseudo_terminal", "Pseudo Terminal")
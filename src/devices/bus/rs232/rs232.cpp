@@ -68,6 +68,7 @@ rs232_port_device::rs232_port_device(const machine_config &mconfig, device_type
 	m_cts_handler(*this),
 	m_rxc_handler(*this),
 	m_txc_handler(*this),
+	m_dte_serial(*this, finder_base::DUMMY_TAG),
 	m_dev(nullptr)
 {
 }
@@ -89,6 +90,14 @@ void rs232_port_device::device_resolve_objects()
 	m_ri = 1;
 	m_si = 1;
 	m_cts = 1;
+
+	// link the two ends so frames can skip the bit-level path when both sides support it
+	device_serial_interface *const card = dynamic_cast<device_serial_interface *>(m_dev);
+	if (m_dte_serial && card)
+	{
+		m_dte_serial->set_character_peer(card);
+		card->set_character_peer(m_dte_serial.target());
+	}
 }
 
 void rs232_port_device::device_reset()
@@ -130,6 +130,9 @@ public:
 	auto rxc_handler() { return m_rxc_handler.bind(); }
 	auto txc_handler() { return m_txc_handler.bind(); }
 
+	// serial device driving this port, for exchanging whole characters with the connected device
+	template <typename T> void set_dte_serial(T &&tag) { m_dte_serial.set_tag(std::forward<T>(tag)); }
+
 	void write_txd(int state);        // DB25 pin  2  V.24 circuit 103   Transmitted data
 	void write_dtr(int state);        // DB25 pin 20  V.24 circuit 108/2 Data terminal ready
 	void write_rts(int state);        // DB25 pin  4  V.24 circuit 105   Request to send
@@ -171,6 +174,8 @@ protected:
 	devcb_write_line m_rxc_handler;
 	devcb_write_line m_txc_handler;
 
+	optional_device<device_serial_interface> m_dte_serial;
+
 private:
 	device_rs232_port_interface *m_dev;
 };
@@ -1394,6 +1394,11 @@ u32 arm7_disassembler::opcode_alignment() const
 	return m_config->get_t_flag() ? 2 : 4;
 }
 
+u32 arm7_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t arm7_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	if(m_config->get_t_flag())
@@ -63,6 +63,11 @@ u32 cosmac_disassembler::opcode_alignment() const
 	return 1;
 }
 
+u32 cosmac_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 cosmac_disassembler::cosmac_disassembler(int variant, cosmac_disassembler::config *conf) : m_variant(variant), m_config(conf)
 {
 }
@@ -35,6 +35,7 @@ public:
 	virtual ~cosmac_disassembler() = default;
 
 	virtual u32 opcode_alignment() const override;
+	virtual u32 interface_flags() const override;
 	virtual offs_t disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params) override;
 
 private:
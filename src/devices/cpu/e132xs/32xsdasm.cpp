@@ -391,6 +391,11 @@ u32 hyperstone_disassembler::opcode_alignment() const
 	return 2;
 }
 
+u32 hyperstone_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 hyperstone_disassembler::hyperstone_disassembler(config *conf) : m_config(conf)
 {
 }
@@ -52,7 +52,7 @@ u32 g65816_disassembler::opcode_alignment() const
 
 u32 g65816_disassembler::interface_flags() const
 {
-	return PAGED;
+	return PAGED | STATE_DEPENDENT;
 }
 
 u32 g65816_disassembler::page_address_bits() const
@@ -2961,3 +2961,8 @@ u32 i386_disassembler::opcode_alignment() const
 {
 	return 1;
 }
+
+u32 i386_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
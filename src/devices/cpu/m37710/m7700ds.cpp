@@ -308,6 +308,11 @@ u32 m7700_disassembler::opcode_alignment() const
 	return 1;
 }
 
+u32 m7700_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t m7700_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	unsigned int instruction;
@@ -16,6 +16,11 @@ m740_disassembler::m740_disassembler(config *_conf) : m6502_base_disassembler(di
 {
 }
 
+u32 m740_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 u32 m740_disassembler::get_instruction_bank() const
 {
 	return conf->get_state_base();
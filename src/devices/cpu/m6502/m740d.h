@@ -26,6 +26,8 @@ public:
 	m740_disassembler(config *conf);
 	virtual ~m740_disassembler() = default;
 
+	virtual u32 interface_flags() const override;
+
 protected:
 	virtual u32 get_instruction_bank() const override;
 
@@ -0,0 +1,185 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    m68kcov.cpp
+
+    Instruction coverage collector for the Musashi 68k cores.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "m68kcov.h"
+
+#include "ioprocs.h"
+#include "multibyte.h"
+
+#include <algorithm>
+
+
+m68k_coverage::m68k_coverage()
+	: m_table(1 << 12)
+	, m_used(0)
+	, m_shift(32 - 12)
+	, m_last(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  lookup - find or claim the slot for an
+//  address
+//-------------------------------------------------
+
+m68k_coverage::entry &m68k_coverage::lookup(u32 pc)
+{
+	u32 const mask = m_table.size() - 1;
+	for (u32 index = (pc * 0x9e3779b1U) >> m_shift; ; index = (index + 1) & mask)
+	{
+		entry &slot = m_table[index];
+		if (slot.count == 0)
+		{
+			// keep the load factor at or below one half
+			if ((m_used + 1) * 2 > m_table.size())
+			{
+				grow();
+				return lookup(pc);
+			}
+			slot.pc = pc;
+			m_used++;
+			return slot;
+		}
+		if (slot.pc == pc)
+			return slot;
+	}
+}
+
+
+//-------------------------------------------------
+//  grow - double the table size and rehash
+//-------------------------------------------------
+
+void m68k_coverage::grow()
+{
+	std::vector<entry> old(m_table.size() * 2);
+	old.swap(m_table);
+	m_shift--;
+	m_used = 0;
+	m_last = nullptr;
+	for (const entry &slot : old)
+	{
+		if (slot.count != 0)
+			lookup(slot.pc).count = slot.count;
+	}
+}
+
+
+//-------------------------------------------------
+//  sorted - return the used slots in address
+//  order
+//-------------------------------------------------
+
+std::vector<m68k_coverage::entry> m68k_coverage::sorted() const
+{
+	std::vector<entry> result;
+	result.reserve(m_used);
+	for (const entry &slot : m_table)
+	{
+		if (slot.count != 0)
+			result.push_back(slot);
+	}
+	std::sort(result.begin(), result.end(), [] (const entry &a, const entry &b) { return a.pc < b.pc; });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  parse_format - map an option value to an
+//  output format
+//-------------------------------------------------
+
+bool m68k_coverage::parse_format(std::string_view name, format &result)
+{
+	if (name == "drcov")
+		result = FORMAT_DRCOV;
+	else if (name == "lcov")
+		result = FORMAT_LCOV;
+	else
+		return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  write - write the collected counts
+//-------------------------------------------------
+
+std::error_condition m68k_coverage::write(util::core_file &file, format fmt, std::string_view module, const length_func &length) const
+{
+	return (fmt == FORMAT_LCOV) ? write_lcov(file, module) : write_drcov(file, module, length);
+}
+
+
+//-------------------------------------------------
+//  write_drcov - write a drcov version 2 file;
+//  consecutive instructions executed the same
+//  number of times are merged into one block
+//-------------------------------------------------
+
+std::error_condition m68k_coverage::write_drcov(util::core_file &file, std::string_view module, const length_func &length) const
+{
+	struct block
+	{
+		u32 start;
+		u32 end;
+		u64 count;
+	};
+	std::vector<block> blocks;
+	for (const entry &slot : sorted())
+	{
+		u32 const size = std::max<u32>(length(slot.pc), 2);
+		if (!blocks.empty() && blocks.back().end == slot.pc && blocks.back().count == slot.count && (slot.pc + size - blocks.back().start) <= 0xffff)
+			blocks.back().end = slot.pc + size;
+		else
+			blocks.push_back(block{ slot.pc, slot.pc + size, slot.count });
+	}
+
+	// the whole physical address space is a single module
+	file.puts("DRCOV VERSION: 2\n");
+	file.puts("DRCOV FLAVOR: drcov\n");
+	file.puts("Module Table: version 2, count 1\n");
+	file.puts("Columns: id, base, end, entry, checksum, timestamp, path\n");
+	file.printf(" 0, 0x0000000000000000, 0x00000000ffffffff, 0x0000000000000000, 0x00000000, 0x00000000, %s\n", module);
+	file.printf("BB Table: %u bbs\n", blocks.size());
+
+	std::vector<u8> table(blocks.size() * 8);
+	u8 *dest = table.data();
+	for (const block &bb : blocks)
+	{
+		put_u32le(dest + 0, bb.start);
+		put_u16le(dest + 4, bb.end - bb.start);
+		put_u16le(dest + 6, 0);
+		dest += 8;
+	}
+	return util::write(file, table.data(), table.size()).first;
+}
+
+
+//-------------------------------------------------
+//  write_lcov - write per-address execution
+//  counts as an lcov tracefile, using addresses
+//  in place of line numbers
+//-------------------------------------------------
+
+std::error_condition m68k_coverage::write_lcov(util::core_file &file, std::string_view module) const
+{
+	std::vector<entry> const entries = sorted();
+	file.puts("TN:\n");
+	file.printf("SF:%s\n", module);
+	for (const entry &slot : entries)
+		file.printf("DA:%u,%u\n", slot.pc, slot.count);
+	file.printf("LH:%u\n", entries.size());
+	file.printf("LF:%u\n", entries.size());
+	file.puts("end_of_record\n");
+	return std::error_condition();
+}
@@ -0,0 +1,75 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    m68kcov.h
+
+    Instruction coverage collector for the Musashi 68k cores.
+
+    Execution counts are kept per physical instruction address in an
+    open-addressed hash table, and written at exit either as a drcov
+    basic block table (for coverage-guided fuzzers and disassembler
+    plugins) or as lcov-style per-address counts.
+
+***************************************************************************/
+
+#ifndef MAME_CPU_M68000_M68KCOV_H
+#define MAME_CPU_M68000_M68KCOV_H
+
+#pragma once
+
+#include "corefile.h"
+
+#include <functional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+
+class m68k_coverage
+{
+public:
+	enum format
+	{
+		FORMAT_DRCOV,
+		FORMAT_LCOV
+	};
+
+	// returns the length in bytes of the instruction at a physical address
+	typedef std::function<u32 (u32 pc)> length_func;
+
+	m68k_coverage();
+
+	// count one execution of the instruction at a physical address
+	void hit(u32 pc)
+	{
+		// tight loops hit the same instruction back to back
+		if (!m_last || m_last->pc != pc)
+			m_last = &lookup(pc);
+		m_last->count++;
+	}
+
+	// output
+	static bool parse_format(std::string_view name, format &result);
+	std::error_condition write(util::core_file &file, format fmt, std::string_view module, const length_func &length) const;
+
+private:
+	struct entry
+	{
+		u32 pc;
+		u64 count;      // zero for an unused slot
+	};
+
+	entry &lookup(u32 pc);
+	void grow();
+	std::vector<entry> sorted() const;
+	std::error_condition write_drcov(util::core_file &file, std::string_view module, const length_func &length) const;
+	std::error_condition write_lcov(util::core_file &file, std::string_view module) const;
+
+	std::vector<entry>  m_table;        // power-of-two sized hash table
+	u32                 m_used;         // slots in use
+	u32                 m_shift;        // 32 - log2(table size)
+	entry *             m_last;         // most recently hit slot
+};
+
+#endif // MAME_CPU_M68000_M68KCOV_H
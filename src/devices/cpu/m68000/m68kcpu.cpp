@@ -28,6 +28,11 @@ static const char copyright_notice[] =
 #include "m68kmusashi.h"
 #include "m68kdasm.h"
 
+#include "emuopts.h"
+
+#include <algorithm>
+#include <sstream>
+
 // Generated data
 
 u16 m68000_musashi_device::m68ki_instruction_state_table[NUM_CPU_TYPES][0x10000]; /* opcode handler jump table */
@@ -747,6 +752,7 @@ void m68000_musashi_device::device_post_load()
 	//fprintf(stderr, "Reloaded, pc=%x\n", REG_PC(m68k));
 	m_stopped = (m_save_stopped ? STOP_LEVEL_STOP : 0) | (m_save_halted  ? STOP_LEVEL_HALT : 0);
 	m68ki_jump(m_pc);
+	coverage_flush();
 }
 
 void m68000_musashi_device::m68k_cause_bus_error()
@@ -899,6 +905,9 @@ void m68000_musashi_device::execute_run()
 			/* Call external hook to peek at CPU */
 			debugger_instruction_hook(m_pc);
 
+			if (m_coverage)
+				coverage_hit();
+
 			try
 			{
 			if (!m_instruction_restart)
@@ -1104,6 +1113,98 @@ void m68000_musashi_device::init_cpu_common(void)
 	set_icountptr(m_icount);
 	m_icount = 0;
 
+	/* Count executed instructions if asked to */
+	m_coverage.reset();
+	m_coverage_vkey = ~0U;
+	const char *const coverage = machine().options().coverage();
+	if (coverage && *coverage)
+	{
+		if (m68k_coverage::parse_format(machine().options().coverage_format(), m_coverage_format))
+			m_coverage = std::make_unique<m68k_coverage>();
+		else
+			osd_printf_error("%s: unknown coverage format '%s'\n", tag(), machine().options().coverage_format());
+	}
+}
+
+
+//-------------------------------------------------
+//  coverage_hit - count the instruction at the
+//  current PC by physical address
+//-------------------------------------------------
+
+void m68000_musashi_device::coverage_hit()
+{
+	u32 pc = m_pc;
+
+	// translations are cached per 256-byte block, the smallest page
+	// size, until coverage_flush is called
+	if (m_pmmu_enabled || CPU_TYPE_IS_040_PLUS())
+	{
+		u32 const key = (pc & ~0xffU) | (m_s_flag ? 1 : 0);
+		if (key != m_coverage_vkey)
+		{
+			offs_t physical = pc & ~0xffU;
+			address_space *space;
+			memory_translate(AS_PROGRAM, TR_FETCH, physical, space);
+			m_coverage_vkey = key;
+			m_coverage_pblock = physical & ~0xffU;
+		}
+		pc = m_coverage_pblock | (pc & 0xff);
+	}
+
+	m_coverage->hit(pc);
+}
+
+
+//-------------------------------------------------
+//  coverage_write - write the collected counts
+//-------------------------------------------------
+
+void m68000_musashi_device::coverage_write()
+{
+	// tag the file name if there's more than one CPU to tell apart
+	int count = 0;
+	for (device_t &device : device_enumerator(machine().root_device()))
+		if (dynamic_cast<m68000_musashi_device *>(&device))
+			count++;
+	std::string filename = machine().options().coverage();
+	if (count > 1)
+	{
+		std::string suffix = tag();
+		std::replace(suffix.begin(), suffix.end(), ':', '_');
+		filename += suffix;
+	}
+
+	util::core_file::ptr file;
+	std::error_condition err = util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file);
+	if (!err)
+	{
+		// drcov blocks need instruction lengths, taken from the disassembler
+		class physical_buffer : public util::disasm_interface::data_buffer
+		{
+		public:
+			physical_buffer(address_space &space) : m_space(space) { }
+			virtual u8  r8 (offs_t pc) const override { return m_space.read_byte(pc); }
+			virtual u16 r16(offs_t pc) const override { return m_space.read_word(pc); }
+			virtual u32 r32(offs_t pc) const override { return m_space.read_dword(pc); }
+			virtual u64 r64(offs_t pc) const override { return m_space.read_qword(pc); }
+		private:
+			address_space &m_space;
+		};
+
+		auto dis = machine().disable_side_effects();
+		physical_buffer opcodes(space(AS_PROGRAM));
+		std::unique_ptr<util::disasm_interface> disasm = create_disassembler();
+		std::ostringstream stream;
+		err = m_coverage->write(*file, m_coverage_format, tag(),
+				[&] (u32 pc) -> u32
+				{
+					stream.str("");
+					return disasm->disassemble(stream, pc, opcodes, opcodes) & util::disasm_interface::LENGTHMASK;
+				});
+	}
+	if (err)
+		osd_printf_error("%s: error writing coverage file %s (%s)\n", tag(), filename, err.message());
 }
 
 void m68000_musashi_device::device_reset()
@@ -2419,6 +2520,8 @@ void m68000_musashi_device::device_start()
 
 void m68000_musashi_device::device_stop()
 {
+	if (m_coverage)
+		coverage_write();
 }
 
 
@@ -186,6 +186,13 @@ void pmmu_atc_add(u32 logical, u32 physical, int fc, const int rw)
 }
 
 
+// coverage_flush: coverage_hit caches a translation too, so drop it
+// whenever translation may change, whether or not the ATC is flushed
+void coverage_flush()
+{
+	m_coverage_vkey = ~0U;
+}
+
 // pmmu_atc_flush: flush entire ATC
 // 7fff0003 001ffd10 80f05750 is what should load
 void pmmu_atc_flush()
@@ -193,10 +200,13 @@ void pmmu_atc_flush()
 	MMULOG("ATC flush: pc=%08x\n", m_ppc);
 	std::fill(std::begin(m_mmu_atc_tag), std::end(m_mmu_atc_tag), 0);
 	m_mmu_atc_rr = 0;
+	coverage_flush();
 }
 
 void pmmu_atc_flush_fc_ea(const u16 modes)
 {
+	coverage_flush();
+
 	const int fcmask = (modes >> 5) & 7;
 	const int fc = fc_from_modes(modes) & fcmask;
 	const int ps = (m_mmu_tc >> 20) & 0xf;
@@ -1027,6 +1037,7 @@ void m68851_pmove_get(u32 ea, u16 modes)
 void m68851_pmove_put(u32 ea, u16 modes)
 {
 	u64 temp64;
+	coverage_flush(); // even when the FD bit stops the ATC being flushed
 	switch ((modes>>13) & 7)
 	{
 	case 0:
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "m68kcommon.h"
+#include "m68kcov.h"
 
 #include "softfloat3/source/include/softfloat.h"
 #include "softfloat3/bochs_ext/softfloat3_ext.h"
@@ -275,6 +276,15 @@ protected:
 	/* 68307 / 68340 internal address map */
 	address_space *m_internal;
 
+	/* instruction coverage (-coverage option) */
+	std::unique_ptr<m68k_coverage> m_coverage;
+	m68k_coverage::format m_coverage_format;
+	u32 m_coverage_vkey;     /* logical 256-byte block and supervisor flag of the cached translation */
+	u32 m_coverage_pblock;   /* physical 256-byte block it translates to */
+
+	void coverage_hit();
+	void coverage_write();
+
 
 
 	void init_cpu_common(void);
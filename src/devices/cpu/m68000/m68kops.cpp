@@ -20217,27 +20217,34 @@ void m68000_musashi_device::x4e7b_movec_l_4()
 				m_pmmu_enabled = 0;
 			}
 			m_instruction_restart = m_pmmu_enabled || m_emmu_enabled;
+			coverage_flush();
 			break;
 		case 0x004:         /* ITT0 */
 			m_mmu_itt0 = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		case 0x005:         /* ITT1 */
 			m_mmu_itt1 = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		case 0x006:         /* DTT0 */
 			m_mmu_dtt0 = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		case 0x007:         /* DTT1 */
 			m_mmu_dtt1 = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		case 0x805:         /* MMUSR */
 			m_mmu_sr_040 = REG_DA()[(word2 >> 12) & 15];
 			break;
 		case 0x806:         /* URP */
 			m_mmu_urp_aptr = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		case 0x807:         /* SRP */
 			m_mmu_srp_aptr = REG_DA()[(word2 >> 12) & 15];
+			coverage_flush();
 			break;
 		default:
 			m68ki_exception_illegal();
@@ -25403,6 +25410,7 @@ void m68000_musashi_device::xf518_pflusha_l_4fc()
 {
 	if(m_has_pmmu) {
 		logerror("68040: unhandled PFLUSHA (ir=%04x)\n", m_ir);
+		coverage_flush();
 	} else {
 		m68ki_exception_1111();
 	}
@@ -25413,6 +25421,7 @@ void m68000_musashi_device::xf510_pflushan_l_4fc()
 {
 	if(m_has_pmmu) {
 		logerror("68040: unhandled PFLUSHAN (ir=%04x)\n", m_ir);
+		coverage_flush();
 	} else {
 		m68ki_exception_1111();
 	}
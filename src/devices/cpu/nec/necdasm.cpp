@@ -1761,3 +1761,8 @@ u32 nec_disassembler::opcode_alignment() const
 	return 1;
 }
 
+u32 nec_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
@@ -180,6 +180,11 @@ u32 psxcpu_disassembler::opcode_alignment() const
 	return 4;
 }
 
+u32 psxcpu_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t psxcpu_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	uint32_t op;
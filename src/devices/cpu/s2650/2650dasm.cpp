@@ -560,7 +560,7 @@ u32 s2650_disassembler::opcode_alignment() const
 
 u32 s2650_disassembler::interface_flags() const
 {
-	return PAGED;
+	return PAGED | STATE_DEPENDENT;
 }
 
 u32 s2650_disassembler::page_address_bits() const
@@ -743,6 +743,11 @@ u32 sparc_disassembler::opcode_alignment() const
 	return 4;
 }
 
+u32 sparc_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t sparc_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	return dasm(stream, pc, opcodes.r32(pc));
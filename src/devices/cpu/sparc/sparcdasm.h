@@ -105,6 +105,7 @@ public:
 	}
 
 	virtual u32 opcode_alignment() const override;
+	virtual u32 interface_flags() const override;
 	virtual offs_t disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params) override;
 
 	offs_t dasm(std::ostream &stream, offs_t pc, uint32_t op) const;
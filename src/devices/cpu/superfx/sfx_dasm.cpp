@@ -12,6 +12,11 @@ u32 superfx_disassembler::opcode_alignment() const
 	return 1;
 }
 
+u32 superfx_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t superfx_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	uint8_t  op = opcodes.r8(pc);
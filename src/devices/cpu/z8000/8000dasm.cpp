@@ -575,6 +575,11 @@ u32 z8000_disassembler::opcode_alignment() const
 	return 2;
 }
 
+u32 z8000_disassembler::interface_flags() const
+{
+	return STATE_DEPENDENT;
+}
+
 offs_t z8000_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
 {
 	u8 n[16];   /* opcode nibbles */
@@ -9,6 +9,8 @@
 #include "emu.h"
 #include "bitbngr.h"
 
+#include "iopoll.h"
+#include "journal.h"
 #include "softlist_dev.h"
 
 #include <cstring>
@@ -29,7 +31,8 @@ bitbanger_device::bitbanger_device(const machine_config &mconfig, const char *ta
 	device_t(mconfig, BITBANGER, tag, owner, clock),
 	device_image_interface(mconfig, *this),
 	m_interface(nullptr),
-	m_is_readonly(false)
+	m_is_readonly(false),
+	m_journal(nullptr)
 {
 }
 
@@ -51,6 +54,19 @@ void bitbanger_device::output(uint8_t data)
 -------------------------------------------------*/
 
 uint32_t bitbanger_device::input(void *buffer, uint32_t length)
+{
+	if (m_journal)
+		return m_journal->input(reinterpret_cast<u8 *>(buffer), length, [this] (u8 *buf, size_t len) { return size_t(host_input(buf, len)); });
+	return host_input(buffer, length);
+}
+
+
+/*-------------------------------------------------
+    host_input - inputs data from the host side,
+    bypassing the journal
+-------------------------------------------------*/
+
+uint32_t bitbanger_device::host_input(void *buffer, uint32_t length)
 {
 	if (exists())
 		return fread(buffer, length);
@@ -60,12 +76,39 @@ uint32_t bitbanger_device::input(void *buffer, uint32_t length)
 
 
 
+/*-------------------------------------------------
+    notify_input - request a callback when the
+    host side has data for us
+-------------------------------------------------*/
+
+bool bitbanger_device::notify_input(delegate<void ()> &&callback)
+{
+	if (m_journal)
+		return m_journal->notify(std::move(callback), [this] (delegate<void ()> &&cb) { return host_notify_input(std::move(cb)); });
+	return host_notify_input(std::move(callback));
+}
+
+
+/*-------------------------------------------------
+    host_notify_input - request a callback from
+    the host side, bypassing the journal
+-------------------------------------------------*/
+
+bool bitbanger_device::host_notify_input(delegate<void ()> &&callback)
+{
+	osd_file *const file = is_open() ? image_core_file().osd_handle() : nullptr;
+	return file && machine().iopoll().notify_readable(*file, std::move(callback));
+}
+
+
+
 /*-------------------------------------------------
     device_start
 -------------------------------------------------*/
 
 void bitbanger_device::device_start()
 {
+	m_journal = machine().journal().channel(std::string("bitbanger:") + tag());
 }
 
 
@@ -103,5 +146,8 @@ std::pair<std::error_condition, std::string> bitbanger_device::call_create(int f
 
 void bitbanger_device::call_unload()
 {
-	// we don't need to do anything special
+	// stop waiting for input before the file is closed
+	osd_file *const file = is_open() ? image_core_file().osd_handle() : nullptr;
+	if (file)
+		machine().iopoll().cancel(*file);
 }
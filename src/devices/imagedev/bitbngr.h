@@ -37,6 +37,9 @@ public:
 	void output(uint8_t data);
 	uint32_t input(void *buffer, uint32_t length);
 
+	// ask for a callback once there's input to read; if this returns false, poll with input instead
+	bool notify_input(delegate<void ()> &&callback);
+
 protected:
 	// device_t implementation
 	virtual void device_start() override;
@@ -45,8 +48,12 @@ protected:
 	virtual software_list_loader const &get_software_list_loader() const override;
 
 private:
+	uint32_t host_input(void *buffer, uint32_t length);
+	bool host_notify_input(delegate<void ()> &&callback);
+
 	char const *m_interface;
 	bool m_is_readonly;
+	journal_channel *m_journal;
 };
 
 
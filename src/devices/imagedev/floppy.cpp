@@ -266,6 +266,11 @@ floppy_image_device::floppy_image_device(const machine_config &mconfig, device_t
 		m_cyl(0),
 		m_subcyl(0),
 		m_amplifier_freakout_time(attotime::from_usec(16)),
+		m_track_map_cyl(0),
+		m_track_map_ss(0),
+		m_track_map_subcyl(0),
+		m_track_map_cell(0),
+		m_track_map_ok(false),
 		m_image_dirty(false),
 		m_track_dirty(false),
 		m_ready_counter(0),
@@ -613,6 +618,7 @@ std::pair<std::error_condition, const floppy_image_format_t *> floppy_image_devi
 void floppy_image_device::init_floppy_load(bool write_supported)
 {
 	cache_clear();
+	track_map_clear();
 	m_revolution_start_time = m_mon ? attotime::never : machine().time();
 	m_revolution_count = 0;
 
@@ -678,6 +684,7 @@ std::pair<std::error_condition, std::string> floppy_image_device::call_load()
 void floppy_image_device::call_unload()
 {
 	cache_clear();
+	track_map_clear();
 	m_dskchg = 0;
 
 	if (m_image) {
@@ -1137,6 +1144,135 @@ attotime floppy_image_device::get_next_transition(const attotime &from_when)
 	}
 }
 
+attotime floppy_image_device::position_next_time(u32 position, const attotime &from_when)
+{
+	if(!m_image || m_mon)
+		return attotime::never;
+
+	attotime base;
+	u32 current = find_position(base, from_when);
+	if(position < current)
+		base += m_rev_time;
+	return position_to_time(base, position);
+}
+
+void floppy_image_device::track_map_clear()
+{
+	m_track_map.clear();
+	m_track_map_cell = 0;
+	m_track_map_ok = false;
+}
+
+// Returns the sector headers of the current track when it decodes
+// cleanly as MFM with the given cell time, nullptr otherwise.  The
+// result is kept until the head moves or the track is written, so
+// controllers can find a sector without walking the whole track.
+const std::vector<floppy_image_device::mfm_sector_header> *floppy_image_device::get_mfm_sector_headers(const attotime &cell_time)
+{
+	if(!m_image || m_mon)
+		return nullptr;
+
+	u32 const cell = u32(cell_time.as_double()*m_angular_speed + 0.5);
+	if(cell < 8)
+		return nullptr;
+
+	if(m_track_map_cell != cell || m_track_map_cyl != m_cyl || m_track_map_ss != m_ss || m_track_map_subcyl != m_subcyl) {
+		m_track_map_cyl = m_cyl;
+		m_track_map_ss = m_ss;
+		m_track_map_subcyl = m_subcyl;
+		m_track_map_cell = cell;
+		track_map_build(cell);
+	}
+
+	return m_track_map_ok ? &m_track_map : nullptr;
+}
+
+void floppy_image_device::track_map_build(u32 cell)
+{
+	m_track_map.clear();
+	m_track_map_ok = false;
+
+	// Pack the track into one bit per cell.  Only tracks made purely of
+	// flux transitions 2 to 4 cells apart (within a quarter cell) qualify,
+	// anything else is left to the controller's pll.
+	const std::vector<uint32_t> &buf = m_image->get_buffer(m_cyl, m_ss, m_subcyl);
+	if(buf.size() < 2)
+		return;
+
+	std::vector<u32> bits;
+	u32 cells = 0;
+	for(size_t i = 0; i != buf.size(); i++) {
+		if((buf[i] & floppy_image::MG_MASK) != floppy_image::MG_F)
+			return;
+		u32 const pos = buf[i] & floppy_image::TIME_MASK;
+		u32 const next = i+1 != buf.size() ? buf[i+1] & floppy_image::TIME_MASK : (buf[0] & floppy_image::TIME_MASK) + 200000000;
+		u32 const delta = next - pos;
+		u32 const count = (delta + cell/2) / cell;
+		if(count < 2 || count > 4 || std::abs(int(delta) - int(count*cell)) > int(cell/4))
+			return;
+		if((cells >> 5) >= bits.size())
+			bits.resize((cells >> 5) + 64, 0);
+		bits[cells >> 5] |= 0x80000000U >> (cells & 31);
+		cells += count;
+	}
+
+	auto const bit = [&bits, cells] (u32 index) -> u32 {
+		index %= cells;
+		return (bits[index >> 5] >> (31 - (index & 31))) & 1;
+	};
+	auto const word = [&bit] (u32 index) -> u16 {
+		u16 res = 0;
+		for(int i = 0; i != 16; i++)
+			res = (res << 1) | bit(index + i);
+		return res;
+	};
+	auto const data = [] (u16 raw) -> u8 {
+		u8 res = 0;
+		for(int i = 0; i != 8; i++)
+			res |= BIT(raw, 14 - 2*i) << (7 - i);
+		return res;
+	};
+
+	// Look for A1 A1 A1 FE and decode the id field following it,
+	// wrapping around the index so a header split by it is found too
+	double const cell_pos = 200000000.0 / cells;
+	u32 const first = buf[0] & floppy_image::TIME_MASK;
+	u16 shift = 0;
+	for(u32 i = 0; i < cells + 16*10; i++) {
+		shift = (shift << 1) | bit(i);
+		if(i < 15 || shift != 0x4489)
+			continue;
+
+		u32 const start = i - 15;
+		if(start >= cells)
+			break;
+		if(word(start + 16) != 0x4489 || word(start + 32) != 0x4489 || data(word(start + 48)) != 0xfe)
+			continue;
+
+		u8 id[6];
+		u16 crc = 0xffff;
+		for(u8 val : { 0xa1, 0xa1, 0xa1, 0xfe })
+			for(int b = 7; b >= 0; b--)
+				crc = (crc << 1) ^ ((BIT(crc, 15) ^ BIT(val, b)) ? 0x1021 : 0);
+		for(int j = 0; j != 6; j++) {
+			id[j] = data(word(start + 64 + 16*j));
+			for(int b = 7; b >= 0; b--)
+				crc = (crc << 1) ^ ((BIT(crc, 15) ^ BIT(id[j], b)) ? 0x1021 : 0);
+		}
+
+		mfm_sector_header &hdr = m_track_map.emplace_back();
+		std::copy_n(id, 4, hdr.idbuf);
+		hdr.position = u32(first + start*cell_pos + 0.5) % 200000000;
+		hdr.crc_ok = crc == 0;
+
+		shift = 0;
+		i = start + 16*10 - 1;
+	}
+
+	std::sort(m_track_map.begin(), m_track_map.end(), [] (const mfm_sector_header &a, const mfm_sector_header &b) { return a.position < b.position; });
+	m_track_map_ok = true;
+}
+
 bool floppy_image_device::writing_disabled() const
 {
 	// Disable writing when write protect is on or when, in the diskii
@@ -1178,6 +1314,7 @@ void floppy_image_device::write_flux(const attotime &start, const attotime &end,
 	wspan_write(wspans, buf);
 
 	cache_clear();
+	track_map_clear();
 }
 
 void floppy_image_device::wspan_split_on_wrap(std::vector<wspan> &wspans)
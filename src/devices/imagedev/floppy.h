@@ -145,8 +145,17 @@ public:
 	void dskchg_w(int state) { if (m_dskchg_writable) m_dskchg = state; }
 	void ds_w(int state) { m_ds = state; check_led(); }
 
+	// Sector header found by decoding a well-formed MFM track
+	struct mfm_sector_header {
+		u8 idbuf[4];  // cylinder, head, sector, size code
+		u32 position; // angular position of the first A1 sync mark
+		bool crc_ok;
+	};
+
 	attotime time_next_index();
 	attotime get_next_transition(const attotime &from_when);
+	attotime position_next_time(u32 position, const attotime &from_when);
+	const std::vector<mfm_sector_header> *get_mfm_sector_headers(const attotime &cell_time);
 	void write_flux(const attotime &start, const attotime &end, int transition_count, const attotime *transitions);
 	void set_write_splice(const attotime &when);
 	int get_sides() { return m_sides; }
@@ -234,6 +243,11 @@ protected:
 	int m_cache_index;
 	u32 m_cache_entry;
 	bool m_cache_weak;
+	/* Decoded MFM sector headers of the current track, rebuilt on demand */
+	std::vector<mfm_sector_header> m_track_map;
+	int m_track_map_cyl, m_track_map_ss, m_track_map_subcyl;
+	u32 m_track_map_cell; /* cell size in angular units, 0 when invalid */
+	bool m_track_map_ok;
 
 	bool m_image_dirty, m_track_dirty;
 	int m_ready_counter;
@@ -273,6 +287,9 @@ protected:
 	void cache_fill(const attotime &when);
 	void cache_weakness_setup();
 
+	void track_map_clear();
+	void track_map_build(u32 cell);
+
 	// Sound
 	bool    m_make_sound;
 	floppy_sound_device* m_sound_out;
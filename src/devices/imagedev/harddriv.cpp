@@ -116,6 +116,7 @@ void harddisk_image_device::device_start()
 
 void harddisk_image_device::device_stop()
 {
+	flush_overlay();
 	m_hard_disk_handle.reset();
 }
 
@@ -169,6 +170,33 @@ void harddisk_image_device::setup_current_preset_image()
 {
 	chd_file *chd = current_preset_image_chd();
 	m_hard_disk_handle.reset(new hard_disk_file(chd));
+	apply_overlay_mode();
+}
+
+//-------------------------------------------------
+//  overlay_mode - get the copy-on-write overlay
+//  mode requested on the command line
+//-------------------------------------------------
+
+hard_disk_file::overlay_mode harddisk_image_device::overlay_mode() const
+{
+	const char *const mode = machine().options().hd_overlay();
+	if (!strcmp(mode, "memory"))
+		return hard_disk_file::overlay_mode::MEMORY;
+	else if (!strcmp(mode, "writeback"))
+		return hard_disk_file::overlay_mode::WRITEBACK;
+
+	if (strcmp(mode, "none"))
+		osd_printf_warning("Invalid hard disk overlay mode '%s', ignoring\n", mode);
+	return hard_disk_file::overlay_mode::NONE;
+}
+
+void harddisk_image_device::apply_overlay_mode()
+{
+	// raw images can't use the overlay; they're written in place
+	hard_disk_file::overlay_mode const mode = overlay_mode();
+	if ((mode != hard_disk_file::overlay_mode::NONE) && !m_hard_disk_handle->set_overlay_mode(mode))
+		osd_printf_verbose("%s: hard disk overlay is only supported for CHD images\n", tag());
 }
 
 void harddisk_image_device::call_unload()
@@ -177,6 +205,8 @@ void harddisk_image_device::call_unload()
 	if (!m_device_image_unload.isnull())
 		m_device_image_unload(*this);
 
+	// merge anything still in a writeback overlay before the CHD goes away
+	flush_overlay();
 	m_hard_disk_handle.reset();
 
 	if (m_chd)
@@ -257,16 +287,18 @@ std::error_condition harddisk_image_device::internal_load_hd()
 
 		if (!memcmp("MComprHD", header, 8))
 		{
+			// when writes never leave memory, there's no need for a writeable CHD or a diff
+			bool const readonly = overlay_mode() == hard_disk_file::overlay_mode::MEMORY;
 			util::core_file::ptr proxy;
 			err = util::core_file::open_proxy(image_core_file(), proxy);
 			if (!err)
-				err = m_origchd.open(std::move(proxy), true);
+				err = m_origchd.open(std::move(proxy), !readonly);
 
 			if (!err)
 			{
 				m_chd = &m_origchd;
 			}
-			else if (err == chd_file::error::FILE_NOT_WRITEABLE)
+			else if (!readonly && (err == chd_file::error::FILE_NOT_WRITEABLE))
 			{
 				err = util::core_file::open_proxy(image_core_file(), proxy);
 				if (!err)
@@ -291,7 +323,10 @@ std::error_condition harddisk_image_device::internal_load_hd()
 		{
 			m_hard_disk_handle.reset(new hard_disk_file(m_chd));
 			if (m_hard_disk_handle)
+			{
+				apply_overlay_mode();
 				return std::error_condition();
+			}
 		}
 		catch (...)
 		{
@@ -325,9 +360,26 @@ std::error_condition harddisk_image_device::internal_load_hd()
 			}
 		}
 
+		// map plain files straight into memory if requested, falling back to file I/O
+		osd_file_mapping::ptr mapping;
+		if (machine().options().hd_mmap() && !loaded_through_softlist())
+		{
+			std::error_condition const maperr = osd_file_mapping::open(filename(), !is_readonly(), mapping);
+			if (maperr)
+				osd_printf_verbose("harddriv: can't map %s (%s), using file I/O\n", filename(), maperr.message());
+		}
+
 		try
 		{
-			m_hard_disk_handle.reset(new hard_disk_file(image_core_file(), skip));
+			if (mapping)
+			{
+				m_hard_disk_handle.reset(new hard_disk_file(image_core_file(), skip, std::move(mapping)));
+				m_hard_disk_handle->set_read_ahead(uint32_t(machine().options().hd_readahead()) * 1024);
+			}
+			else
+			{
+				m_hard_disk_handle.reset(new hard_disk_file(image_core_file(), skip));
+			}
 			if (m_hard_disk_handle)
 				return std::error_condition();
 		}
@@ -369,6 +421,12 @@ bool harddisk_image_device::set_block_size(uint32_t blocksize)
 	return m_hard_disk_handle->set_block_size(blocksize);
 }
 
+void harddisk_image_device::flush_overlay()
+{
+	if (m_hard_disk_handle)
+		m_hard_disk_handle->flush_overlay();
+}
+
 std::error_condition harddisk_image_device::get_inquiry_data(std::vector<uint8_t> &data) const
 {
 	return m_hard_disk_handle->get_inquiry_data(data);
@@ -80,6 +80,8 @@ public:
 
 	bool set_block_size(uint32_t blocksize);
 
+	void flush_overlay();
+
 	std::error_condition get_inquiry_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_cis_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_disk_key_data(std::vector<uint8_t> &data) const;
@@ -97,6 +99,8 @@ protected:
 
 	void setup_current_preset_image();
 	std::error_condition internal_load_hd();
+	hard_disk_file::overlay_mode overlay_mode() const;
+	void apply_overlay_mode();
 
 	chd_file        *m_chd;
 	chd_file        m_origchd;              // handle to the original CHD
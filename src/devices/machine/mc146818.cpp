@@ -61,9 +61,14 @@ mc146818_device::mc146818_device(const machine_config &mconfig, device_type type
 	, device_rtc_interface(mconfig, *this)
 	, m_region(*this, DEVICE_SELF)
 	, m_index(0)
-	, m_clock_timer(nullptr)
 	, m_update_timer(nullptr)
 	, m_periodic_timer(nullptr)
+	, m_update_base(attotime::zero)
+	, m_updates(0)
+	, m_update_target(0)
+	, m_periodic_base(attotime::zero)
+	, m_toggles(0)
+	, m_periodic_target(0)
 	, m_write_irq(*this)
 	, m_write_sqw(*this)
 	, m_century_index(-1)
@@ -82,13 +87,18 @@ mc146818_device::mc146818_device(const machine_config &mconfig, device_type type
 void mc146818_device::device_start()
 {
 	m_data = make_unique_clear<uint8_t[]>(data_size());
-	m_clock_timer = timer_alloc(FUNC(mc146818_device::clock_tick), this);
-	m_update_timer = timer_alloc(FUNC(mc146818_device::time_tick), this);
-	m_periodic_timer = timer_alloc(FUNC(mc146818_device::periodic_tick), this);
+	m_update_timer = timer_alloc(FUNC(mc146818_device::update_expired), this);
+	m_periodic_timer = timer_alloc(FUNC(mc146818_device::periodic_expired), this);
 
 	save_pointer(NAME(m_data), data_size());
 	save_item(NAME(m_index));
 	save_item(NAME(m_sqw_state));
+	save_item(NAME(m_update_base));
+	save_item(NAME(m_updates));
+	save_item(NAME(m_update_target));
+	save_item(NAME(m_periodic_base));
+	save_item(NAME(m_toggles));
+	save_item(NAME(m_periodic_target));
 }
 
 
@@ -98,6 +108,8 @@ void mc146818_device::device_start()
 
 void mc146818_device::device_reset()
 {
+	clock_sync();
+
 	m_data[REG_B] &= ~(REG_B_UIE | REG_B_AIE | REG_B_PIE | REG_B_SQWE);
 	m_data[REG_C] = 0;
 
@@ -106,138 +118,113 @@ void mc146818_device::device_reset()
 		m_write_sqw(CLEAR_LINE);
 
 	update_irq();
+	clock_schedule();
 }
 
 //-------------------------------------------------
 //  timer events
 //-------------------------------------------------
 
-TIMER_CALLBACK_MEMBER(mc146818_device::periodic_tick)
+TIMER_CALLBACK_MEMBER(mc146818_device::update_expired)
 {
-	m_sqw_state = !m_sqw_state;
-
-	if (m_data[REG_B] & REG_B_SQWE)
-		m_write_sqw(m_sqw_state);
-
-	// periodic flag/interrupt on rising edge of periodic timer
-	if (m_sqw_state)
-	{
-		m_data[REG_C] |= REG_C_PF;
-		update_irq();
-	}
+	clock_sync(true, false);
 }
 
-TIMER_CALLBACK_MEMBER(mc146818_device::clock_tick)
+TIMER_CALLBACK_MEMBER(mc146818_device::periodic_expired)
 {
-	if (!(m_data[REG_B] & REG_B_SET))
-	{
-		m_data[REG_A] |= REG_A_UIP;
-
-		m_update_timer->adjust(attotime::from_usec(244));
-	}
+	clock_sync(false, true);
 }
 
-TIMER_CALLBACK_MEMBER(mc146818_device::time_tick)
+//-------------------------------------------------
+//  advance_second - run one update cycle of the
+//  time and calendar registers
+//-------------------------------------------------
+
+void mc146818_device::advance_second()
 {
-	if (!param)
+	/// TODO: find out how the real chip deals with updates when binary/bcd values are already outside the normal range
+	int seconds = get_seconds() + 1;
+	if (seconds < 60)
+	{
+		set_seconds(seconds);
+	}
+	else
 	{
-		/// TODO: find out how the real chip deals with updates when binary/bcd values are already outside the normal range
-		int seconds = get_seconds() + 1;
-		if (seconds < 60)
+		set_seconds(0);
+
+		int minutes = get_minutes() + 1;
+		if (minutes < 60)
 		{
-			set_seconds(seconds);
+			set_minutes(minutes);
 		}
 		else
 		{
-			set_seconds(0);
+			set_minutes(0);
 
-			int minutes = get_minutes() + 1;
-			if (minutes < 60)
+			int hours = get_hours() + 1;
+			if (hours < 24)
 			{
-				set_minutes(minutes);
+				set_hours(hours);
 			}
 			else
 			{
-				set_minutes(0);
+				set_hours(0);
 
-				int hours = get_hours() + 1;
-				if (hours < 24)
+				int dayofweek = get_dayofweek() + 1;
+				if (dayofweek <= 7)
 				{
-					set_hours(hours);
+					set_dayofweek(dayofweek);
 				}
 				else
 				{
-					set_hours(0);
+					set_dayofweek(1);
+				}
 
-					int dayofweek = get_dayofweek() + 1;
-					if (dayofweek <= 7)
-					{
-						set_dayofweek(dayofweek);
-					}
-					else
-					{
-						set_dayofweek(1);
-					}
+				int dayofmonth = get_dayofmonth() + 1;
+				if (dayofmonth <= gregorian_days_in_month(get_month(), get_year() + 2000))
+				{
+					set_dayofmonth(dayofmonth);
+				}
+				else
+				{
+					set_dayofmonth(1);
 
-					int dayofmonth = get_dayofmonth() + 1;
-					if (dayofmonth <= gregorian_days_in_month(get_month(), get_year() + 2000))
+					int month = get_month() + 1;
+					if (month <= 12)
 					{
-						set_dayofmonth(dayofmonth);
+						set_month(month);
 					}
 					else
 					{
-						set_dayofmonth(1);
+						set_month(1);
 
-						int month = get_month() + 1;
-						if (month <= 12)
+						int year = get_year() + 1;
+						if (year <= 99)
 						{
-							set_month(month);
+							set_year(year);
 						}
 						else
 						{
-							set_month(1);
+							set_year(0);
 
-							int year = get_year() + 1;
-							if (year <= 99)
+							if (century_count_enabled())
 							{
-								set_year(year);
-							}
-							else
-							{
-								set_year(0);
-
-								if (century_count_enabled())
-								{
-									set_century((get_century() + 1) % 100);
-								}
+								set_century((get_century() + 1) % 100);
 							}
 						}
 					}
 				}
 			}
 		}
-
-		if ((m_data[REG_ALARM_SECONDS] == m_data[REG_SECONDS] || (m_data[REG_ALARM_SECONDS] & ALARM_DONTCARE) == ALARM_DONTCARE) &&
-			(m_data[REG_ALARM_MINUTES] == m_data[REG_MINUTES] || (m_data[REG_ALARM_MINUTES] & ALARM_DONTCARE) == ALARM_DONTCARE) &&
-			(m_data[REG_ALARM_HOURS] == m_data[REG_HOURS] || (m_data[REG_ALARM_HOURS] & ALARM_DONTCARE) == ALARM_DONTCARE))
-		{
-			// set the alarm interrupt flag AF
-			m_data[REG_C] |= REG_C_AF;
-		}
-
-		// defer the update end sequence if update cycle time is non-zero
-		if (m_tuc)
-		{
-			m_update_timer->adjust(attotime::from_usec(m_tuc), 1);
-			return;
-		}
 	}
 
-	// clear update in progress and set update ended
-	m_data[REG_A] &= ~REG_A_UIP;
-	m_data[REG_C] |= REG_C_UF;
-
-	update_irq();
+	if ((m_data[REG_ALARM_SECONDS] == m_data[REG_SECONDS] || (m_data[REG_ALARM_SECONDS] & ALARM_DONTCARE) == ALARM_DONTCARE) &&
+		(m_data[REG_ALARM_MINUTES] == m_data[REG_MINUTES] || (m_data[REG_ALARM_MINUTES] & ALARM_DONTCARE) == ALARM_DONTCARE) &&
+		(m_data[REG_ALARM_HOURS] == m_data[REG_HOURS] || (m_data[REG_ALARM_HOURS] & ALARM_DONTCARE) == ALARM_DONTCARE))
+	{
+		// set the alarm interrupt flag AF
+		m_data[REG_C] |= REG_C_AF;
+	}
 }
 
 //-------------------------------------------------
@@ -301,6 +288,10 @@ bool mc146818_device::nvram_read(util::read_stream &file)
 
 bool mc146818_device::nvram_write(util::write_stream &file)
 {
+	// the time registers are only brought up to date when something
+	// looks at them, so do that now or the file gets a stale time
+	clock_sync();
+
 	size_t const size = data_size();
 	auto const [err, actual] = write(file, &m_data[0], size);
 	return !err;
@@ -377,7 +368,7 @@ int mc146818_device::get_hours() const
 	}
 }
 
-void mc146818_device::set_hours(int hours)
+int mc146818_device::hours_to_ram(int hours) const
 {
 	if (!(m_data[REG_B] & REG_B_24_12))
 	{
@@ -394,14 +385,19 @@ void mc146818_device::set_hours(int hours)
 			hours = 12;
 		}
 
-		m_data[REG_HOURS] = to_ram(hours) | pm;
+		return to_ram(hours) | pm;
 	}
 	else
 	{
-		m_data[REG_HOURS] = to_ram(hours);
+		return to_ram(hours);
 	}
 }
 
+void mc146818_device::set_hours(int hours)
+{
+	m_data[REG_HOURS] = hours_to_ram(hours);
+}
+
 int mc146818_device::get_dayofweek() const
 {
 	return from_ram(m_data[REG_DAYOFWEEK]);
@@ -466,6 +462,8 @@ void mc146818_device::rtc_clock_updated(int year, int month, int day, int day_of
 //          year, month, day,
 //          hour, minute, second);
 
+	clock_sync();
+
 	set_seconds(second);
 	set_minutes(minute);
 	set_hours(hour);
@@ -480,50 +478,29 @@ void mc146818_device::rtc_clock_updated(int year, int month, int day, int day_of
 
 	if (m_century_index >= 0)
 		set_century(year / 100);
+
+	clock_schedule();
 }
 
 
 //-------------------------------------------------
-//  update_timer - update timer based on A register
+//  update_timer - restart the divider chain after
+//  a change to the A register
 //-------------------------------------------------
 
 void mc146818_device::update_timer()
 {
-	int bypass = get_timer_bypass();
-
-	attotime update_period = attotime::never;
-	attotime update_interval = attotime::never;
-	attotime periodic_period = attotime::never;
-	attotime periodic_interval = attotime::never;
-
-	if (bypass < 22)
-	{
-		int shift = 22 - bypass;
-
-		double update_hz = (double) clock() / (1 << shift);
-
-		// TODO: take the time since last timer into account
-		update_period = attotime::from_hz(update_hz * 2);
-		update_interval = attotime::from_hz(update_hz);
-
-		int rate_select = m_data[REG_A] & (REG_A_RS3 | REG_A_RS2 | REG_A_RS1 | REG_A_RS0);
-		if (rate_select != 0)
-		{
-			shift = (rate_select + 6) - bypass;
-			if (shift <= 1)
-				shift += 7;
+	// account for everything up to now at the old rates
+	clock_sync();
 
-			double periodic_hz = (double) clock() / (1 << shift);
+	// the first update cycle starts half a second from now, and the first
+	// periodic edge a quarter of a period from now
+	m_update_base = machine().time();
+	m_updates = 0;
+	m_periodic_base = m_update_base;
+	m_toggles = 0;
 
-			// TODO: take the time since last timer into account
-			// periodic frequency is doubled to produce square wave output
-			periodic_period = attotime::from_hz(periodic_hz * 4);
-			periodic_interval = attotime::from_hz(periodic_hz * 2);
-		}
-	}
-
-	m_clock_timer->adjust(update_period, 0, update_interval);
-	m_periodic_timer->adjust(periodic_period, 0, periodic_interval);
+	clock_schedule();
 }
 
 //---------------------------------------------------------------
@@ -562,6 +539,247 @@ int mc146818_device::get_timer_bypass() const
 	return bypass;
 }
 
+//-------------------------------------------------
+//  get_update_shift - log2 of the update cycle
+//  period in input clocks, or -1 if stopped
+//-------------------------------------------------
+
+int mc146818_device::get_update_shift() const
+{
+	int const bypass = get_timer_bypass();
+	return (bypass < 22 && clock()) ? (22 - bypass) : -1;
+}
+
+//-------------------------------------------------
+//  get_periodic_shift - log2 of the periodic
+//  interrupt period in input clocks, or -1 if
+//  disabled
+//-------------------------------------------------
+
+int mc146818_device::get_periodic_shift() const
+{
+	int const bypass = get_timer_bypass();
+	int const rate_select = m_data[REG_A] & (REG_A_RS3 | REG_A_RS2 | REG_A_RS1 | REG_A_RS0);
+	if (bypass >= 22 || rate_select == 0 || !clock())
+		return -1;
+
+	int shift = (rate_select + 6) - bypass;
+	if (shift <= 1)
+		shift += 7;
+	return shift;
+}
+
+//-------------------------------------------------
+//  update_cycle_time - time from the start of an
+//  update cycle to its end
+//-------------------------------------------------
+
+attotime mc146818_device::update_cycle_time() const
+{
+	return attotime::from_usec(244 + m_tuc);
+}
+
+//-------------------------------------------------
+//  events_until - count the events occurring at
+//  base + first + n * (1 << shift) input clocks
+//  up to and including the given time
+//-------------------------------------------------
+
+u64 mc146818_device::events_until(const attotime &time, const attotime &base, u64 first, int shift) const
+{
+	if (time < base)
+		return 0;
+
+	u64 const ticks = (time - base).as_ticks(clock());
+	return (ticks < first) ? 0 : (((ticks - first) >> shift) + 1);
+}
+
+//-------------------------------------------------
+//  update_in_progress - derive the UIP flag from
+//  the position within the update period
+//-------------------------------------------------
+
+bool mc146818_device::update_in_progress() const
+{
+	int const shift = get_update_shift();
+	if (shift < 0 || (m_data[REG_B] & REG_B_SET))
+		return false;
+
+	attotime const now = machine().time();
+	u64 const first = u64(1) << (shift - 1);
+	return events_until(now, m_update_base, first, shift) > events_until(now, m_update_base + update_cycle_time(), first, shift);
+}
+
+//-------------------------------------------------
+//  seconds_to_alarm - number of update cycles
+//  until the time matches the alarm, or 0 if it
+//  never will
+//-------------------------------------------------
+
+u32 mc146818_device::seconds_to_alarm() const
+{
+	// work out which values each alarm field accepts
+	auto const accepted =
+			[this] (int reg, int count, auto &&encode)
+			{
+				u64 result = 0;
+				for (int value = 0; value < count; value++)
+				{
+					if ((m_data[reg] == encode(value)) || ((m_data[reg] & ALARM_DONTCARE) == ALARM_DONTCARE))
+						result |= u64(1) << value;
+				}
+				return result;
+			};
+	u64 const seconds = accepted(REG_ALARM_SECONDS, 60, [this] (int value) { return to_ram(value); });
+	u64 const minutes = accepted(REG_ALARM_MINUTES, 60, [this] (int value) { return to_ram(value); });
+	u64 const hours = accepted(REG_ALARM_HOURS, 24, [this] (int value) { return hours_to_ram(value); });
+	if (!seconds || !minutes || !hours)
+		return 0;
+
+	// first accepted value at or after the given one, or -1
+	auto const next =
+			[] (u64 values, int from)
+			{
+				for (int value = from; value < 60; value++)
+				{
+					if (BIT(values, value))
+						return value;
+				}
+				return -1;
+			};
+
+	// earliest match after the current time today, otherwise the first one tomorrow
+	int const day = 24 * 60 * 60;
+	int const now = ((get_hours() * 60 + get_minutes()) * 60 + get_seconds()) % day;
+	int const from = now + 1;
+	int const fromhour = from / (60 * 60), fromminute = (from / 60) % 60, fromsecond = from % 60;
+	for (int hour = next(hours, fromhour); hour >= 0; hour = next(hours, hour + 1))
+	{
+		int minute = next(minutes, (hour == fromhour) ? fromminute : 0);
+		for ( ; minute >= 0; minute = next(minutes, minute + 1))
+		{
+			int const second = next(seconds, ((hour == fromhour) && (minute == fromminute)) ? fromsecond : 0);
+			if (second >= 0)
+				return ((hour * 60 + minute) * 60 + second) - now;
+		}
+	}
+
+	int const first = (next(hours, 0) * 60 + next(minutes, 0)) * 60 + next(seconds, 0);
+	return first + day - now;
+}
+
+//-------------------------------------------------
+//  clock_sync - bring the time registers, flags
+//  and square wave up to the current time
+//-------------------------------------------------
+
+void mc146818_device::clock_sync(bool update_expired, bool periodic_expired)
+{
+	attotime const now = machine().time();
+	bool advanced = update_expired || periodic_expired;
+	bool flagged = false;
+
+	int const update_shift = get_update_shift();
+	if (update_shift >= 0)
+	{
+		u64 ended = events_until(now, m_update_base + update_cycle_time(), u64(1) << (update_shift - 1), update_shift);
+		if (update_expired && (ended < m_update_target))
+			ended = m_update_target;
+
+		if (ended > m_updates)
+		{
+			u64 count = ended - m_updates;
+			m_updates = ended;
+			advanced = true;
+
+			// the SET bit inhibits update cycles
+			if (!(m_data[REG_B] & REG_B_SET))
+			{
+				while (count--)
+					advance_second();
+
+				// set update ended
+				m_data[REG_C] |= REG_C_UF;
+				flagged = true;
+			}
+		}
+	}
+
+	int const periodic_shift = get_periodic_shift();
+	if (periodic_shift >= 0)
+	{
+		u64 toggles = events_until(now, m_periodic_base, u64(1) << (periodic_shift - 2), periodic_shift - 1);
+		if (periodic_expired && (toggles < m_periodic_target))
+			toggles = m_periodic_target;
+
+		if (toggles > m_toggles)
+		{
+			u64 const count = toggles - m_toggles;
+			bool const rising = (count > 1) || !m_sqw_state;
+			m_toggles = toggles;
+			advanced = true;
+
+			if (count & 1)
+			{
+				m_sqw_state = !m_sqw_state;
+
+				if (m_data[REG_B] & REG_B_SQWE)
+					m_write_sqw(m_sqw_state);
+			}
+
+			// periodic flag/interrupt on rising edge of periodic timer
+			if (rising)
+			{
+				m_data[REG_C] |= REG_C_PF;
+				flagged = true;
+			}
+		}
+	}
+
+	if (flagged)
+		update_irq();
+	if (advanced)
+		clock_schedule();
+}
+
+//-------------------------------------------------
+//  clock_schedule - arm timers for the next event
+//  that is visible outside the chip
+//-------------------------------------------------
+
+void mc146818_device::clock_schedule()
+{
+	attotime const now = machine().time();
+
+	// update cycles only need to be timed for pending update or alarm interrupts
+	attotime next = attotime::never;
+	int const update_shift = get_update_shift();
+	bool const update_wanted = (m_data[REG_B] & REG_B_UIE) && !(m_data[REG_C] & REG_C_UF);
+	bool const alarm_wanted = (m_data[REG_B] & REG_B_AIE) && !(m_data[REG_C] & REG_C_AF);
+	if (update_shift >= 0 && !(m_data[REG_B] & REG_B_SET) && (update_wanted || alarm_wanted))
+	{
+		u32 const ahead = update_wanted ? 1 : seconds_to_alarm();
+		if (ahead)
+		{
+			m_update_target = m_updates + ahead;
+			next = m_update_base + update_cycle_time() + attotime::from_ticks((u64(1) << (update_shift - 1)) + ((m_update_target - 1) << update_shift), clock());
+		}
+	}
+	m_update_timer->adjust((next > now) ? (next - now) : attotime::zero);
+
+	// the square wave output needs every edge, the periodic interrupt only rising edges
+	next = attotime::never;
+	int const periodic_shift = get_periodic_shift();
+	bool const sqw_wanted = m_data[REG_B] & REG_B_SQWE;
+	bool const periodic_wanted = (m_data[REG_B] & REG_B_PIE) && !(m_data[REG_C] & REG_C_PF);
+	if (periodic_shift >= 0 && (sqw_wanted || periodic_wanted))
+	{
+		m_periodic_target = m_toggles + ((sqw_wanted || !m_sqw_state) ? 1 : 2);
+		next = m_periodic_base + attotime::from_ticks((u64(1) << (periodic_shift - 2)) + ((m_periodic_target - 1) << (periodic_shift - 1)), clock());
+	}
+	m_periodic_timer->adjust((next > now) ? (next - now) : attotime::zero);
+}
+
 //-------------------------------------------------
 //  update_irq - Update irq based on B & C register
 //-------------------------------------------------
@@ -648,10 +866,14 @@ uint8_t mc146818_device::internal_read(offs_t offset)
 {
 	uint8_t data = 0;
 
+	// the clock only advances when something looks at it
+	if (offset <= REG_C || int(offset) == m_century_index)
+		clock_sync();
+
 	switch (offset)
 	{
 	case REG_A:
-		data = m_data[REG_A];
+		data = (m_data[REG_A] & ~REG_A_UIP) | (update_in_progress() ? REG_A_UIP : 0);
 		break;
 
 	case REG_C:
@@ -662,6 +884,7 @@ uint8_t mc146818_device::internal_read(offs_t offset)
 		{
 			m_data[REG_C] &= ~(REG_C_IRQF | REG_C_PF | REG_C_AF | REG_C_UF);
 			update_irq();
+			clock_schedule();
 		}
 		break;
 
@@ -685,7 +908,9 @@ void mc146818_device::internal_write(offs_t offset, uint8_t data)
 	{
 	case REG_SECONDS:
 		// top bit of SECONDS is read only
+		clock_sync();
 		m_data[REG_SECONDS] = data & ~0x80;
+		clock_schedule();
 		break;
 
 	case REG_A:
@@ -698,6 +923,8 @@ void mc146818_device::internal_write(offs_t offset, uint8_t data)
 		break;
 
 	case REG_B:
+		clock_sync();
+
 		if ((data & REG_B_SET) && !(m_data[REG_B] & REG_B_SET))
 			data &= ~REG_B_UIE;
 
@@ -706,6 +933,7 @@ void mc146818_device::internal_write(offs_t offset, uint8_t data)
 
 		m_data[REG_B] = data;
 		update_irq();
+		clock_schedule();
 		break;
 
 	case REG_C:
@@ -714,7 +942,17 @@ void mc146818_device::internal_write(offs_t offset, uint8_t data)
 		break;
 
 	default:
-		m_data[offset] = data;
+		if (offset < REG_A || int(offset) == m_century_index)
+		{
+			// time, calendar and alarm changes move the next alarm
+			clock_sync();
+			m_data[offset] = data;
+			clock_schedule();
+		}
+		else
+		{
+			m_data[offset] = data;
+		}
 		break;
 	}
 }
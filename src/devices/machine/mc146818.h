@@ -78,9 +78,8 @@ protected:
 	virtual uint8_t internal_read(offs_t offset);
 	virtual void internal_write(offs_t offset, uint8_t data);
 
-	TIMER_CALLBACK_MEMBER(periodic_tick);
-	TIMER_CALLBACK_MEMBER(clock_tick);
-	TIMER_CALLBACK_MEMBER(time_tick);
+	TIMER_CALLBACK_MEMBER(update_expired);
+	TIMER_CALLBACK_MEMBER(periodic_expired);
 
 	enum
 	{
@@ -143,6 +142,16 @@ protected:
 	void update_irq();
 	void update_timer();
 	virtual int get_timer_bypass() const;
+	int get_update_shift() const;
+	int get_periodic_shift() const;
+	attotime update_cycle_time() const;
+	u64 events_until(const attotime &time, const attotime &base, u64 first, int shift) const;
+	bool update_in_progress() const;
+	void advance_second();
+	int hours_to_ram(int hours) const;
+	u32 seconds_to_alarm() const;
+	void clock_sync(bool update_expired = false, bool periodic_expired = false);
+	void clock_schedule();
 	int get_seconds() const;
 	void set_seconds(int seconds);
 	int get_minutes() const;
@@ -167,10 +176,17 @@ protected:
 	uint8_t           m_index;
 	std::unique_ptr<uint8_t[]> m_data;
 
-	emu_timer *m_clock_timer;
 	emu_timer *m_update_timer;
 	emu_timer *m_periodic_timer;
 
+	// the clock is derived from emulated time when observed rather than ticked
+	attotime m_update_base;     // reference time for update cycles
+	u64 m_updates;              // update cycles accounted for since m_update_base
+	u64 m_update_target;        // update cycles completed when m_update_timer expires
+	attotime m_periodic_base;   // reference time for periodic square wave edges
+	u64 m_toggles;              // square wave edges accounted for since m_periodic_base
+	u64 m_periodic_target;      // square wave edges passed when m_periodic_timer expires
+
 	devcb_write_line m_write_irq;
 	devcb_write_line m_write_sqw;
 	int m_century_index, m_epoch;
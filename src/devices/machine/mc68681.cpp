@@ -1309,6 +1309,17 @@ void duart_channel::tra_callback()
 	}
 }
 
+void duart_channel::tra_character_started()
+{
+	// whole character handed to the peer, but TxRDY still follows the end of start bit time
+	m_bits_transmitted = 2;
+	if (!m_tx_data_in_buffer)
+	{
+		SR |= STATUS_TRANSMITTER_READY;
+		update_interrupts();
+	}
+}
+
 void duart_channel::update_interrupts()
 {
 	// Handle the TxEMT and TxRDY bits based on mode
@@ -1400,6 +1411,7 @@ uint8_t duart_channel::read_rx_fifo()
 	else
 		SR |= rx_fifo[rx_fifo_read_ptr] >> 8;
 	update_interrupts();
+	rcv_character_consumed();
 
 	//printf("Rx read %02x\n", rv);
 
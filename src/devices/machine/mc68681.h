@@ -26,6 +26,9 @@ public:
 	virtual void rcv_complete() override;    // Rx completed receiving byte
 	virtual void tra_complete() override;    // Tx completed sending byte
 	virtual void tra_callback() override;    // Tx send bit
+	virtual bool character_mode_ok() const override { return !(MR2 & 0xc0) && !m_tx_break; }
+	virtual void tra_character_started() override;
+	virtual bool rcv_character_ready() const override { return rx_enabled && (rx_fifo_num < MC68681_RX_FIFO_SIZE); }
 
 	uint8_t read_chan_reg(int reg);
 	void write_chan_reg(int reg, uint8_t data);
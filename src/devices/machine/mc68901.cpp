@@ -228,37 +228,137 @@ inline void mc68901_device::rx_error()
 	}
 }
 
-TIMER_CALLBACK_MEMBER(mc68901_device::timer_count)
+inline void mc68901_device::timer_underflow(int index, u64 count)
 {
-	if (m_tmc[param] == 0x01)
+	if (count & 1)
 	{
 		/* toggle timer output signal */
-		m_to[param] = !m_to[param];
+		m_to[index] = !m_to[index];
 
-		switch (param)
+		switch (index)
 		{
-		case TIMER_A:   m_out_tao_cb(m_to[param]);    break;
-		case TIMER_B:   m_out_tbo_cb(m_to[param]);    break;
-		case TIMER_C:   m_out_tco_cb(m_to[param]);    break;
-		case TIMER_D:   m_out_tdo_cb(m_to[param]);    break;
+		case TIMER_A:   m_out_tao_cb(m_to[index]);    break;
+		case TIMER_B:   m_out_tbo_cb(m_to[index]);    break;
+		case TIMER_C:   m_out_tco_cb(m_to[index]);    break;
+		case TIMER_D:   m_out_tdo_cb(m_to[index]);    break;
 		}
+	}
 
-		if (m_ier & INT_MASK_TIMER[param])
-		{
-			/* signal timer elapsed interrupt */
-			take_interrupt(INT_MASK_TIMER[param]);
-		}
+	if (m_ier & INT_MASK_TIMER[index])
+	{
+		/* signal timer elapsed interrupt */
+		take_interrupt(INT_MASK_TIMER[index]);
+	}
+}
+
+inline void mc68901_device::timer_count(int index)
+{
+	if (m_tmc[index] == 0x01)
+	{
+		timer_underflow(index, 1);
 
 		/* load main counter */
-		m_tmc[param] = m_tdr[param];
+		m_tmc[index] = m_tdr[index];
 	}
 	else
 	{
 		/* count down */
-		m_tmc[param]--;
+		m_tmc[index]--;
 	}
 }
 
+inline bool mc68901_device::timer_output_used(int index) const
+{
+	switch (index)
+	{
+	case TIMER_A:   return !m_out_tao_cb.isunset();
+	case TIMER_B:   return !m_out_tbo_cb.isunset();
+	case TIMER_C:   return !m_out_tco_cb.isunset();
+	case TIMER_D:   return !m_out_tdo_cb.isunset();
+	}
+	return false;
+}
+
+/*
+    The counters are not stepped on every prescaled clock. While a timer is
+    counting the timer clock, its counter is brought up to date from the
+    elapsed time whenever it is observed or its configuration changes, and
+    an emu_timer is only scheduled for the next underflow when that raises
+    an interrupt or drives a connected output.
+*/
+
+void mc68901_device::timer_start(int index, int divisor)
+{
+	timer_sync(index);
+
+	m_tdiv[index] = divisor;
+	m_tstart[index] = machine().time();
+	m_tticks[index] = 0;
+
+	timer_schedule(index);
+}
+
+void mc68901_device::timer_stop(int index)
+{
+	timer_sync(index);
+
+	m_tdiv[index] = 0;
+	m_timer[index]->adjust(attotime::never);
+}
+
+void mc68901_device::timer_sync(int index, bool expired)
+{
+	if (!m_tdiv[index] || !m_timer_clock)
+		return;
+
+	u64 const total = (machine().time() - m_tstart[index]).as_ticks(m_timer_clock) / m_tdiv[index];
+	u64 ticks = (total > m_tticks[index]) ? (total - m_tticks[index]) : 0;
+	u32 const first = m_tmc[index] ? m_tmc[index] : 0x100;
+
+	// an expired timer is due an underflow even if the tick conversion rounded down
+	if (expired && (ticks < first))
+		ticks = first;
+	if (!ticks)
+		return;
+	m_tticks[index] += ticks;
+
+	if (ticks < first)
+	{
+		/* count down */
+		m_tmc[index] -= u8(ticks);
+	}
+	else
+	{
+		/* reload the main counter on each underflow */
+		u32 const reload = m_tdr[index] ? m_tdr[index] : 0x100;
+		u64 const after = ticks - first;
+		m_tmc[index] = m_tdr[index] - u8(after % reload);
+		timer_underflow(index, 1 + (after / reload));
+	}
+
+	// anything already scheduled has been accounted for
+	timer_schedule(index);
+}
+
+void mc68901_device::timer_schedule(int index)
+{
+	if (!m_tdiv[index] || !m_timer_clock || (!(m_ier & INT_MASK_TIMER[index]) && !timer_output_used(index)))
+	{
+		m_timer[index]->adjust(attotime::never);
+		return;
+	}
+
+	u32 const first = m_tmc[index] ? m_tmc[index] : 0x100;
+	attotime const when = m_tstart[index] + attotime::from_ticks((m_tticks[index] + first) * m_tdiv[index], m_timer_clock);
+	attotime const now = machine().time();
+	m_timer[index]->adjust((when > now) ? (when - now) : attotime::zero, index);
+}
+
+TIMER_CALLBACK_MEMBER(mc68901_device::timer_expired)
+{
+	timer_sync(param, true);
+}
+
 
 inline void mc68901_device::timer_input(int index, int value)
 {
@@ -283,7 +383,10 @@ inline void mc68901_device::timer_input(int index, int value)
 	case TCR_TIMER_PULSE_64:
 	case TCR_TIMER_PULSE_100:
 	case TCR_TIMER_PULSE_200:
-		m_timer[index]->enable((value == aer));
+		if ((value == aer) && !m_tdiv[index])
+			timer_start(index, PRESCALER[cr & 0x07]);
+		else if ((value != aer) && m_tdiv[index])
+			timer_stop(index);
 
 		if (((m_ti[index] ^ aer) == 0) && ((value ^ aer) == 1))
 		{
@@ -391,10 +494,10 @@ mc68901_device::mc68901_device(const machine_config &mconfig, const char *tag, d
 void mc68901_device::device_start()
 {
 	/* create the timers */
-	m_timer[TIMER_A] = timer_alloc(FUNC(mc68901_device::timer_count), this);
-	m_timer[TIMER_B] = timer_alloc(FUNC(mc68901_device::timer_count), this);
-	m_timer[TIMER_C] = timer_alloc(FUNC(mc68901_device::timer_count), this);
-	m_timer[TIMER_D] = timer_alloc(FUNC(mc68901_device::timer_count), this);
+	m_timer[TIMER_A] = timer_alloc(FUNC(mc68901_device::timer_expired), this);
+	m_timer[TIMER_B] = timer_alloc(FUNC(mc68901_device::timer_expired), this);
+	m_timer[TIMER_C] = timer_alloc(FUNC(mc68901_device::timer_expired), this);
+	m_timer[TIMER_D] = timer_alloc(FUNC(mc68901_device::timer_expired), this);
 
 	/* register for state saving */
 	save_item(NAME(m_gpip));
@@ -411,6 +514,9 @@ void mc68901_device::device_start()
 	save_item(NAME(m_tdr));
 	save_item(NAME(m_tmc));
 	save_item(NAME(m_to));
+	save_item(NAME(m_tdiv));
+	save_item(NAME(m_tstart));
+	save_item(NAME(m_tticks));
 	save_item(NAME(m_ti));
 	save_item(NAME(m_scr));
 	save_item(NAME(m_scr_parity));
@@ -461,6 +567,8 @@ void mc68901_device::device_reset()
 	memset(m_tmc, 0, sizeof(m_tmc));
 	memset(m_ti, 0, sizeof(m_ti));
 	memset(m_to, 0, sizeof(m_to));
+	memset(m_tdiv, 0, sizeof(m_tdiv));
+	memset(m_tticks, 0, sizeof(m_tticks));
 
 	write(REGISTER_GPIP, 0);
 	write(REGISTER_AER, 0);
@@ -510,10 +618,10 @@ u8 mc68901_device::read(offs_t offset)
 	case REGISTER_TACR:  return m_tacr;
 	case REGISTER_TBCR:  return m_tbcr;
 	case REGISTER_TCDCR: return m_tcdcr;
-	case REGISTER_TADR:  return m_tmc[TIMER_A];
-	case REGISTER_TBDR:  return m_tmc[TIMER_B];
-	case REGISTER_TCDR:  return m_tmc[TIMER_C];
-	case REGISTER_TDDR:  return m_tmc[TIMER_D];
+	case REGISTER_TADR:  timer_sync(TIMER_A); return m_tmc[TIMER_A];
+	case REGISTER_TBDR:  timer_sync(TIMER_B); return m_tmc[TIMER_B];
+	case REGISTER_TCDR:  timer_sync(TIMER_C); return m_tmc[TIMER_C];
+	case REGISTER_TDDR:  timer_sync(TIMER_D); return m_tmc[TIMER_D];
 
 	case REGISTER_SCR:   return m_scr;
 	case REGISTER_UCR:   return m_ucr;
@@ -585,16 +693,24 @@ void mc68901_device::write(offs_t offset, u8 data)
 
 	case REGISTER_IERA:
 		LOG("MC68901 Interrupt Enable Register A : %x\n", data);
+		for (int index = TIMER_A; index <= TIMER_D; index++)
+			timer_sync(index);
 		m_ier = (data << 8) | (m_ier & 0xff);
 		m_ipr &= m_ier;
 		check_interrupts();
+		for (int index = TIMER_A; index <= TIMER_D; index++)
+			timer_schedule(index);
 		break;
 
 	case REGISTER_IERB:
 		LOG("MC68901 Interrupt Enable Register B : %x\n", data);
+		for (int index = TIMER_A; index <= TIMER_D; index++)
+			timer_sync(index);
 		m_ier = (m_ier & 0xff00) | data;
 		m_ipr &= m_ier;
 		check_interrupts();
+		for (int index = TIMER_A; index <= TIMER_D; index++)
+			timer_schedule(index);
 		break;
 
 	case REGISTER_IPRA:
@@ -657,7 +773,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 		{
 		case TCR_TIMER_STOPPED:
 			LOG("MC68901 Timer A Stopped\n");
-			m_timer[TIMER_A]->enable(false);
+			timer_stop(TIMER_A);
 			break;
 
 		case TCR_TIMER_DELAY_4:
@@ -670,13 +786,13 @@ void mc68901_device::write(offs_t offset, u8 data)
 			{
 				int divisor = PRESCALER[m_tacr & 0x07];
 				LOG("MC68901 Timer A Delay Mode : %u Prescale\n", divisor);
-				m_timer[TIMER_A]->adjust(attotime::from_hz(m_timer_clock / divisor), TIMER_A, attotime::from_hz(m_timer_clock / divisor));
+				timer_start(TIMER_A, divisor);
 			}
 			break;
 
 		case TCR_TIMER_EVENT:
 			LOG("MC68901 Timer A Event Count Mode\n");
-			m_timer[TIMER_A]->enable(false);
+			timer_stop(TIMER_A);
 			break;
 
 		case TCR_TIMER_PULSE_4:
@@ -687,7 +803,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 		case TCR_TIMER_PULSE_100:
 		case TCR_TIMER_PULSE_200:
 			LOG("MC68901 Timer A Pulse Width Mode\n");
-			m_timer[TIMER_A]->adjust(attotime::never);
+			if (m_ti[TIMER_A] == BIT(m_aer, GPIO_TIMER[TIMER_A]))
+				timer_start(TIMER_A, PRESCALER[m_tacr & 0x07]);
+			else
+				timer_stop(TIMER_A);
 			break;
 		}
 
@@ -708,7 +827,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 		{
 		case TCR_TIMER_STOPPED:
 			LOG("MC68901 Timer B Stopped\n");
-			m_timer[TIMER_B]->enable(false);
+			timer_stop(TIMER_B);
 			break;
 
 		case TCR_TIMER_DELAY_4:
@@ -721,13 +840,13 @@ void mc68901_device::write(offs_t offset, u8 data)
 			{
 				int divisor = PRESCALER[m_tbcr & 0x07];
 				LOG("MC68901 Timer B Delay Mode : %u Prescale\n", divisor);
-				m_timer[TIMER_B]->adjust(attotime::from_hz(m_timer_clock / divisor), TIMER_B, attotime::from_hz(m_timer_clock / divisor));
+				timer_start(TIMER_B, divisor);
 			}
 			break;
 
 		case TCR_TIMER_EVENT:
 			LOG("MC68901 Timer B Event Count Mode\n");
-			m_timer[TIMER_B]->enable(false);
+			timer_stop(TIMER_B);
 			break;
 
 		case TCR_TIMER_PULSE_4:
@@ -738,7 +857,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 		case TCR_TIMER_PULSE_100:
 		case TCR_TIMER_PULSE_200:
 			LOG("MC68901 Timer B Pulse Width Mode\n");
-			m_timer[TIMER_B]->adjust(attotime::never);
+			if (m_ti[TIMER_B] == BIT(m_aer, GPIO_TIMER[TIMER_B]))
+				timer_start(TIMER_B, PRESCALER[m_tbcr & 0x07]);
+			else
+				timer_stop(TIMER_B);
 			break;
 		}
 
@@ -759,7 +881,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 		{
 		case TCR_TIMER_STOPPED:
 			LOG("MC68901 Timer D Stopped\n");
-			m_timer[TIMER_D]->enable(false);
+			timer_stop(TIMER_D);
 			break;
 
 		case TCR_TIMER_DELAY_4:
@@ -772,7 +894,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 			{
 				int divisor = PRESCALER[m_tcdcr & 0x07];
 				LOG("MC68901 Timer D Delay Mode : %u Prescale\n", divisor);
-				m_timer[TIMER_D]->adjust(attotime::from_hz(m_timer_clock / divisor), TIMER_D, attotime::from_hz(m_timer_clock / divisor));
+				timer_start(TIMER_D, divisor);
 			}
 			break;
 		}
@@ -781,7 +903,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 		{
 		case TCR_TIMER_STOPPED:
 			LOG("MC68901 Timer C Stopped\n");
-			m_timer[TIMER_C]->enable(false);
+			timer_stop(TIMER_C);
 			break;
 
 		case TCR_TIMER_DELAY_4:
@@ -794,7 +916,7 @@ void mc68901_device::write(offs_t offset, u8 data)
 			{
 				int divisor = PRESCALER[(m_tcdcr >> 4) & 0x07];
 				LOG("MC68901 Timer C Delay Mode : %u Prescale\n", divisor);
-				m_timer[TIMER_C]->adjust(attotime::from_hz(m_timer_clock / divisor), TIMER_C, attotime::from_hz(m_timer_clock / divisor));
+				timer_start(TIMER_C, divisor);
 			}
 			break;
 		}
@@ -803,9 +925,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 	case REGISTER_TADR:
 		LOG("MC68901 Timer A Data Register : %x\n", data);
 
+		timer_sync(TIMER_A);
 		m_tdr[TIMER_A] = data;
 
-		if (!m_timer[TIMER_A]->enabled())
+		if (!m_tdiv[TIMER_A])
 		{
 			m_tmc[TIMER_A] = data;
 		}
@@ -814,9 +937,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 	case REGISTER_TBDR:
 		LOG("MC68901 Timer B Data Register : %x\n", data);
 
+		timer_sync(TIMER_B);
 		m_tdr[TIMER_B] = data;
 
-		if (!m_timer[TIMER_B]->enabled())
+		if (!m_tdiv[TIMER_B])
 		{
 			m_tmc[TIMER_B] = data;
 		}
@@ -825,9 +949,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 	case REGISTER_TCDR:
 		LOG("MC68901 Timer C Data Register : %x\n", data);
 
+		timer_sync(TIMER_C);
 		m_tdr[TIMER_C] = data;
 
-		if (!m_timer[TIMER_C]->enabled())
+		if (!m_tdiv[TIMER_C])
 		{
 			m_tmc[TIMER_C] = data;
 		}
@@ -836,9 +961,10 @@ void mc68901_device::write(offs_t offset, u8 data)
 	case REGISTER_TDDR:
 		LOG("MC68901 Timer D Data Register : %x\n", data);
 
+		timer_sync(TIMER_D);
 		m_tdr[TIMER_D] = data;
 
-		if (!m_timer[TIMER_D]->enabled())
+		if (!m_tdiv[TIMER_D])
 		{
 			m_tmc[TIMER_D] = data;
 		}
@@ -98,7 +98,14 @@ protected:
 	void tx_error();
 	void rx_buffer_full();
 	void rx_error();
-	TIMER_CALLBACK_MEMBER(timer_count);
+	void timer_count(int index);
+	void timer_underflow(int index, u64 count);
+	bool timer_output_used(int index) const;
+	void timer_start(int index, int divisor);
+	void timer_stop(int index);
+	void timer_sync(int index, bool expired = false);
+	void timer_schedule(int index);
+	TIMER_CALLBACK_MEMBER(timer_expired);
 	void timer_input(int index, int value);
 	void gpio_input(int bit, int state);
 	void gpio_output();
@@ -250,6 +257,9 @@ private:
 	u8 m_tmc[4];                    // timer main counters
 	int m_ti[4];                    // timer in latch
 	int m_to[4];                    // timer out latch
+	int m_tdiv[4];                  // prescaler while counting the timer clock, 0 otherwise
+	attotime m_tstart[4];           // time the timer clock started being counted
+	u64 m_tticks[4];                // prescaled ticks accounted for since then
 
 	// serial receiver state
 	u16 m_rframe;                   // receiver frame shift register
@@ -739,9 +739,9 @@ void upd765_family_device::dma_w(uint8_t data)
 	fifo_push(data, false);
 }
 
-void upd765_family_device::live_start(floppy_info &fi, int state)
+void upd765_family_device::live_start(floppy_info &fi, int state, const attotime &start)
 {
-	cur_live.tm = machine().time();
+	cur_live.tm = start.is_never() ? machine().time() : start;
 	cur_live.state = state;
 	cur_live.next_state = -1;
 	cur_live.fi = &fi;
@@ -1857,7 +1857,7 @@ void upd765_family_device::read_data_continue(floppy_info &fi)
 			fi.counter = 0;
 			fi.sub_state = SCAN_ID;
 			LOGSTATE("SEARCH_ADDRESS_MARK_HEADER\n");
-			live_start(fi, SEARCH_ADDRESS_MARK_HEADER);
+			live_start(fi, SEARCH_ADDRESS_MARK_HEADER, sector_search_start(fi));
 			return;
 
 		case SCAN_ID:
@@ -1886,7 +1886,7 @@ void upd765_family_device::read_data_continue(floppy_info &fi)
 						st2 |= ST2_WC;
 				}
 				LOGSTATE("SEARCH_ADDRESS_MARK_HEADER\n");
-				live_start(fi, SEARCH_ADDRESS_MARK_HEADER);
+				live_start(fi, SEARCH_ADDRESS_MARK_HEADER, sector_search_start(fi));
 				return;
 			}
 			st1 &= ~ST1_ND;
@@ -2761,6 +2761,55 @@ bool upd765_family_device::sector_matches() const
 		cur_live.idbuf[3] == command[5];
 }
 
+// When the drive can hand out the decoded headers of the current track,
+// work out where the header search of a read will stop (the wanted
+// sector or a header with a bad crc) and start the pll just ahead of it
+// instead of bit-walking every header in between.  The status bits the
+// skipped headers would have set are applied here.
+attotime upd765_family_device::sector_search_start(floppy_info &fi)
+{
+	attotime const now = machine().time();
+	if(!mfm || !fi.dev)
+		return now;
+
+	attotime const cell = attotime::from_hz(2*cur_rate);
+	auto const *headers = fi.dev->get_mfm_sector_headers(cell);
+	if(!headers || headers->empty())
+		return now;
+
+	// The search is abandoned on the second index pulse
+	attotime const limit = fi.counter ? fi.dev->time_next_index() : attotime::never;
+
+	std::vector<attotime> times(headers->size());
+	int first = 0;
+	for(int i = 0; i != int(headers->size()); i++) {
+		times[i] = fi.dev->position_next_time((*headers)[i].position, now);
+		if(times[i] < times[first])
+			first = i;
+	}
+
+	// Give the pll a few sync bytes to lock on
+	attotime const lead = cell * (16*8);
+	for(int n = 0; n != int(headers->size()); n++) {
+		int const i = (first + n) % headers->size();
+		const auto &hdr = (*headers)[i];
+		if(times[i] >= limit || times[i] - now < lead)
+			return now;
+		if(hdr.crc_ok && !std::equal(hdr.idbuf, hdr.idbuf + 4, &command[2]))
+			continue;
+
+		for(int j = 0; j != n; j++) {
+			u8 const cyl = (*headers)[(first + j) % headers->size()].idbuf[0];
+			if(cyl != command[2])
+				st2 |= cyl == 0xff ? ST2_WC|ST2_BC : ST2_WC;
+			st1 &= ~ST1_MA;
+			st1 |= ST1_ND;
+		}
+		return times[i] - lead;
+	}
+	return now;
+}
+
 upd765a_device::upd765a_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock) : upd765_family_device(mconfig, UPD765A, tag, owner, clock)
 {
 	has_dor = false;
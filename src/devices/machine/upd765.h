@@ -335,8 +335,9 @@ protected:
 	void general_continue(floppy_info &fi);
 	virtual void index_callback(floppy_image_device *floppy, int state);
 	bool sector_matches() const;
+	attotime sector_search_start(floppy_info &fi);
 
-	void live_start(floppy_info &fi, int live_state);
+	void live_start(floppy_info &fi, int live_state, const attotime &start = attotime::never);
 	void live_abort();
 	void checkpoint();
 	void rollback();
@@ -14,10 +14,11 @@ DEFINE_DEVICE_TYPE(AD1848, ad1848_device, "ad1848", "AD1848 16-bit SoundPort Ste
 
 ad1848_device::ad1848_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock) :
 	device_t(mconfig, AD1848, tag, owner, clock),
+	device_sound_interface(mconfig, *this),
 	m_irq_cb(*this),
 	m_drq_cb(*this),
-	m_ldac(*this, "ldac"),
-	m_rdac(*this, "rdac")
+	m_stream(nullptr),
+	m_timer(nullptr)
 {
 }
 
@@ -25,14 +26,17 @@ void ad1848_device::device_add_mconfig(machine_config &config)
 {
 	SPEAKER(config, "lspeaker").front_left();
 	SPEAKER(config, "rspeaker").front_right();
-	DAC_16BIT_R2R(config, m_ldac, 0).add_route(ALL_OUTPUTS, "lspeaker", 0.5); // unknown DAC
-	DAC_16BIT_R2R(config, m_rdac, 0).add_route(ALL_OUTPUTS, "rspeaker", 0.5); // unknown DAC
+	add_route(0, "lspeaker", 0.5);
+	add_route(1, "rspeaker", 0.5);
 }
 
 
 void ad1848_device::device_start()
 {
-	m_timer = timer_alloc(FUNC(ad1848_device::update_tick), this);
+	// the stream runs at the programmed sample rate and pulls a block at a time from the FIFO;
+	// the timer only paces DMA requests, one per sample period
+	m_stream = stream_alloc(0, 2, (24.576_MHz_XTAL / 3072).value());
+	m_timer = timer_alloc(FUNC(ad1848_device::drq_tick), this);
 
 	save_item(NAME(m_regs.idx));
 	save_item(NAME(m_addr));
@@ -44,6 +48,10 @@ void ad1848_device::device_start()
 	save_item(NAME(m_mce));
 	save_item(NAME(m_trd));
 	save_item(NAME(m_irq));
+	save_item(NAME(m_drq));
+	save_item(NAME(m_fifo));
+	save_item(NAME(m_fifo_head));
+	save_item(NAME(m_fifo_level));
 }
 
 void ad1848_device::device_reset()
@@ -55,6 +63,10 @@ void ad1848_device::device_reset()
 	m_samples = 0;
 	m_play = false;
 	m_irq = false;
+	m_drq = false;
+	m_fifo_head = 0;
+	m_fifo_level = 0;
+	m_timer->adjust(attotime::never);
 }
 
 uint8_t ad1848_device::read(offs_t offset)
@@ -66,7 +78,10 @@ uint8_t ad1848_device::read(offs_t offset)
 		case 1:
 			return m_regs.idx[m_addr];
 		case 2:
-			return m_stat | (m_irq ? 1 : 0);
+			// PRDY follows room in the FIFO
+			if(m_fifo_level >= FIFO_DEPTH)
+				m_stream->update();
+			return (m_stat & ~0x02) | ((m_play && (m_fifo_level < FIFO_DEPTH)) ? 0x02 : 0) | (m_irq ? 1 : 0);
 		case 3:
 			break; // capture
 	}
@@ -75,7 +90,6 @@ uint8_t ad1848_device::read(offs_t offset)
 
 void ad1848_device::write(offs_t offset, uint8_t data)
 {
-	static constexpr int div_factor[] = {3072, 1536, 896, 768, 448, 384, 512, 2560};
 	switch(offset)
 	{
 		case 0:
@@ -95,15 +109,17 @@ void ad1848_device::write(offs_t offset, uint8_t data)
 					m_regs.dform &= 0x7f;
 					break;
 				case 9:
-				{
 					m_play = (data & 1) ? true : false;
-					// FIXME: provide external configuration for XTAL1 (24.576 MHz) and XTAL2 (16.9344 MHz) inputs
-					attotime rate = m_play ? attotime::from_hz(((m_regs.dform & 1) ? 16.9344_MHz_XTAL : 24.576_MHz_XTAL)
-							/ div_factor[(m_regs.dform >> 1) & 7]) : attotime::never;
-					m_timer->adjust(rate, 0 , rate);
-					m_drq_cb(m_play ? ASSERT_LINE : CLEAR_LINE);
+					if(m_play)
+						start_playback();
+					else
+					{
+						m_stream->update();
+						m_fifo_level = 0;
+						m_sam_cnt = 0;
+					}
+					update_drq();
 					break;
-				}
 				case 14:
 					m_count = (m_regs.ubase << 8) | m_regs.lbase;
 					break;
@@ -114,9 +130,12 @@ void ad1848_device::write(offs_t offset, uint8_t data)
 			m_irq = false;
 			if(m_regs.iface & 1)
 				m_play = true;
+			update_drq();
 			break;
 		case 3:
-			break; // playback
+			// programmed I/O playback
+			playback_w(data);
+			break;
 	}
 }
 
@@ -128,61 +147,78 @@ uint8_t ad1848_device::dack_r()
 
 void ad1848_device::dack_w(uint8_t data)
 {
-	if(!m_play)
-		return;
-	m_samples = (m_samples << 8) | data;
-	m_sam_cnt++;
-	switch(m_regs.dform >> 4)
-	{
-		case 0:
-		case 2:
-		case 6:
-			m_sam_cnt = 0;
-			break;
-		case 1:
-		case 3:
-		case 4:
-		case 7:
-			if(m_sam_cnt == 2)
-				m_sam_cnt = 0;
-			break;
-		case 5:
-			if(m_sam_cnt == 4)
-				m_sam_cnt = 0;
-			break;
-	}
-	if(!m_sam_cnt)
-		m_drq_cb(CLEAR_LINE);
+	playback_w(data);
+}
+
+void ad1848_device::start_playback()
+{
+	// FIXME: provide external configuration for XTAL1 (24.576 MHz) and XTAL2 (16.9344 MHz) inputs
+	static constexpr int div_factor[] = {3072, 1536, 896, 768, 448, 384, 512, 2560};
+	XTAL const xtal = (m_regs.dform & 1) ? 16.9344_MHz_XTAL : 24.576_MHz_XTAL;
+	m_stream->set_sample_rate((xtal / div_factor[(m_regs.dform >> 1) & 7]).value());
+	m_fifo_level = 0;
+	m_sam_cnt = 0;
+	m_timer->adjust(attotime::never);
 }
 
-TIMER_CALLBACK_MEMBER(ad1848_device::update_tick)
+void ad1848_device::playback_w(uint8_t data)
 {
 	if(!m_play)
 		return;
+	m_samples = (m_samples << 8) | data;
+	m_sam_cnt++;
 	switch(m_regs.dform >> 4)
 	{
 		case 0: // 8bit mono
-			m_ldac->write(m_samples << 8);
-			m_rdac->write(m_samples << 8);
+			fifo_push((data - 0x80) * 256, (data - 0x80) * 256);
 			break;
 		case 1: // 8bit stereo
-			m_ldac->write(m_samples << 8);
-			m_rdac->write(m_samples & 0xff00);
+			if(m_sam_cnt == 2)
+				fifo_push((int(m_samples & 0xff) - 0x80) * 256, (int((m_samples >> 8) & 0xff) - 0x80) * 256);
 			break;
 		case 2: // ulaw mono
+			fifo_push(ulaw_to_linear(data), ulaw_to_linear(data));
+			break;
 		case 3: // ulaw stereo
-		case 6: // alaw mono
-		case 7: // alaw stereo
+			if(m_sam_cnt == 2)
+				fifo_push(ulaw_to_linear(m_samples & 0xff), ulaw_to_linear((m_samples >> 8) & 0xff));
 			break;
 		case 4: // 16bit mono
-			m_ldac->write(m_samples ^ 0x8000);
-			m_rdac->write(m_samples ^ 0x8000);
+			if(m_sam_cnt == 2)
+				fifo_push(int16_t(m_samples & 0xffff), int16_t(m_samples & 0xffff));
 			break;
 		case 5: // 16bit stereo
-			m_ldac->write(m_samples ^ 0x8000);
-			m_rdac->write((m_samples >> 16) ^ 0x8000);
+			if(m_sam_cnt == 4)
+				fifo_push(int16_t(m_samples & 0xffff), int16_t(m_samples >> 16));
+			break;
+		case 6: // alaw mono
+			fifo_push(alaw_to_linear(data), alaw_to_linear(data));
+			break;
+		case 7: // alaw stereo
+			if(m_sam_cnt == 2)
+				fifo_push(alaw_to_linear(m_samples & 0xff), alaw_to_linear((m_samples >> 8) & 0xff));
 			break;
 	}
+}
+
+void ad1848_device::fifo_push(int16_t left, int16_t right)
+{
+	m_sam_cnt = 0;
+
+	// bring the stream up to date so the FIFO level reflects what has actually been played
+	if(m_fifo_level >= FIFO_DEPTH)
+		m_stream->update();
+	if(m_fifo_level < FIFO_DEPTH)
+	{
+		unsigned const tail = (m_fifo_head + m_fifo_level) % FIFO_DEPTH;
+		m_fifo[tail][0] = left;
+		m_fifo[tail][1] = right;
+		m_fifo_level++;
+	}
+	else
+		logerror("playback FIFO overrun\n");
+
+	// the count runs down as samples are transferred, as on the real chip
 	if(!m_count)
 	{
 		if(m_regs.pinc & 2)
@@ -196,5 +232,76 @@ TIMER_CALLBACK_MEMBER(ad1848_device::update_tick)
 	}
 	else
 		m_count--;
-	m_drq_cb(ASSERT_LINE);
+
+	// the request for this sample period has been met
+	if(m_drq)
+	{
+		m_drq = false;
+		m_drq_cb(CLEAR_LINE);
+	}
+	update_drq();
+}
+
+void ad1848_device::update_drq()
+{
+	// while playing, a request goes out once per sample period as on the real chip
+	if(m_play)
+	{
+		if(!m_timer->enabled())
+		{
+			attotime const period = attotime::from_hz(m_stream->sample_rate());
+			m_timer->adjust(period, 0, period);
+		}
+	}
+	else
+	{
+		m_timer->adjust(attotime::never);
+		if(m_drq)
+		{
+			m_drq = false;
+			m_drq_cb(CLEAR_LINE);
+		}
+	}
+}
+
+TIMER_CALLBACK_MEMBER(ad1848_device::drq_tick)
+{
+	// a request still pending from the last period just stays asserted
+	if(m_play && !m_drq)
+	{
+		m_drq = true;
+		m_drq_cb(ASSERT_LINE);
+	}
+}
+
+void ad1848_device::sound_stream_update(sound_stream &stream, std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs)
+{
+	// play out whatever has been transferred, with silence on underrun
+	int sampindex;
+	for(sampindex = 0; (sampindex < outputs[0].samples()) && m_fifo_level; sampindex++)
+	{
+		outputs[0].put_int(sampindex, m_fifo[m_fifo_head][0], 32768);
+		outputs[1].put_int(sampindex, m_fifo[m_fifo_head][1], 32768);
+		m_fifo_head = (m_fifo_head + 1) % FIFO_DEPTH;
+		m_fifo_level--;
+	}
+	outputs[0].fill(0, sampindex);
+	outputs[1].fill(0, sampindex);
+}
+
+int16_t ad1848_device::ulaw_to_linear(uint8_t data)
+{
+	data = ~data;
+	int const magnitude = ((((data & 0x0f) << 3) + 0x84) << ((data >> 4) & 7)) - 0x84;
+	return (data & 0x80) ? -magnitude : magnitude;
+}
+
+int16_t ad1848_device::alaw_to_linear(uint8_t data)
+{
+	data ^= 0x55;
+	int const exponent = (data >> 4) & 7;
+	int magnitude = ((data & 0x0f) << 4) + 8;
+	if(exponent)
+		magnitude = (magnitude + 0x100) << (exponent - 1);
+	return (data & 0x80) ? magnitude : -magnitude;
 }
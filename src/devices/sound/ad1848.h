@@ -5,10 +5,7 @@
 
 #pragma once
 
-#include "sound/dac.h"
-
-
-class ad1848_device : public device_t
+class ad1848_device : public device_t, public device_sound_interface
 {
 public:
 	ad1848_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
@@ -26,7 +23,9 @@ protected:
 	virtual void device_reset() override;
 	virtual void device_add_mconfig(machine_config &config) override;
 
-	TIMER_CALLBACK_MEMBER(update_tick);
+	virtual void sound_stream_update(sound_stream &stream, std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs) override;
+
+	TIMER_CALLBACK_MEMBER(drq_tick);
 
 private:
 	union {
@@ -50,16 +49,28 @@ private:
 		};
 		uint8_t idx[15];
 	} m_regs;
+	// playback FIFO, refilled by DMA a sample at a time and drained by the stream a block at a time
+	static constexpr unsigned FIFO_DEPTH = 32;
+
+	void playback_w(uint8_t data);
+	void fifo_push(int16_t left, int16_t right);
+	void update_drq();
+	void start_playback();
+	static int16_t ulaw_to_linear(uint8_t data);
+	static int16_t alaw_to_linear(uint8_t data);
+
 	uint8_t m_addr;
 	uint8_t m_stat;
 	uint16_t m_count;
 	uint32_t m_samples;
 	uint8_t m_sam_cnt;
-	bool m_play, m_mce, m_trd, m_irq;
+	bool m_play, m_mce, m_trd, m_irq, m_drq;
+	int16_t m_fifo[FIFO_DEPTH][2];
+	uint8_t m_fifo_head;
+	uint8_t m_fifo_level;
 	devcb_write_line m_irq_cb;
 	devcb_write_line m_drq_cb;
-	required_device<dac_word_interface> m_ldac;
-	required_device<dac_word_interface> m_rdac;
+	sound_stream *m_stream;
 	emu_timer *m_timer;
 };
 
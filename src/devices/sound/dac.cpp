@@ -94,7 +94,7 @@ void dac_device_base::device_start()
 	int inputs = (m_specified_inputs_mask == 0) ? 0 : 2;
 
 	// large stream buffer to favour emu/sound.cpp resample quality
-	m_stream = stream_alloc(inputs, 1, 48000 * 32);
+	m_stream = stream_alloc(inputs, 1, 48000 * 32, STREAM_PARALLEL_SAFE);
 
 	// save data
 	save_item(NAME(m_curval));
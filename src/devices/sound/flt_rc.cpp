@@ -38,7 +38,7 @@ filter_rc_device::filter_rc_device(const machine_config &mconfig, const char *ta
 
 void filter_rc_device::device_start()
 {
-	m_stream = stream_alloc(1, 1, SAMPLE_RATE_OUTPUT_ADAPTIVE);
+	m_stream = stream_alloc(1, 1, SAMPLE_RATE_OUTPUT_ADAPTIVE, STREAM_PARALLEL_SAFE);
 	m_last_sample_rate = 0;
 
 	save_item(NAME(m_k));
@@ -229,7 +229,7 @@ void sn76496_base_device::device_start()
 	int sample_rate = clock()/2;
 	int gain;
 
-	m_sound = stream_alloc(0, (m_stereo? 2:1), sample_rate);
+	m_sound = stream_alloc(0, (m_stereo? 2:1), sample_rate, STREAM_PARALLEL_SAFE);
 
 	for (int i = 0; i < 4; i++) m_volume[i] = 0;
 
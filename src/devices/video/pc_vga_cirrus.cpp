@@ -162,6 +162,7 @@ void cirrus_gd5428_vga_device::ramdac_overlay_w(offs_t offset, u8 data)
 			break;
 		}
 		vga.dac.dirty=1;
+		lfb_invalidate();  // cursor colours
 		if (vga.dac.state==3)
 		{
 			vga.dac.state=0;
@@ -648,6 +649,12 @@ void cirrus_gd5428_vga_device::device_start()
 	m_chip_id = 0x98;  // GD5428 - Rev 0
 }
 
+void cirrus_gd5428_vga_device::device_post_load()
+{
+	svga_device::device_post_load();
+	lfb_invalidate();
+}
+
 void cirrus_gd5430_vga_device::device_start()
 {
 	cirrus_gd5428_vga_device::device_start();
@@ -686,10 +693,152 @@ void cirrus_gd5428_vga_device::device_reset()
 	m_hidden_dac_mode = 0;
 }
 
+bool cirrus_gd5428_vga_device::lfb_state::operator==(const lfb_state &rhs) const
+{
+	return (mode == rhs.mode) && (start == rhs.start) && (pitch == rhs.pitch) && (width == rhs.width) && (height == rhs.height)
+			&& (cursor_x == rhs.cursor_x) && (cursor_y == rhs.cursor_y) && (cursor_addr == rhs.cursor_addr) && (cursor_attr == rhs.cursor_attr);
+}
+
+void cirrus_gd5428_vga_device::lfb_convert_line(uint8_t cur_mode, const uint8_t *src, uint32_t *dest, int width)
+{
+	switch (cur_mode)
+	{
+	case RGB15_MODE:
+		for (int x = 0; x < width; x++, src += 2)
+		{
+			uint16_t const pix = src[0] | (src[1] << 8);
+			uint32_t const r = (pix & 0x7c00) >> 10;
+			uint32_t const g = (pix & 0x03e0) >> 5;
+			uint32_t const b = (pix & 0x001f) >> 0;
+			dest[x] = 0xff000000 | (((r << 3) | (r & 0x7)) << 16) | (((g << 3) | (g & 0x7)) << 8) | ((b << 3) | (b & 0x7));
+		}
+		break;
+	case RGB16_MODE:
+		for (int x = 0; x < width; x++, src += 2)
+		{
+			uint16_t const pix = src[0] | (src[1] << 8);
+			uint32_t const r = (pix & 0xf800) >> 11;
+			uint32_t const g = (pix & 0x07e0) >> 5;
+			uint32_t const b = (pix & 0x001f) >> 0;
+			dest[x] = 0xff000000 | (((r << 3) | (r & 0x7)) << 16) | (((g << 2) | (g & 0x3)) << 8) | ((b << 3) | (b & 0x7));
+		}
+		break;
+	case RGB24_MODE:
+		for (int x = 0; x < width; x++, src += 3)
+			dest[x] = 0xff000000 | (src[2] << 16) | (src[1] << 8) | src[0];
+		break;
+	case RGB32_MODE:
+		for (int x = 0; x < width; x++, src += 4)
+			dest[x] = 0xff000000 | (src[2] << 16) | (src[1] << 8) | src[0];
+		break;
+	}
+}
+
+// Direct colour modes read VRAM as a plain linear framebuffer, so rather than
+// walking it a character cell at a time every frame, convert only the rows
+// written since the last update into m_lfb_bitmap (or, for 32bpp on a
+// little-endian host, copy straight out of VRAM since the layout already
+// matches bitmap_rgb32) and tell the screen when nothing changed at all.
+bool cirrus_gd5428_vga_device::lfb_screen_update(uint8_t cur_mode, bitmap_rgb32 &bitmap, const rectangle &cliprect, uint32_t &flags)
+{
+	int bytes_per_pixel;
+	switch (cur_mode)
+	{
+	case RGB15_MODE:
+	case RGB16_MODE: bytes_per_pixel = 2; break;
+	case RGB24_MODE: bytes_per_pixel = 3; break;
+	case RGB32_MODE: bytes_per_pixel = 4; break;
+	default:         return false;
+	}
+
+	// scan doubled modes are left to the generic renderer
+	if ((vga.crtc.maximum_scan_line * (vga.crtc.scan_doubling + 1)) != 1)
+		return false;
+
+	rectangle const &visarea = screen().visible_area();
+	lfb_state state;
+	state.mode = cur_mode;
+	state.start = vga.crtc.start_addr << ((cur_mode == RGB24_MODE) ? 3 : 2);
+	state.pitch = offset();
+	state.width = std::min<int>((vga.crtc.horz_disp_end + 1) * 8, visarea.right() + 1);
+	state.height = std::min<int>((vga.crtc.vert_disp_end + 1) * (get_interlace_mode() + 1), visarea.bottom() + 1);
+	state.cursor_x = m_cursor_x;
+	state.cursor_y = m_cursor_y;
+	state.cursor_addr = m_cursor_addr;
+	state.cursor_attr = m_cursor_attr;
+	if ((state.width <= 0) || (state.height <= 0) || !state.pitch)
+		return false;
+
+	// so is anything that wraps around the end of VRAM
+	uint64_t const end = state.start + (uint64_t(state.height - 1) * state.pitch) + (uint64_t(state.width) * bytes_per_pixel);
+	if (end >= vga.svga_intf.vram_size)
+		return false;
+
+	if (!(state == m_lfb_state))
+	{
+		m_lfb_state = state;
+		lfb_invalidate();
+	}
+
+	// if nothing was written and this is a whole frame, the last one still stands
+	bool const dirty = m_lfb_dirty_start < m_lfb_dirty_end;
+	if (!dirty && (cliprect == visarea))
+	{
+		flags |= UPDATE_HAS_NOT_CHANGED;
+		return true;
+	}
+
+	rectangle clip(0, state.width - 1, 0, state.height - 1);
+	clip &= cliprect;
+
+#ifdef LSB_FIRST
+	bool const passthrough = cur_mode == RGB32_MODE;
+#else
+	bool const passthrough = false;
+#endif
+	if (passthrough)
+	{
+		for (int y = clip.top(); y <= clip.bottom(); y++)
+			memcpy(&bitmap.pix(y, clip.left()), &vga.memory[state.start + (y * state.pitch) + (clip.left() * 4)], clip.width() * 4);
+	}
+	else
+	{
+		// bring every dirty row of the frame up to date so partial updates can share the work
+		if ((m_lfb_bitmap.width() < state.width) || (m_lfb_bitmap.height() < state.height))
+		{
+			m_lfb_bitmap.allocate(state.width, state.height);
+			lfb_invalidate();
+		}
+		int64_t const dirty_start = int64_t(m_lfb_dirty_start) - state.start;
+		int64_t const dirty_end = int64_t(m_lfb_dirty_end) - state.start;
+		if ((m_lfb_dirty_start < m_lfb_dirty_end) && (dirty_end > 0) && (dirty_start < int64_t(end - state.start)))
+		{
+			int const first = std::max<int64_t>(dirty_start, 0) / state.pitch;
+			int const last = std::min<int64_t>((dirty_end - 1) / state.pitch, state.height - 1);
+			for (int y = first; y <= last; y++)
+				lfb_convert_line(cur_mode, &vga.memory[state.start + (y * state.pitch)], &m_lfb_bitmap.pix(y), state.width);
+		}
+		copybitmap(bitmap, m_lfb_bitmap, 0, 0, 0, 0, clip);
+	}
+
+	m_lfb_dirty_start = ~offs_t(0);
+	m_lfb_dirty_end = 0;
+	return true;
+}
+
 uint32_t cirrus_gd5428_vga_device::screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	uint32_t ptr = (vga.svga_intf.vram_size - 0x4000);  // cursor patterns are stored in the last 16kB of VRAM
-	svga_device::screen_update(screen, bitmap, cliprect);
+	uint32_t flags = 0;
+	if (!lfb_screen_update(pc_vga_choosevideomode(), bitmap, cliprect, flags))
+	{
+		m_lfb_state = lfb_state();
+		svga_device::screen_update(screen, bitmap, cliprect);
+	}
+	else if (flags & UPDATE_HAS_NOT_CHANGED)
+	{
+		return flags;
+	}
 
 	if(m_cursor_attr & 0x01)  // hardware cursor enabled
 	{
@@ -1121,7 +1270,9 @@ void cirrus_gd5428_vga_device::copy_pixel(uint8_t src, uint8_t dst)
 			return;
 	}
 
-	vga.memory[m_blt_dest_current % vga.svga_intf.vram_size] = res;
+	offs_t const dest = m_blt_dest_current % vga.svga_intf.vram_size;
+	vga.memory[dest] = res;
+	lfb_mark_dirty(dest, dest + 1);
 }
 
 uint8_t cirrus_gd5428_vga_device::vga_latch_write(int offs, uint8_t data)
@@ -1287,8 +1438,17 @@ uint8_t cirrus_gd5428_vga_device::mem_r(offs_t offset)
 	}
 }
 
+void cirrus_gd5428_vga_device::mem_linear_w(offs_t offset, uint8_t data)
+{
+	svga_device::mem_linear_w(offset, data);
+	offset %= vga.svga_intf.vram_size;
+	lfb_mark_dirty(offset, offset + 1);
+}
+
 void cirrus_gd5428_vga_device::mem_w(offs_t offset, uint8_t data)
 {
+	// banked writes can land anywhere in VRAM depending on mode
+	lfb_invalidate();
 	uint32_t addr;
 	uint8_t cur_mode = pc_vga_choosevideomode();
 
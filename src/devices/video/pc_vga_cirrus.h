@@ -20,6 +20,7 @@ public:
 
 	virtual uint8_t mem_r(offs_t offset) override;
 	virtual void mem_w(offs_t offset, uint8_t data) override;
+	virtual void mem_linear_w(offs_t offset, uint8_t data) override;
 
 	virtual uint32_t screen_update(screen_device &screen, bitmap_rgb32 &bitmap, const rectangle &cliprect) override;
 
@@ -29,6 +30,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 	virtual uint16_t offset() override;
 	virtual uint32_t latch_start_addr() override;
 
@@ -99,8 +101,35 @@ protected:
 	uint8_t offset_select(offs_t offset);
 
 private:
+	// state the linear framebuffer fast path depends on; any change forces a full redraw
+	struct lfb_state
+	{
+		uint8_t mode = SCREEN_OFF;
+		uint32_t start = 0;
+		uint32_t pitch = 0;
+		int width = 0;
+		int height = 0;
+		uint16_t cursor_x = 0;
+		uint16_t cursor_y = 0;
+		uint16_t cursor_addr = 0;
+		uint8_t cursor_attr = 0;
+
+		bool operator==(const lfb_state &rhs) const;
+	};
+
 	void cirrus_define_video_mode();
 
+	// linear framebuffer pass-through for direct colour modes
+	bool lfb_screen_update(uint8_t cur_mode, bitmap_rgb32 &bitmap, const rectangle &cliprect, uint32_t &flags);
+	void lfb_convert_line(uint8_t cur_mode, const uint8_t *src, uint32_t *dest, int width);
+	void lfb_mark_dirty(offs_t start, offs_t end) { m_lfb_dirty_start = std::min(m_lfb_dirty_start, start); m_lfb_dirty_end = std::max(m_lfb_dirty_end, end); }
+	void lfb_invalidate() { lfb_mark_dirty(0, ~offs_t(0)); }
+
+	lfb_state m_lfb_state;
+	bitmap_rgb32 m_lfb_bitmap;          // converted rows for formats that don't match bitmap_rgb32
+	offs_t m_lfb_dirty_start = 0;       // VRAM written since the last update, as a byte range
+	offs_t m_lfb_dirty_end = ~offs_t(0);
+
 	void start_bitblt();
 	void start_reverse_bitblt();
 	void start_system_bitblt();
@@ -1517,3 +1517,39 @@ offs_t debug_disasm_buffer::next_pc_wrap(offs_t pc, offs_t step) const
 {
 	return m_next_pc_wrap(pc, step);
 }
+
+const debug_disasm_cache::entry &debug_disasm_cache::disassemble(const debug_disasm_buffer &buffer, offs_t pc)
+{
+	// the bytes alone don't identify the result when the disassembler
+	// looks at CPU modes, so always decode afresh for those
+	if(buffer.state_dependent()) {
+		offs_t next_pc, size;
+		buffer.disassemble(pc, m_uncached.m_text, next_pc, size, m_uncached.m_info);
+		buffer.data_get(pc, size, true, m_uncached.m_opcodes);
+		buffer.data_get(pc, size, false, m_uncached.m_params);
+		return m_uncached;
+	}
+
+	auto found = m_entries.find(pc);
+	if(found != m_entries.end()) {
+		offs_t size = found->second.m_info & util::disasm_interface::LENGTHMASK;
+		buffer.data_get(pc, size, true, m_bytes);
+		if(m_bytes == found->second.m_opcodes) {
+			buffer.data_get(pc, size, false, m_bytes);
+			if(m_bytes == found->second.m_params)
+				return found->second;
+		}
+	} else {
+		// start over rather than track ages, the views only ever look at a small window
+		if(m_entries.size() >= MAX_ENTRIES)
+			m_entries.clear();
+		found = m_entries.emplace(pc, entry()).first;
+	}
+
+	entry &result = found->second;
+	offs_t next_pc, size;
+	buffer.disassemble(pc, result.m_text, next_pc, size, result.m_info);
+	buffer.data_get(pc, size, true, result.m_opcodes);
+	buffer.data_get(pc, size, false, result.m_params);
+	return result;
+}
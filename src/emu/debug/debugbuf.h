@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 class debug_disasm_buffer
 {
 public:
@@ -22,6 +24,8 @@ public:
 	offs_t next_pc(offs_t pc, offs_t step) const;
 	offs_t next_pc_wrap(offs_t pc, offs_t step) const;
 
+	bool state_dependent() const { return m_flags & util::disasm_interface::STATE_DEPENDENT; }
+
 private:
 	class debug_data_buffer : public util::disasm_interface::data_buffer
 	{
@@ -89,5 +93,32 @@ private:
 	offs_t m_page_mask, m_pc_mask;
 };
 
+// Cache of disassembled instructions for one device, shared by the
+// disassembly views and the tracer.  Entries are keyed by pc and
+// checked against the current opcode and parameter bytes on lookup,
+// so code modified since it was cached is disassembled again.
+
+class debug_disasm_cache
+{
+public:
+	struct entry
+	{
+		u32 m_info;
+		std::string m_text;
+		std::vector<u8> m_opcodes;
+		std::vector<u8> m_params;
+	};
+
+	const entry &disassemble(const debug_disasm_buffer &buffer, offs_t pc);
+	void clear() { m_entries.clear(); }
+
+private:
+	static constexpr size_t MAX_ENTRIES = 1 << 18;
+
+	std::unordered_map<offs_t, entry> m_entries;
+	std::vector<u8> m_bytes;
+	entry m_uncached;
+};
+
 #endif
 
@@ -18,6 +18,7 @@
 #include "debugvw.h"
 #include "express.h"
 #include "points.h"
+#include "reverse.h"
 
 #include "debugger.h"
 #include "emuopts.h"
@@ -269,6 +270,11 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 
 	m_console.register_command("rewind",    CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rewind, this, _1));
 	m_console.register_command("rw",        CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_rewind, this, _1));
+	m_console.register_command("reverse",   CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_reverse, this, _1));
+	m_console.register_command("bstep",     CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_bstep, this, _1));
+	m_console.register_command("bs",        CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_bstep, this, _1));
+	m_console.register_command("bcontinue", CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_bcontinue, this, _1));
+	m_console.register_command("bc",        CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_bcontinue, this, _1));
 
 	m_console.register_command("save",      CMDFLAG_NONE, 3, 3, std::bind(&debugger_commands::execute_save, this, -1, _1));
 	m_console.register_command("saved",     CMDFLAG_NONE, 3, 3, std::bind(&debugger_commands::execute_save, this, AS_DATA, _1));
@@ -2001,6 +2007,74 @@ void debugger_commands::execute_rewind(const std::vector<std::string_view> &para
 }
 
 
+/*-------------------------------------------------
+    execute_reverse - execute the reverse command
+-------------------------------------------------*/
+
+void debugger_commands::execute_reverse(const std::vector<std::string_view> &params)
+{
+	debug_reverse &reverse = m_machine.debugger().cpu().reverse();
+
+	// with no parameters, describe the history
+	if (params.empty())
+	{
+		reverse.status();
+		return;
+	}
+
+	bool enable = false;
+	if (!m_console.validate_boolean_parameter(params[0], enable))
+		return;
+
+	if (!enable)
+	{
+		reverse.disable();
+		m_console.printf("Reverse execution disabled\n");
+		return;
+	}
+
+	u64 budget = 256;
+	if (params.size() > 1 && !m_console.validate_number_parameter(params[1], budget))
+		return;
+	if (budget == 0 || budget > 65536)
+	{
+		m_console.printf("Error: budget must be between 1 and 65536 MB\n");
+		return;
+	}
+
+	if (reverse.enable(size_t(budget) << 20))
+		m_console.printf("Reverse execution enabled with a budget of %u MB\n", budget);
+}
+
+
+/*-------------------------------------------------
+    execute_bstep - execute the bstep command
+-------------------------------------------------*/
+
+void debugger_commands::execute_bstep(const std::vector<std::string_view> &params)
+{
+	/* if we have a parameter, use it */
+	u64 steps = 1;
+	if (params.size() > 0 && !m_console.validate_number_parameter(params[0], steps))
+		return;
+	if (steps == 0)
+		return;
+
+	m_machine.debugger().cpu().reverse().step_back(*m_console.get_visible_cpu(), steps);
+}
+
+
+/*-------------------------------------------------
+    execute_bcontinue - execute the bcontinue
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_bcontinue(const std::vector<std::string_view> &params)
+{
+	m_machine.debugger().cpu().reverse().continue_back(*m_console.get_visible_cpu());
+}
+
+
 /*-------------------------------------------------
     execute_save - execute the save command
 -------------------------------------------------*/
@@ -2238,6 +2312,7 @@ void debugger_commands::execute_load(int spacenum, const std::vector<std::string
 		}
 		break;
 	}
+	m_machine.debugger().cpu().reverse().machine_changed();
 
 	if (!f.good())
 		m_console.printf("I/O error, load failed\n");
@@ -2291,6 +2366,7 @@ void debugger_commands::execute_loadregion(const std::vector<std::string_view> &
 		length = size;
 
 	fread(region->base() + offset, 1, length, f);
+	m_machine.debugger().cpu().reverse().machine_changed();
 
 	fclose(f);
 	m_console.printf("Data loaded successfully to memory : 0x%X to 0x%X\n", offset, offset + length - 1);
@@ -3369,6 +3445,7 @@ void debugger_commands::execute_fill(int spacenum, const std::vector<std::string
 				count -= fill_data_size[j];
 		}
 	}
+	m_machine.debugger().cpu().reverse().machine_changed();
 }
 
 
@@ -3480,6 +3557,8 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	std::string_view action;
 	bool detect_loops = true;
 	bool logerror = false;
+	bool binary = false;
+	bool registers = false;
 	std::string filename(params[0]);
 
 	// replace macros
@@ -3502,6 +3581,10 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 				detect_loops = false;
 			else if (util::streqlower(flag, "logerror"sv))
 				logerror = true;
+			else if (util::streqlower(flag, "binary"sv))
+				binary = true;
+			else if (util::streqlower(flag, "regs"sv))
+				registers = true;
 			else
 			{
 				m_console.printf("Invalid flag '%s'\n", flag);
@@ -3511,6 +3594,11 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	}
 	if (params.size() > 3 && !m_console.validate_command_parameter(action = params[3]))
 		return;
+	if (registers && !binary)
+	{
+		m_console.printf("The 'regs' flag requires 'binary'\n");
+		return;
+	}
 
 	// open the file
 	std::unique_ptr<std::ofstream> f;
@@ -3518,10 +3606,17 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	if (!util::streqlower(filename, "off"sv))
 	{
 		std::ios_base::openmode mode = std::ios_base::out;
+		if (binary)
+			mode |= std::ios_base::binary;
 
 		// opening for append?
 		if ((filename[0] == '>') && (filename[1] == '>'))
 		{
+			if (binary)
+			{
+				m_console.printf("Binary traces cannot be appended to\n");
+				return;
+			}
 			mode |= std::ios_base::ate;
 			filename = filename.substr(2);
 		}
@@ -3538,7 +3633,7 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 
 	// do it
 	bool const on(f);
-	cpu->debug()->trace(std::move(f), trace_over, detect_loops, logerror, action);
+	cpu->debug()->trace(std::move(f), trace_over, detect_loops, logerror, action, binary, registers);
 	if (on)
 		m_console.printf("Tracing CPU '%s' to file %s\n", cpu->tag(), filename);
 	else
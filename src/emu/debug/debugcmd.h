@@ -129,6 +129,9 @@ private:
 	void execute_statesave(const std::vector<std::string_view> &params);
 	void execute_stateload(const std::vector<std::string_view> &params);
 	void execute_rewind(const std::vector<std::string_view> &params);
+	void execute_reverse(const std::vector<std::string_view> &params);
+	void execute_bstep(const std::vector<std::string_view> &params);
+	void execute_bcontinue(const std::vector<std::string_view> &params);
 	void execute_save(int spacenum, const std::vector<std::string_view> &params);
 	void execute_saveregion(const std::vector<std::string_view> &params);
 	void execute_load(int spacenum, const std::vector<std::string_view> &params);
@@ -14,6 +14,7 @@
 
 #include "express.h"
 #include "points.h"
+#include "reverse.h"
 #include "debugcon.h"
 #include "debugvw.h"
 
@@ -25,6 +26,7 @@
 #include "uiinput.h"
 
 #include "corestr.h"
+#include "disasmtrace.h"
 #include "osdepend.h"
 #include "xmlfile.h"
 
@@ -58,7 +60,10 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 
 	/* create a global symbol table */
 	m_symtable = std::make_unique<symbol_table>(machine);
-	m_symtable->set_memory_modified_func([this]() { set_memory_modified(true); });
+	m_symtable->set_memory_modified_func([this]() { set_memory_modified(true); m_reverse->machine_changed(); });
+
+	/* create the reverse execution engine */
+	m_reverse = std::make_unique<debug_reverse>(machine);
 
 	/* add "wpaddr", "wpdata", "wpsize" to the global symbol table */
 	m_symtable->add("wpaddr", symbol_table::READ_ONLY, &m_wpaddr);
@@ -99,6 +104,11 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 }
 
 
+debugger_cpu::~debugger_cpu()
+{
+}
+
+
 /*-------------------------------------------------
     flush_traces - flushes all traces; this is
     useful if a trace is going on when we
@@ -435,6 +445,7 @@ device_debug::device_debug(device_t &device)
 	, m_endexectime(attotime::zero)
 	, m_total_cycles(0)
 	, m_last_total_cycles(0)
+	, m_instructions(0)
 	, m_pc_history_index(0)
 	, m_pc_history_valid(0)
 	, m_bplist()
@@ -457,6 +468,8 @@ device_debug::device_debug(device_t &device)
 	device.interface(m_memory);
 	device.interface(m_state);
 	device.interface(m_disasm);
+	if (m_disasm)
+		m_disasm_cache = std::make_unique<debug_disasm_cache>();
 
 	// set up notifiers and clear the passthrough handlers
 	if (m_memory) {
@@ -465,7 +478,15 @@ device_debug::device_debug(device_t &device)
 		for (int i=0; i != count; i++)
 			if (m_memory->has_space(i)) {
 				address_space &space = m_memory->space(i);
-				m_notifiers.emplace_back(space.add_change_notifier([this, &space] (read_or_write mode) { reinstall(space, mode); }));
+				m_notifiers.emplace_back(space.add_change_notifier(
+						[this, &space] (read_or_write mode)
+						{
+							reinstall(space, mode);
+
+							// handlers moved, so cached code may no longer be what's mapped
+							if (m_disasm_cache)
+								m_disasm_cache->clear();
+						}));
 			}
 			else
 				m_notifiers.emplace_back();
@@ -513,12 +534,12 @@ device_debug::device_debug(device_t &device)
 			// TODO: floating point registers
 			if (!entry->is_float())
 			{
-				using namespace std::placeholders;
 				std::string tempstr(strmakelower(entry->symbol()));
+				device_state_entry *const state = entry.get();
 				m_symtable->add(
 						tempstr.c_str(),
-						std::bind(&device_state_entry::value, entry.get()),
-						entry->writeable() ? std::bind(&device_state_entry::set_value, entry.get(), _1) : symbol_table::setter_func(nullptr),
+						std::bind(&device_state_entry::value, state),
+						state->writeable() ? symbol_table::setter_func([this, state] (u64 value) { set_register(*state, value); }) : symbol_table::setter_func(nullptr),
 						entry->format_string());
 			}
 		}
@@ -710,8 +731,8 @@ void device_debug::exception_hook(int exception)
 		}
 	}
 
-	// see if any exception points match
-	if (!m_eplist.empty())
+	// see if any exception points match, unless reverse execution is replaying history
+	if (!m_eplist.empty() && !m_device.machine().debugger().cpu().reverse().active())
 	{
 		auto epitp = m_eplist.equal_range(exception);
 		for (auto epit = epitp.first; epit != epitp.second; ++epit)
@@ -785,6 +806,14 @@ void device_debug::instruction_hook(offs_t curpc)
 	// note that we are in the debugger code
 	debugcpu.set_within_instruction(true);
 
+	// count the instruction, and leave the rest to reverse execution while it replays history
+	m_instructions++;
+	if (debugcpu.reverse().enabled() && !debugcpu.reverse().instruction_hook(*this, curpc))
+	{
+		debugcpu.set_within_instruction(false);
+		return;
+	}
+
 	// update the history
 	m_pc_history[m_pc_history_index] = curpc;
 	m_pc_history_index = (m_pc_history_index + 1) % std::size(m_pc_history);
@@ -923,9 +952,10 @@ void device_debug::instruction_hook(offs_t curpc)
 				machine.osd().wait_for_debugger(m_device, firststop);
 			firststop = false;
 
-			// if something modified memory, update the screen
+			// if something modified memory, update the screen; the history no longer leads here
 			if (debugcpu.memory_modified())
 			{
+				debugcpu.reverse().machine_changed();
 				machine.debug_view().update_all(DVT_DISASSEMBLY);
 				machine.debug_view().update_all(DVT_STATE);
 				machine.debugger().refresh_display();
@@ -1195,6 +1225,24 @@ const debug_breakpoint *device_debug::breakpoint_find(offs_t address) const
 	return nullptr;
 }
 
+//-------------------------------------------------
+//  breakpoint_hit - find an enabled breakpoint at
+//  an address whose condition is satisfied,
+//  without taking any action
+//-------------------------------------------------
+
+const debug_breakpoint *device_debug::breakpoint_hit(offs_t pc)
+{
+	auto bpitp = m_bplist.equal_range(pc);
+	for (auto bpit = bpitp.first; bpit != bpitp.second; ++bpit)
+	{
+		if (bpit->second->hit(pc))
+			return bpit->second.get();
+	}
+
+	return nullptr;
+}
+
 //-------------------------------------------------
 //  breakpoint_set - set a new breakpoint,
 //  returning its index
@@ -1734,14 +1782,14 @@ u32 device_debug::compute_opcode_crc32(offs_t pc) const
 //  trace - trace execution of a given device
 //-------------------------------------------------
 
-void device_debug::trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action)
+void device_debug::trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers)
 {
 	// delete any existing tracers
 	m_trace = nullptr;
 
 	// if we have a new file, make a new tracer
 	if (file != nullptr)
-		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, detect_loops, logerror, action);
+		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, detect_loops, logerror, action, binary, registers);
 }
 
 
@@ -1776,6 +1824,10 @@ void device_debug::compute_debug_flags()
 	if (m_trace != nullptr)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
 
+	// reverse execution counts every instruction
+	if (debugcpu.reverse().enabled())
+		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
+
 	// if we are stopping at a particular time and that time is within the current timeslice, we need to be called
 	if ((m_flags & DEBUG_FLAG_STOP_TIME) && m_endexectime <= m_stoptime)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
@@ -1953,7 +2005,7 @@ void device_debug::breakpoint_check(offs_t pc)
 //  tracer - constructor
 //-------------------------------------------------
 
-device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action)
+device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers)
 	: m_debug(debug)
 	, m_file(std::move(file))
 	, m_action(action)
@@ -1963,8 +2015,17 @@ device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream>
 	, m_nextdex(0)
 	, m_trace_over(trace_over)
 	, m_trace_over_target(~0)
+	, m_binary(binary)
+	, m_registers(binary && registers && debug.m_state)
+	, m_last_cycles(debug.m_total_cycles)
 {
 	memset(m_history, 0, sizeof(m_history));
+
+	if (m_binary)
+	{
+		m_buffer.reserve(BINARY_BUFFER_SIZE + 0x1000);
+		binary_header();
+	}
 }
 
 
@@ -1975,6 +2036,8 @@ device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream>
 device_debug::tracer::~tracer()
 {
 	// make sure we close the file if we can
+	if (m_binary)
+		binary_flush();
 	m_file.reset();
 }
 
@@ -2011,7 +2074,12 @@ void device_debug::tracer::update(offs_t pc)
 
 		// if we just finished looping, indicate as much
 		if (m_loops != 0)
-			util::stream_format(*m_file, "\n   (loops for %d instructions)\n\n", m_loops);
+		{
+			if (m_binary)
+				binary_loops();
+			else
+				util::stream_format(*m_file, "\n   (loops for %d instructions)\n\n", m_loops);
+		}
 		m_loops = 0;
 	}
 
@@ -2019,14 +2087,20 @@ void device_debug::tracer::update(offs_t pc)
 	if (!m_action.empty())
 		m_debug.m_device.machine().debugger().console().execute_command(m_action, false);
 
+	// the disassembly is shared with the views, so loops only decode once
 	debug_disasm_buffer buffer(m_debug.device());
-	std::string instruction;
-	offs_t next_pc, size;
-	u32 dasmresult;
-	buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
-
-	// output the result
-	util::stream_format(*m_file, "%s: %s\n", buffer.pc_to_string(pc), instruction);
+	debug_disasm_cache::entry const &insn = m_debug.disasm_cache().disassemble(buffer, pc);
+	u32 const dasmresult = insn.m_info;
+	if (m_binary)
+	{
+		// record the raw instruction, disassembly is left to unidasm
+		binary_insn(pc, insn.m_opcodes);
+	}
+	else
+	{
+		// output the result
+		util::stream_format(*m_file, "%s: %s\n", buffer.pc_to_string(pc), insn.m_text);
+	}
 
 	// do we need to step the trace over this instruction?
 	if (m_trace_over && (dasmresult & util::disasm_interface::SUPPORTED) != 0 && (dasmresult & util::disasm_interface::STEP_OVER) != 0)
@@ -2044,7 +2118,8 @@ void device_debug::tracer::update(offs_t pc)
 	// log this PC
 	m_nextdex = (m_nextdex + 1) % TRACE_LOOPS;
 	m_history[m_nextdex] = pc;
-	m_file->flush();
+	if (!m_binary)
+		m_file->flush();
 }
 
 
@@ -2061,6 +2136,19 @@ void device_debug::tracer::interrupt_update(int irqline, offs_t pc)
 		m_trace_over_target = pc;
 	}
 
+	if (m_binary)
+	{
+		if (m_detect_loops && m_loops != 0)
+		{
+			binary_loops();
+			m_loops = 0;
+		}
+		m_buffer.push_back(util::disasm_trace::RECORD_IRQ);
+		binary_put<u32>(pc);
+		binary_put<s32>(irqline);
+		return;
+	}
+
 	// if we just finished looping, indicate as much
 	*m_file << "\n";
 	if (m_detect_loops && m_loops != 0)
@@ -2080,6 +2168,17 @@ void device_debug::tracer::interrupt_update(int irqline, offs_t pc)
 
 void device_debug::tracer::vprintf(util::format_argument_pack<char> const &args)
 {
+	if (m_binary)
+	{
+		std::string const text = util::string_format(args);
+		m_buffer.push_back(util::disasm_trace::RECORD_TEXT);
+		binary_put<u32>(text.size());
+		m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+		if (m_buffer.size() >= BINARY_BUFFER_SIZE)
+			binary_flush();
+		return;
+	}
+
 	// pass through to the file
 	util::stream_format(*m_file, args);
 	m_file->flush();
@@ -2093,10 +2192,134 @@ void device_debug::tracer::vprintf(util::format_argument_pack<char> const &args)
 
 void device_debug::tracer::flush()
 {
+	if (m_binary)
+		binary_flush();
 	m_file->flush();
 }
 
 
+//-------------------------------------------------
+//  binary_put - append a little-endian value to
+//  the binary record buffer
+//-------------------------------------------------
+
+template <typename T>
+void device_debug::tracer::binary_put(T value)
+{
+	for (int i = 0; i < sizeof(T); i++)
+		m_buffer.push_back(u8(u64(value) >> (8 * i)));
+}
+
+
+//-------------------------------------------------
+//  binary_header - write the binary trace header
+//  and pick the registers to track
+//-------------------------------------------------
+
+void device_debug::tracer::binary_header()
+{
+	m_buffer.insert(m_buffer.end(), std::begin(util::disasm_trace::MAGIC), std::end(util::disasm_trace::MAGIC));
+	m_buffer.push_back(m_registers ? util::disasm_trace::FLAG_REGISTERS : 0);
+
+	std::string_view const name = m_debug.device().shortname();
+	m_buffer.push_back(u8(std::min<size_t>(name.size(), 255)));
+	m_buffer.insert(m_buffer.end(), name.begin(), name.begin() + std::min<size_t>(name.size(), 255));
+
+	if (m_registers)
+	{
+		for (auto const &entry : m_debug.m_state->state_entries())
+			if (entry->visible() && !entry->divider())
+				m_reg_entries.push_back(entry.get());
+
+		binary_put<u16>(m_reg_entries.size());
+		for (auto const *entry : m_reg_entries)
+		{
+			std::string_view const symbol = entry->symbol();
+			m_buffer.push_back(u8(std::min<size_t>(symbol.size(), 255)));
+			m_buffer.insert(m_buffer.end(), symbol.begin(), symbol.begin() + std::min<size_t>(symbol.size(), 255));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  binary_insn - record an executed instruction
+//-------------------------------------------------
+
+void device_debug::tracer::binary_insn(offs_t pc, std::vector<u8> const &opcode)
+{
+	m_buffer.push_back(util::disasm_trace::RECORD_INSN);
+	binary_put<u32>(pc);
+
+	u64 cycles = m_debug.m_total_cycles - m_last_cycles;
+	m_last_cycles = m_debug.m_total_cycles;
+	do
+	{
+		u8 const byte = cycles & 0x7f;
+		cycles >>= 7;
+		m_buffer.push_back(byte | (cycles ? 0x80 : 0x00));
+	}
+	while (cycles);
+
+	size_t const length = std::min<size_t>(opcode.size(), 255);
+	m_buffer.push_back(u8(length));
+	m_buffer.insert(m_buffer.end(), opcode.begin(), opcode.begin() + length);
+
+	if (m_registers)
+	{
+		// the first record carries every register, later ones only changes
+		bool const all = m_reg_values.empty();
+		m_reg_values.resize(m_reg_entries.size());
+		size_t const countpos = m_buffer.size();
+		binary_put<u16>(0);
+		u16 changed = 0;
+		for (size_t i = 0; i < m_reg_entries.size(); i++)
+		{
+			u64 const value = m_reg_entries[i]->value();
+			if (all || value != m_reg_values[i])
+			{
+				m_reg_values[i] = value;
+				binary_put<u16>(i);
+				binary_put<u64>(value);
+				changed++;
+			}
+		}
+		m_buffer[countpos] = u8(changed);
+		m_buffer[countpos + 1] = u8(changed >> 8);
+	}
+
+	if (m_buffer.size() >= BINARY_BUFFER_SIZE)
+		binary_flush();
+}
+
+
+//-------------------------------------------------
+//  binary_loops - record the end of a detected
+//  loop
+//-------------------------------------------------
+
+void device_debug::tracer::binary_loops()
+{
+	m_buffer.push_back(util::disasm_trace::RECORD_LOOP);
+	binary_put<u32>(m_loops);
+}
+
+
+//-------------------------------------------------
+//  binary_flush - write out pending binary
+//  records
+//-------------------------------------------------
+
+void device_debug::tracer::binary_flush()
+{
+	if (!m_buffer.empty())
+	{
+		m_file->write(reinterpret_cast<const char *>(m_buffer.data()), m_buffer.size());
+		m_buffer.clear();
+	}
+}
+
+
 //-------------------------------------------------
 //  dasm_pc_tag - constructor
 //-------------------------------------------------
@@ -2134,6 +2357,22 @@ device_debug::dasm_comment::dasm_comment(offs_t address, u32 crc, const char *te
 }
 
 
+//-------------------------------------------------
+//  set_register - set a register from the
+//  debugger; the reverse execution history no
+//  longer leads here
+//-------------------------------------------------
+
+void device_debug::set_register(device_state_entry &entry, u64 value)
+{
+	entry.set_value(value);
+
+	debugger_cpu &debugcpu = m_device.machine().debugger().cpu();
+	debugcpu.set_memory_modified(true);
+	debugcpu.reverse().machine_changed();
+}
+
+
 //-------------------------------------------------
 //  dasm_comment - constructor
 //-------------------------------------------------
@@ -29,6 +29,11 @@ constexpr int COMMENT_VERSION       = 1;
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class debug_disasm_buffer;
+class debug_disasm_cache;
+class device_state_entry;
+
+
 // ======================> device_debug
 
 // [TODO] This whole thing is terrible.
@@ -88,6 +93,7 @@ public:
 	// breakpoints
 	const auto &breakpoint_list() const { return m_bplist; }
 	const debug_breakpoint *breakpoint_find(offs_t address) const;
+	const debug_breakpoint *breakpoint_hit(offs_t pc);
 	int breakpoint_set(offs_t address, const char *condition = nullptr, std::string_view action = {});
 	bool breakpoint_clear(int index);
 	void breakpoint_clear_all();
@@ -135,6 +141,13 @@ public:
 	// history
 	std::pair<offs_t, bool> history_pc(int index) const;
 
+	// instructions executed while the instruction hook was being called
+	u64 instruction_count() const { return m_instructions; }
+	void set_instruction_count(u64 count) { m_instructions = count; }
+
+	// disassembly cache shared by the views and the tracer
+	debug_disasm_cache &disasm_cache() { return *m_disasm_cache; }
+
 	// pc tracking
 	void set_track_pc(bool value);
 	bool track_pc_visited(offs_t pc) const;
@@ -149,7 +162,7 @@ public:
 	void track_mem_data_clear() { m_track_mem_set.clear(); }
 
 	// tracing
-	void trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+	void trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary = false, bool registers = false);
 	template <typename Format, typename... Params> void trace_printf(Format &&fmt, Params &&...args)
 	{
 		if (m_trace != nullptr)
@@ -169,6 +182,7 @@ private:
 
 	// internal helpers
 	void prepare_for_step_overout(offs_t pc);
+	void set_register(device_state_entry &entry, u64 value);
 	void errorlog_write_line(const char *line);
 
 	// breakpoint and watchpoint helpers
@@ -204,6 +218,7 @@ private:
 	attotime                m_endexectime;              // ending time of the current execution
 	u64                     m_total_cycles;             // current total cycles
 	u64                     m_last_total_cycles;        // last total cycles
+	u64                     m_instructions;             // instructions seen by the instruction hook
 
 	// history
 	offs_t                  m_pc_history[HISTORY_SIZE]; // history of recent PCs
@@ -223,7 +238,7 @@ private:
 	class tracer
 	{
 	public:
-		tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+		tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action, bool binary, bool registers);
 		~tracer();
 
 		void update(offs_t pc);
@@ -234,6 +249,13 @@ private:
 
 	private:
 		static const int TRACE_LOOPS = 64;
+		static const size_t BINARY_BUFFER_SIZE = 1 << 20;
+
+		void binary_header();
+		void binary_insn(offs_t pc, std::vector<u8> const &opcode);
+		void binary_loops();
+		void binary_flush();
+		template <typename T> void binary_put(T value);
 
 		device_debug &      m_debug;                    // reference to our owner
 		std::unique_ptr<std::ostream> m_file;           // tracing file for this CPU
@@ -247,8 +269,15 @@ private:
 		offs_t              m_trace_over_target;        // target for tracing over
 														//    (0 = not tracing over,
 														//    ~0 = not currently tracing over)
+		bool                m_binary;                   // write binary records instead of text
+		bool                m_registers;                // include register deltas in binary records
+		std::vector<u8>     m_buffer;                   // pending binary records
+		std::vector<const device_state_entry *> m_reg_entries; // registers to track
+		std::vector<u64>    m_reg_values;               // last recorded register values
+		u64                 m_last_cycles;              // total cycles at the previous instruction
 	};
 	std::unique_ptr<tracer>                m_trace;     // tracer state
+	std::unique_ptr<debug_disasm_cache>    m_disasm_cache; // decoded instructions by pc
 
 	std::vector<memory_passthrough_handler> m_phw;      // passthrough handler reference for each space, write mode
 	std::vector<util::notifier_subscription> m_notifiers; // notifiers for each space
@@ -353,6 +382,7 @@ public:
 	enum class exec_state { STOPPED, RUNNING };
 
 	debugger_cpu(running_machine &machine);
+	~debugger_cpu();
 
 	/* ----- initialization and cleanup ----- */
 
@@ -373,6 +403,12 @@ public:
 	symbol_table &global_symtable() { return *m_symtable; }
 
 
+	/* ----- reverse execution ----- */
+
+	/* return the reverse execution engine */
+	debug_reverse &reverse() { return *m_reverse; }
+
+
 	/* ----- debugger comment helpers ----- */
 
 	// save all comments for a given machine
@@ -422,6 +458,7 @@ private:
 	device_t *  m_breakcpu;
 
 	std::unique_ptr<symbol_table> m_symtable;           // global symbol table
+	std::unique_ptr<debug_reverse> m_reverse;           // reverse execution engine
 
 	bool        m_within_instruction_hook;
 	bool        m_vblank_occurred;
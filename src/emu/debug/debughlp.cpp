@@ -143,14 +143,17 @@ const help_item f_static_help_list[] =
 		"  gt[ime] <milliseconds> -- resumes execution until the given delay has elapsed\n"
 		"  gv[blank] -- resumes execution, setting temp breakpoint on the next VBLANK (F8)\n"
 		"  n[ext] -- executes until the next CPU switch (F6)\n"
+		"  reverse [<bool>[,<budget>]] -- enables or disables reverse execution, or shows its status\n"
+		"  bs[tep] [<count>=1] -- steps back <count> instructions on the current CPU\n"
+		"  bc[ontinue] -- runs backwards to the previous breakpoint or watchpoint hit\n"
 		"  focus <CPU> -- focuses debugger only on <CPU>\n"
 		"  ignore [<CPU>[,<CPU>[,...]]] -- stops debugging on <CPU>\n"
 		"  observe [<CPU>[,<CPU>[,...]]] -- resumes debugging on <CPU>\n"
 		"  suspend [<CPU>[,<CPU>[,...]]] -- suspends execution on <CPU>\n"
 		"  resume [<CPU>[,<CPU>[,...]]] -- resumes execution on <CPU>\n"
 		"  cpulist -- list all CPUs\n"
-		"  trace {<filename>|OFF}[,<CPU>[,<detectloops>[,<action>]]] -- trace the given CPU to a file (defaults to active CPU)\n"
-		"  traceover {<filename>|OFF}[,<CPU>[,<detectloops>[,<action>]]] -- trace the given CPU to a file, but skip subroutines (defaults to active CPU)\n"
+		"  trace {<filename>|OFF}[,<CPU>[,<flags>[,<action>]]] -- trace the given CPU to a file (defaults to active CPU)\n"
+		"  traceover {<filename>|OFF}[,<CPU>[,<flags>[,<action>]]] -- trace the given CPU to a file, but skip subroutines (defaults to active CPU)\n"
 		"  traceflush -- flushes all open trace files\n"
 	},
 	{
@@ -1095,6 +1098,65 @@ const help_item f_static_help_list[] =
 		"gv\n"
 		"  Resume execution until the next break/watchpoint or until the next VBLANK.\n"
 	},
+	{
+		"reverse",
+		"\n"
+		"  reverse [<bool>[,<budget>]]\n"
+		"\n"
+		"The reverse command enables or disables reverse execution, which lets the bstep and bcontinue "
+		"commands go backwards in time.  While enabled, the machine is saved to memory periodically and "
+		"every instruction executed by observed CPUs is counted; going backwards loads a saved state and "
+		"runs forwards again to the right instruction.  The optional <budget> is the memory in megabytes "
+		"the saved states may use (256 by default); once it is full, every other state is dropped and "
+		"states are saved half as often.  With no parameters, reverse shows how much history is "
+		"available.  Loading a state, resetting the machine or changing memory from the debugger "
+		"discards history that no longer leads to the current point.  Input from the host that differs "
+		"from the first time can make replay diverge.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"reverse true\n"
+		"  Enables reverse execution with the default budget.\n"
+		"\n"
+		"reverse true,#1024\n"
+		"  Enables reverse execution, allowing the saved states to use up to 1 GB.\n"
+		"\n"
+		"reverse\n"
+		"  Shows the number of saved states, the memory they use and how far back they go.\n"
+	},
+	{
+		"bstep",
+		"\n"
+		"  bs[tep] [<count>=1]\n"
+		"\n"
+		"The bstep command steps backwards one or more instructions on the currently executing CPU, "
+		"leaving the whole machine in the state it was in before those instructions executed.  Reverse "
+		"execution has to be enabled with the reverse command, and the history has to reach back far "
+		"enough.  Breakpoints and watchpoints are not triggered on the way.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"bs\n"
+		"  Steps back one instruction on the current CPU.\n"
+		"\n"
+		"bstep 4\n"
+		"  Steps back four instructions on the current CPU.\n"
+	},
+	{
+		"bcontinue",
+		"\n"
+		"  bc[ontinue]\n"
+		"\n"
+		"The bcontinue command runs backwards until the most recent point where a breakpoint or "
+		"watchpoint would have stopped execution, or to the start of the history if there is none.  "
+		"Breakpoint and watchpoint conditions are evaluated, but their actions are not run.  Reverse "
+		"execution has to be enabled with the reverse command.\n"
+		"\n"
+		"Example:\n"
+		"\n"
+		"bc\n"
+		"  Goes back to the previous breakpoint or watchpoint hit.\n"
+	},
 	{
 		"next",
 		"\n"
@@ -1169,7 +1231,7 @@ const help_item f_static_help_list[] =
 	{
 		"trace",
 		"\n"
-		"  trace {<filename>|off}[,<CPU>[,[noloop|logerror][,<action>]]]\n"
+		"  trace {<filename>|off}[,<CPU>[,[noloop|logerror|binary|regs][,<action>]]]\n"
 		"\n"
 		"Starts or stops tracing of the execution of the specified <CPU>, or the currently visible "
 		"CPU if no CPU is specified.  To enable tracing, specify the trace log file name in the "
@@ -1183,6 +1245,11 @@ const help_item f_static_help_list[] =
 		"will not be detected and every instruction will be logged as executed.  If the 'logerror' "
 		"flag is specified, error log output will be included in the trace log.\n"
 		"\n"
+		"The 'binary' flag writes compact binary records (PC, opcode bytes and cycles elapsed) "
+		"instead of disassembled text, which is much faster for long traces.  Adding 'regs' also "
+		"records the registers changed by each instruction.  Binary traces cannot be appended to; "
+		"render them to text with 'unidasm <file> -trace'.\n"
+		"\n"
 		"The optional <action> parameter is a debugger command to execute before each trace message "
 		"is logged.  Generally, this will include a 'tracelog' or 'tracesym' command to include "
 		"additional information in the trace log.  Note that you may need to embed the action "
@@ -1209,6 +1276,10 @@ const help_item f_static_help_list[] =
 		"  Begin tracing the execution of CPU #0, logging output (along with logerror output) to "
 		"starswep.tr, with loop detection disabled.\n"
 		"\n"
+		"trace boot.trb,maincpu,binary|regs\n"
+		"  Begin tracing the execution of the CPU ':maincpu' as binary records with register "
+		"changes, logging output to boot.trb.\n"
+		"\n"
 		"trace >>pigskin.tr\n"
 		"  Begin tracing execution of the currently visible CPU, appending log output to "
 		"pigskin.tr.\n"
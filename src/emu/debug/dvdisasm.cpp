@@ -222,18 +222,26 @@ void debug_view_disasm::view_click(const int button, const debug_view_xy& pos)
 	end_update();
 }
 
+//-------------------------------------------------
+//  decode_line - append the instruction at an
+//  address, taking it from the device's cache
+//  when the bytes there haven't changed, and
+//  return the address of the next one
+//-------------------------------------------------
+
+offs_t debug_view_disasm::decode_line(debug_disasm_buffer &buffer, offs_t address)
+{
+	debug_disasm_cache::entry const &insn = m_source->device()->debug()->disasm_cache().disassemble(buffer, address);
+	offs_t const size = insn.m_info & util::disasm_interface::LENGTHMASK;
+	m_dasm.emplace_back(address, size, insn.m_text);
+	return buffer.next_pc(address, size);
+}
+
 void debug_view_disasm::generate_from_address(debug_disasm_buffer &buffer, offs_t address)
 {
 	m_dasm.clear();
-	for(int i=0; i != m_total.y; i++) {
-		std::string dasm;
-		offs_t size;
-		offs_t next_address;
-		u32 info;
-		buffer.disassemble(address, dasm, next_address, size, info);
-		m_dasm.emplace_back(address, size, dasm);
-		address = next_address;
-	}
+	for(int i=0; i != m_total.y; i++)
+		address = decode_line(buffer, address);
 	m_recompute = false;
 }
 
@@ -262,12 +270,7 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 	if(intf.interface_flags() & util::disasm_interface::NONLINEAR_PC) {
 		offs_t lpc = intf.pc_real_to_linear(pc);
 		while(intf.pc_real_to_linear(address) < lpc) {
-			std::string dasm;
-			offs_t size;
-			offs_t next_address;
-			u32 info;
-			buffer.disassemble(address, dasm, next_address, size, info);
-			m_dasm.emplace_back(address, size, dasm);
+			offs_t next_address = decode_line(buffer, address);
 			if(intf.pc_real_to_linear(address) > intf.pc_real_to_linear(next_address))
 				return false;
 			address = next_address;
@@ -275,12 +278,7 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 
 	} else {
 		while(address < pc) {
-			std::string dasm;
-			offs_t size;
-			offs_t next_address;
-			u32 info;
-			buffer.disassemble(address, dasm, next_address, size, info);
-			m_dasm.emplace_back(address, size, dasm);
+			offs_t next_address = decode_line(buffer, address);
 			if(address > next_address)
 				return false;
 			address = next_address;
@@ -293,15 +291,8 @@ bool debug_view_disasm::generate_with_pc(debug_disasm_buffer &buffer, offs_t pc)
 	if(m_dasm.size() > m_backwards_steps)
 		m_dasm.erase(m_dasm.begin(), m_dasm.begin() + (m_dasm.size() - m_backwards_steps));
 
-	while(m_dasm.size() < m_total.y) {
-		std::string dasm;
-		offs_t size;
-		offs_t next_address;
-		u32 info;
-		buffer.disassemble(address, dasm, next_address, size, info);
-		m_dasm.emplace_back(address, size, dasm);
-		address = next_address;
-	}
+	while(m_dasm.size() < m_total.y)
+		address = decode_line(buffer, address);
 	return true;
 }
 
@@ -112,6 +112,7 @@ private:
 	};
 
 	// internal helpers
+	offs_t decode_line(debug_disasm_buffer &buffer, offs_t address);
 	void generate_from_address(debug_disasm_buffer &buffer, offs_t address);
 	bool generate_with_pc(debug_disasm_buffer &buffer, offs_t pc);
 	int address_position(offs_t pc) const;
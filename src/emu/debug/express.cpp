@@ -98,7 +98,12 @@ enum
 	TVL_ASSIGNBOR,
 	TVL_COMMA,
 	TVL_MEMORYAT,
-	TVL_EXECUTEFUNC
+	TVL_EXECUTEFUNC,
+
+	// pseudo-operators only used by compiled expressions
+	OP_PARAM,
+	OP_CALL,
+	OP_RESULT
 };
 
 
@@ -284,6 +289,20 @@ inline std::pair<device_t &, char const *> get_device_search(running_machine &ma
 	}
 }
 
+
+//-------------------------------------------------
+//  find_memory_interface - get a device's memory
+//  interface without needing RTTI for device_t
+//-------------------------------------------------
+
+inline device_memory_interface *find_memory_interface(device_t *device)
+{
+	device_memory_interface *memintf = nullptr;
+	if (device)
+		device->interface(memintf);
+	return memintf;
+}
+
 } // anonymous namespace
 
 
@@ -366,7 +385,7 @@ symbol_entry::~symbol_entry()
 symbol_table::symbol_table(running_machine &machine, symbol_table *parent, device_t *device)
 	: m_machine(machine)
 	, m_parent(parent)
-	, m_memintf(dynamic_cast<device_memory_interface *>(device))
+	, m_memintf(find_memory_interface(device))
 	, m_memory_modified(nullptr)
 {
 }
@@ -1037,10 +1056,9 @@ parsed_expression::parsed_expression(symbol_table &symtable, std::string_view ex
 parsed_expression::parsed_expression(const parsed_expression &src)
 	: m_symtable(src.m_symtable)
 	, m_default_base(src.m_default_base)
-	, m_original_string(src.m_original_string)
 {
-	if (!m_original_string.empty())
-		parse_string_into_tokens();
+	if (!src.m_original_string.empty())
+		parse(src.m_original_string);
 }
 
 
@@ -1060,6 +1078,13 @@ void parsed_expression::parse(std::string_view expression)
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// compile it if possible; otherwise the tokens are interpreted
+	if (!compile_tokens())
+	{
+		m_program.clear();
+		m_program_stack.clear();
+	}
 }
 
 
@@ -1069,11 +1094,18 @@ void parsed_expression::parse(std::string_view expression)
 
 void parsed_expression::copy(const parsed_expression &src)
 {
+	if (&src == this)
+		return;
+
 	m_symtable = src.m_symtable;
 	m_default_base = src.m_default_base;
-	m_original_string.assign(src.m_original_string);
-	if (!m_original_string.empty())
-		parse_string_into_tokens();
+	m_original_string.clear();
+	m_tokenlist.clear();
+	m_stringlist.clear();
+	m_program.clear();
+	m_program_stack.clear();
+	if (!src.m_original_string.empty())
+		parse(src.m_original_string);
 }
 
 
@@ -1264,7 +1296,7 @@ void parsed_expression::parse_string_into_tokens()
 				if (string[1] == '=')
 					string += 2, token.configure_operator(TVL_NOTEQUAL, 7);
 				else
-					string += 2, token.configure_operator(TVL_COMPLEMENT, 2);
+					string += 1, token.configure_operator(TVL_COMPLEMENT, 2);
 				break;
 
 			case '&':
@@ -2146,6 +2178,277 @@ u64 parsed_expression::execute_tokens()
 
 
 
+//-------------------------------------------------
+//  compile_tokens - turn the postfix token list
+//  into a flat program over a plain value stack;
+//  returns false if the expression can't be
+//  compiled (assignments, strings, or anything
+//  that would raise an error when executed), in
+//  which case the tokens are interpreted instead
+//-------------------------------------------------
+
+bool parsed_expression::compile_tokens()
+{
+	m_program.clear();
+
+	// simulate the token stack; symbols, numbers and memory references
+	// are only read when an operator consumes them, exactly as
+	// pop_token_rval does
+	struct stack_entry
+	{
+		compiled_operand operand;
+		int offset;
+	};
+	std::vector<stack_entry> stack;
+	int depth = 0, maxdepth = 0;
+	int offset1, offset2;
+
+	auto const pop = [&stack, &depth] (compiled_operand &operand, int &offset) -> bool
+	{
+		if (stack.empty())
+			return false;
+		operand = stack.back().operand;
+		offset = stack.back().offset;
+		stack.pop_back();
+		if (operand.source == SOURCE_SYMBOL && operand.symbol->is_function())
+			return false;
+		if (operand.source == SOURCE_STACK || operand.source == SOURCE_MEMORY)
+			depth--;
+		return true;
+	};
+	auto const push_result = [&stack, &depth, &maxdepth] (int offset) -> stack_entry &
+	{
+		stack_entry &entry = stack.emplace_back();
+		entry.operand.source = SOURCE_STACK;
+		entry.offset = offset;
+		maxdepth = std::max(maxdepth, ++depth);
+		return entry;
+	};
+
+	for (const parse_token &token : m_tokenlist)
+	{
+		// numbers and symbols don't generate any code
+		if (token.is_number() || token.is_symbol())
+		{
+			stack_entry &entry = stack.emplace_back();
+			if (token.is_number())
+			{
+				entry.operand.source = SOURCE_CONSTANT;
+				entry.operand.value = token.value();
+			}
+			else
+			{
+				entry.operand.source = SOURCE_SYMBOL;
+				entry.operand.symbol = &token.symbol();
+			}
+			entry.offset = token.offset();
+			continue;
+		}
+		if (!token.is_operator())
+			return false;
+
+		compiled_op op = { token.optype(), 0, token.offset() };
+		switch (token.optype())
+		{
+			case TVL_COMPLEMENT:
+			case TVL_NOT:
+			case TVL_UPLUS:
+			case TVL_UMINUS:
+				if (!pop(op.src[0], offset1))
+					return false;
+				m_program.push_back(op);
+				push_result(offset1);
+				break;
+
+			case TVL_MULTIPLY:
+			case TVL_DIVIDE:
+			case TVL_MODULO:
+			case TVL_ADD:
+			case TVL_SUBTRACT:
+			case TVL_LSHIFT:
+			case TVL_RSHIFT:
+			case TVL_LESS:
+			case TVL_LESSOREQUAL:
+			case TVL_GREATER:
+			case TVL_GREATEROREQUAL:
+			case TVL_EQUAL:
+			case TVL_NOTEQUAL:
+			case TVL_BAND:
+			case TVL_BXOR:
+			case TVL_BOR:
+			case TVL_LAND:
+			case TVL_LOR:
+				if (!pop(op.src[1], offset2) || !pop(op.src[0], offset1))
+					return false;
+				op.offset = offset2;
+				m_program.push_back(op);
+				push_result(std::min(offset1, offset2));
+				break;
+
+			case TVL_COMMA:
+				if (token.is_function_separator())
+					break;
+				if (!pop(op.src[1], offset2) || !pop(op.src[0], offset1))
+					return false;
+				m_program.push_back(op);
+				push_result(offset2);
+				break;
+
+			case TVL_MEMORYAT:
+			{
+				// the address stays on the stack until the reference is consumed
+				if (!pop(op.src[0], offset1))
+					return false;
+				m_program.push_back(op);
+				stack_entry &entry = push_result(offset1);
+				entry.operand.source = SOURCE_MEMORY;
+				entry.operand.memory = &token;
+				break;
+			}
+
+			case TVL_EXECUTEFUNC:
+			{
+				// parameters are popped down to the function symbol, last one first
+				int paramcount = 0;
+				while (stack.empty() || stack.back().operand.source != SOURCE_SYMBOL || !stack.back().operand.symbol->is_function())
+				{
+					compiled_op param = { OP_PARAM, u8(++paramcount), token.offset() };
+					if (paramcount == MAX_FUNCTION_PARAMS || !pop(param.src[0], offset1))
+						return false;
+					m_program.push_back(param);
+				}
+				function_symbol_entry *const function = downcast<function_symbol_entry *>(stack.back().operand.symbol);
+				stack.pop_back();
+				if (paramcount < function->minparams() || paramcount > function->maxparams())
+					return false;
+
+				op.opcode = OP_CALL;
+				op.param = paramcount;
+				op.src[0].symbol = function;
+				m_program.push_back(op);
+				push_result(token.offset());
+				break;
+			}
+
+			default:
+				// assignments and increments need lvals; leave them to the interpreter
+				return false;
+		}
+	}
+
+	// the final result must be the only thing left
+	compiled_op result = { OP_RESULT, 0, 0 };
+	if (!pop(result.src[0], offset1) || !stack.empty())
+		return false;
+	m_program.push_back(result);
+	m_program_stack.resize(std::max(maxdepth, 1));
+	return true;
+}
+
+
+//-------------------------------------------------
+//  fetch_operand - get the value of a compiled
+//  operand, popping it if it lives on the stack
+//-------------------------------------------------
+
+inline u64 parsed_expression::fetch_operand(const compiled_operand &src, u64 *&sp)
+{
+	switch (src.source)
+	{
+		case SOURCE_STACK:
+			return *--sp;
+
+		case SOURCE_SYMBOL:
+			return src.symbol->value();
+
+		case SOURCE_MEMORY:
+		{
+			const parse_token &token = *src.memory;
+			u32 const address = *--sp;
+			return m_symtable.get().memory_value(token.memory_source(), token.memory_space(), address, 1 << token.memory_size(), token.memory_side_effects());
+		}
+
+		default:
+			return src.value;
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_program - execute a compiled
+//  expression
+//-------------------------------------------------
+
+u64 parsed_expression::execute_program()
+{
+	u64 funcparams[MAX_FUNCTION_PARAMS];
+	u64 *sp = &m_program_stack[0];
+	for (const compiled_op &op : m_program)
+	{
+		u64 t1, t2, result;
+		switch (op.opcode)
+		{
+			case TVL_COMPLEMENT:        result = !fetch_operand(op.src[0], sp); break;
+			case TVL_NOT:               result = ~fetch_operand(op.src[0], sp); break;
+			case TVL_UPLUS:             result = fetch_operand(op.src[0], sp); break;
+			case TVL_UMINUS:            result = -fetch_operand(op.src[0], sp); break;
+			case TVL_MEMORYAT:          result = fetch_operand(op.src[0], sp); break;
+
+			case TVL_MULTIPLY:          t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 * t2; break;
+			case TVL_ADD:               t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 + t2; break;
+			case TVL_SUBTRACT:          t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 - t2; break;
+			case TVL_LSHIFT:            t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 << t2; break;
+			case TVL_RSHIFT:            t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 >> t2; break;
+			case TVL_LESS:              t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 < t2; break;
+			case TVL_LESSOREQUAL:       t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 <= t2; break;
+			case TVL_GREATER:           t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 > t2; break;
+			case TVL_GREATEROREQUAL:    t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 >= t2; break;
+			case TVL_EQUAL:             t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 == t2; break;
+			case TVL_NOTEQUAL:          t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 != t2; break;
+			case TVL_BAND:              t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 & t2; break;
+			case TVL_BXOR:              t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 ^ t2; break;
+			case TVL_BOR:               t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 | t2; break;
+			case TVL_LAND:              t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 && t2; break;
+			case TVL_LOR:               t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t1 || t2; break;
+			case TVL_COMMA:             t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp); result = t2; break;
+
+			case TVL_DIVIDE:
+				t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp);
+				if (t2 == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				result = t1 / t2;
+				break;
+
+			case TVL_MODULO:
+				t2 = fetch_operand(op.src[1], sp); t1 = fetch_operand(op.src[0], sp);
+				if (t2 == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				result = t1 % t2;
+				break;
+
+			case OP_PARAM:
+				funcparams[MAX_FUNCTION_PARAMS - op.param] = fetch_operand(op.src[0], sp);
+				continue;
+
+			case OP_CALL:
+				result = downcast<function_symbol_entry *>(op.src[0].symbol)->execute(op.param, &funcparams[MAX_FUNCTION_PARAMS - op.param]);
+				break;
+
+			case OP_RESULT:
+				return fetch_operand(op.src[0], sp);
+
+			default:
+				throw expression_error(expression_error::SYNTAX, op.offset);
+		}
+		*sp++ = result;
+	}
+
+	// compile_tokens always ends the program with OP_RESULT
+	throw expression_error(expression_error::SYNTAX, 0);
+}
+
+
+
 //**************************************************************************
 //  PARSE TOKEN
 //**************************************************************************
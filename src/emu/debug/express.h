@@ -20,6 +20,7 @@
 #include <list>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -247,7 +248,8 @@ public:
 
 	// execution
 	void parse(std::string_view string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_program.empty() ? execute_tokens() : execute_program(); }
+	bool is_compiled() const { return !m_program.empty(); }
 
 private:
 	// a single token
@@ -309,6 +311,7 @@ private:
 		expression_space memory_space() const { assert(m_type == OPERATOR || m_type == MEMORY); return expression_space((m_flags & TIN_MEMORY_SPACE_MASK) >> TIN_MEMORY_SPACE_SHIFT); }
 		int memory_size() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_MEMORY_SIZE_MASK) >> TIN_MEMORY_SIZE_SHIFT; }
 		bool memory_side_effects() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_SIDE_EFFECT_MASK) >> TIN_SIDE_EFFECT_SHIFT; }
+		const char *memory_source() const { assert(m_type == OPERATOR || m_type == MEMORY); return m_string; }
 
 		// setters
 		parse_token &set_offset(int offset) { m_offset = offset; return *this; }
@@ -342,6 +345,34 @@ private:
 		symbol_entry *          m_symbol;           // symbol pointer
 	};
 
+	// where a compiled operand comes from
+	enum operand_source : u8
+	{
+		SOURCE_CONSTANT,        // value known at compile time
+		SOURCE_STACK,           // value on the evaluation stack
+		SOURCE_SYMBOL,          // symbol, read when the operand is used
+		SOURCE_MEMORY           // address on the evaluation stack, read when the operand is used
+	};
+
+	// a compiled operand
+	struct compiled_operand
+	{
+		operand_source          source = SOURCE_CONSTANT;
+		u64                     value = 0;          // constant value
+		symbol_entry *          symbol = nullptr;   // symbol (SOURCE_SYMBOL) or function (OP_CALL)
+		const parse_token *     memory = nullptr;   // memory operator (SOURCE_MEMORY)
+	};
+
+	// a compiled instruction: applies an operator to one or two operands
+	// and pushes the result
+	struct compiled_op
+	{
+		u8                      opcode;             // TVL_* operator or OP_* pseudo-operator
+		u8                      param;              // parameter index (OP_PARAM) or count (OP_CALL)
+		int                     offset;             // offset within the string for errors
+		compiled_operand        src[2];             // operands, popped in reverse order
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens();
@@ -364,6 +395,11 @@ private:
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
 
+	// compilation helpers
+	bool compile_tokens();
+	u64 execute_program();
+	u64 fetch_operand(const compiled_operand &src, u64 *&sp);
+
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
 
@@ -374,6 +410,8 @@ private:
 	std::list<parse_token> m_tokenlist;                 // token list
 	std::list<std::string> m_stringlist;                // string list
 	std::deque<parse_token> m_token_stack;              // token stack (used during execution)
+	std::vector<compiled_op> m_program;                 // compiled form of the token list (empty if not compilable)
+	std::vector<u64>    m_program_stack;                // evaluation stack for the compiled form
 };
 
 #endif // MAME_EMU_DEBUG_EXPRESS_H
@@ -0,0 +1,266 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    memsearch.cpp
+
+    Snapshot comparison engine for memory searches.
+
+***************************************************************************/
+
+#include "emucore.h"
+#include "eminline.h"
+#include "memsearch.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+//-------------------------------------------------
+//  debug_memory_search - constructor
+//-------------------------------------------------
+
+debug_memory_search::debug_memory_search(size_t length, unsigned width, endianness_t endian, bool is_signed, unsigned step)
+	: m_length(length)
+	, m_width(width)
+	, m_step(step ? step : width)
+	, m_endian(endian)
+	, m_signed(is_signed)
+	, m_positions((length >= width) ? ((length - width) / m_step + 1) : 0)
+	, m_all(true)
+{
+	assert((width == 1) || (width == 2) || (width == 4) || (width == 8));
+}
+
+
+//-------------------------------------------------
+//  parse_condition - map a condition name to a
+//  condition
+//-------------------------------------------------
+
+bool debug_memory_search::parse_condition(std::string_view name, condition &result)
+{
+	static const std::pair<std::string_view, condition> s_names[] = {
+		{ "eq", condition::EQ },
+		{ "ne", condition::NE },
+		{ "lt", condition::LT },
+		{ "gt", condition::GT },
+		{ "eqv", condition::EQV },
+		{ "nev", condition::NEV },
+		{ "ltv", condition::LTV },
+		{ "gtv", condition::GTV },
+		{ "delta", condition::DELTA } };
+
+	for (auto const &entry : s_names)
+	{
+		if (entry.first == name)
+		{
+			result = entry.second;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  reset - make every position a candidate again
+//-------------------------------------------------
+
+void debug_memory_search::reset()
+{
+	m_all = true;
+	m_words.clear();
+}
+
+
+//-------------------------------------------------
+//  count - number of surviving candidates
+//-------------------------------------------------
+
+u64 debug_memory_search::count() const
+{
+	if (m_all)
+		return m_positions;
+
+	u64 result = 0;
+	for (word const &w : m_words)
+		result += population_count_64(w.bits);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  matches - byte offsets of the surviving
+//  candidates
+//-------------------------------------------------
+
+std::vector<size_t> debug_memory_search::matches(size_t limit) const
+{
+	std::vector<size_t> result;
+	if (m_all)
+	{
+		for (size_t pos = 0; (pos < m_positions) && (result.size() < limit); pos++)
+			result.push_back(pos * m_step);
+	}
+	else
+	{
+		for (word const &w : m_words)
+		{
+			for (u64 bits = w.bits; bits && (result.size() < limit); bits &= bits - 1)
+			{
+				unsigned const bit = population_count_64((bits & ~(bits - 1)) - 1);
+				result.push_back((size_t(w.index) * 64 + bit) * m_step);
+			}
+		}
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  value - read a candidate from a snapshot,
+//  sign-extended for signed searches
+//-------------------------------------------------
+
+u64 debug_memory_search::value(u8 const *data, size_t offset) const
+{
+	switch (m_width)
+	{
+	case 1: return m_signed ? u64(s64(s8(data[offset]))) : data[offset];
+	case 2: return m_signed ? u64(s64(s16(load<u16>(data, offset)))) : load<u16>(data, offset);
+	case 4: return m_signed ? u64(s64(s32(load<u32>(data, offset)))) : load<u32>(data, offset);
+	default: return load<u64>(data, offset);
+	}
+}
+
+
+//-------------------------------------------------
+//  filter - keep the candidates that satisfy a
+//  condition; olddata may be null for
+//  comparisons against a constant
+//-------------------------------------------------
+
+void debug_memory_search::filter(u8 const *newdata, u8 const *olddata, condition cond, u64 value)
+{
+	switch (m_width)
+	{
+	case 1: m_signed ? filter_typed<s8>(newdata, olddata, cond, value) : filter_typed<u8>(newdata, olddata, cond, value); break;
+	case 2: m_signed ? filter_typed<s16>(newdata, olddata, cond, value) : filter_typed<u16>(newdata, olddata, cond, value); break;
+	case 4: m_signed ? filter_typed<s32>(newdata, olddata, cond, value) : filter_typed<u32>(newdata, olddata, cond, value); break;
+	case 8: m_signed ? filter_typed<s64>(newdata, olddata, cond, value) : filter_typed<u64>(newdata, olddata, cond, value); break;
+	}
+}
+
+
+//-------------------------------------------------
+//  filter_typed - pick the comparison so that the
+//  inner loops are specialised for it
+//-------------------------------------------------
+
+template <typename T>
+void debug_memory_search::filter_typed(u8 const *newdata, u8 const *olddata, condition cond, u64 value)
+{
+	T const v = T(value);
+	switch (cond)
+	{
+	case condition::EQ:    apply<T>(newdata, olddata, [] (T n, T o) { return n == o; }); break;
+	case condition::NE:    apply<T>(newdata, olddata, [] (T n, T o) { return n != o; }); break;
+	case condition::LT:    apply<T>(newdata, olddata, [] (T n, T o) { return n < o; }); break;
+	case condition::GT:    apply<T>(newdata, olddata, [] (T n, T o) { return n > o; }); break;
+	case condition::EQV:   apply<T>(newdata, nullptr, [v] (T n, T) { return n == v; }); break;
+	case condition::NEV:   apply<T>(newdata, nullptr, [v] (T n, T) { return n != v; }); break;
+	case condition::LTV:   apply<T>(newdata, nullptr, [v] (T n, T) { return n < v; }); break;
+	case condition::GTV:   apply<T>(newdata, nullptr, [v] (T n, T) { return n > v; }); break;
+	case condition::DELTA:
+		// widen first so that the difference doesn't wrap at the value's width
+		apply<T>(newdata, olddata, [d = s64(value)] (T n, T o) { return s64(u64(s64(n)) - u64(s64(o))) == d; });
+		break;
+	}
+}
+
+
+//-------------------------------------------------
+//  apply - evaluate a predicate over the
+//  candidates 64 at a time and drop the empty
+//  words
+//-------------------------------------------------
+
+template <typename T, typename Pred>
+void debug_memory_search::apply(u8 const *newdata, u8 const *olddata, Pred &&pred)
+{
+	// dense blocks are a straight loop the compiler can vectorise
+	auto const block =
+			[this, newdata, olddata, &pred] (u32 index, u64 bits) -> u64
+			{
+				size_t const first = size_t(index) * 64;
+				unsigned const count = unsigned(std::min<size_t>(64, m_positions - first));
+				u64 result = 0;
+				if (population_count_64(bits) >= 16)
+				{
+					for (unsigned i = 0; i < count; i++)
+					{
+						size_t const pos = (first + i) * m_step;
+						result |= u64(pred(load<T>(newdata, pos), olddata ? load<T>(olddata, pos) : T(0)) ? 1 : 0) << i;
+					}
+				}
+				else
+				{
+					for (u64 remaining = bits; remaining; remaining &= remaining - 1)
+					{
+						unsigned const i = population_count_64((remaining & ~(remaining - 1)) - 1);
+						size_t const pos = (first + i) * m_step;
+						result |= u64(pred(load<T>(newdata, pos), olddata ? load<T>(olddata, pos) : T(0)) ? 1 : 0) << i;
+					}
+				}
+				return result & bits;
+			};
+
+	if (m_all)
+	{
+		m_words.clear();
+		u32 const words = u32((m_positions + 63) / 64);
+		for (u32 index = 0; index < words; index++)
+		{
+			u64 const bits = block(index, ~u64(0));
+			if (bits)
+				m_words.push_back(word{ index, bits });
+		}
+		m_words.shrink_to_fit();
+		m_all = false;
+	}
+	else
+	{
+		auto dest = m_words.begin();
+		for (word const &w : m_words)
+		{
+			u64 const bits = block(w.index, w.bits);
+			if (bits)
+				*dest++ = word{ w.index, bits };
+		}
+		m_words.erase(dest, m_words.end());
+	}
+}
+
+
+//-------------------------------------------------
+//  load - read a value from a snapshot in the
+//  search's byte order
+//-------------------------------------------------
+
+template <typename T>
+T debug_memory_search::load(u8 const *data, size_t position) const
+{
+	T result;
+	std::memcpy(&result, &data[position], sizeof(T));
+	if (m_endian != ENDIANNESS_NATIVE)
+	{
+		if constexpr (sizeof(T) == 2)
+			result = T(swapendian_int16(u16(result)));
+		else if constexpr (sizeof(T) == 4)
+			result = T(swapendian_int32(u32(result)));
+		else if constexpr (sizeof(T) == 8)
+			result = T(swapendian_int64(u64(result)));
+	}
+	return result;
+}
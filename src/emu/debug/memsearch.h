@@ -0,0 +1,85 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    memsearch.h
+
+    Snapshot comparison engine for memory searches.
+
+    Candidates are values of a fixed width at a fixed step through a
+    snapshot of memory.  Each filter compares a new snapshot against
+    the previous one (or against a constant) and keeps the candidates
+    that satisfy the condition.  The surviving candidates are kept as
+    a sparse bitmap holding only the non-empty 64-candidate words, so
+    repeated narrowing gets cheaper as the set shrinks.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_MEMSEARCH_H
+#define MAME_EMU_DEBUG_MEMSEARCH_H
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+
+class debug_memory_search
+{
+public:
+	enum class condition
+	{
+		EQ,         // new == old
+		NE,         // new != old
+		LT,         // new < old
+		GT,         // new > old
+		EQV,        // new == value
+		NEV,        // new != value
+		LTV,        // new < value
+		GTV,        // new > value
+		DELTA       // new - old == value, with the difference taken in 64 bits
+	};
+
+	// width is 1, 2, 4 or 8 bytes; step defaults to the width
+	debug_memory_search(size_t length, unsigned width, endianness_t endian, bool is_signed, unsigned step = 0);
+
+	static bool parse_condition(std::string_view name, condition &result);
+
+	// narrow the candidates; snapshots are length bytes in address order
+	void filter(u8 const *newdata, u8 const *olddata, condition cond, u64 value);
+	void reset();
+
+	// getters
+	size_t length() const { return m_length; }
+	unsigned width() const { return m_width; }
+	unsigned step() const { return m_step; }
+	u64 count() const;
+
+	// byte offsets of surviving candidates, in order, up to a limit
+	std::vector<size_t> matches(size_t limit = ~size_t(0)) const;
+
+	// value of a candidate in a snapshot
+	u64 value(u8 const *data, size_t offset) const;
+
+private:
+	struct word
+	{
+		u32 index;          // candidate number / 64
+		u64 bits;           // one bit per surviving candidate
+	};
+
+	template <typename T> void filter_typed(u8 const *newdata, u8 const *olddata, condition cond, u64 value);
+	template <typename T, typename Pred> void apply(u8 const *newdata, u8 const *olddata, Pred &&pred);
+	template <typename T> T load(u8 const *data, size_t position) const;
+
+	size_t const        m_length;       // snapshot length in bytes
+	unsigned const      m_width;        // value width in bytes
+	unsigned const      m_step;         // bytes between candidates
+	endianness_t const  m_endian;       // byte order of values
+	bool const          m_signed;       // compare as signed values
+	size_t const        m_positions;    // number of candidates in a snapshot
+	bool                m_all;          // no filter applied yet
+	std::vector<word>   m_words;        // surviving candidates when !m_all
+};
+
+#endif // MAME_EMU_DEBUG_MEMSEARCH_H
@@ -12,6 +12,7 @@
 #include "points.h"
 #include "debugger.h"
 #include "debugcon.h"
+#include "reverse.h"
 
 
 //**************************************************************************
@@ -373,6 +374,14 @@ void debug_watchpoint::triggered(read_or_write type, offs_t address, u64 data, u
 		}
 	}
 
+	// while reverse execution replays history, just note the hit
+	if (debug.cpu().reverse().active())
+	{
+		debug.cpu().reverse().watchpoint_hit(*this);
+		debug.cpu().set_within_instruction(false);
+		return;
+	}
+
 	// halt in the debugger by default
 	bool was_stopped = debug.cpu().is_stopped();
 	debug.cpu().set_execution_stopped();
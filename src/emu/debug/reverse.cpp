@@ -0,0 +1,566 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    reverse.cpp
+
+    Reverse execution using periodic snapshots and replay.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "reverse.h"
+
+#include "debugcon.h"
+#include "debugcpu.h"
+#include "points.h"
+
+#include "debugger.h"
+#include "journal.h"
+
+#include <algorithm>
+
+
+namespace {
+
+// instructions between snapshots before the budget forces them apart
+constexpr u64 INITIAL_INTERVAL = 100'000;
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  debug_reverse - constructor
+//-------------------------------------------------
+
+debug_reverse::debug_reverse(running_machine &machine)
+	: m_machine(machine)
+	, m_enabled(false)
+	, m_budget(0)
+	, m_state_size(0)
+	, m_interval(INITIAL_INTERVAL)
+	, m_total(0)
+	, m_loading(false)
+	, m_rewound(false)
+	, m_phase(phase::IDLE)
+	, m_restore(-1)
+	, m_next(phase::IDLE)
+	, m_target{ nullptr, 0 }
+	, m_origin{ nullptr, 0 }
+	, m_limit(0)
+	, m_segment(-1)
+	, m_segment_end(0)
+	, m_hit(false)
+	, m_hit_position{ nullptr, 0 }
+{
+	// a reset or a state loaded by anything else breaks the history
+	m_machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&debug_reverse::reset, this));
+	m_machine.save().register_postload(save_prepost_delegate(FUNC(debug_reverse::postload), this));
+}
+
+
+//-------------------------------------------------
+//  ~debug_reverse - destructor
+//-------------------------------------------------
+
+debug_reverse::~debug_reverse()
+{
+}
+
+
+//-------------------------------------------------
+//  enable - start keeping history
+//-------------------------------------------------
+
+bool debug_reverse::enable(size_t budget)
+{
+	debugger_manager &debug = m_machine.debugger();
+
+	m_state_size = ram_state::get_size(m_machine.save());
+	if (budget < m_state_size * 2)
+	{
+		debug.console().printf("Error: budget must allow at least two snapshots of %u KB\n", (m_state_size + 1023) / 1024);
+		return false;
+	}
+
+	if (!m_enabled)
+	{
+		m_devices.clear();
+		for (device_execute_interface &exec : execute_interface_enumerator(m_machine.root_device()))
+			m_devices.push_back(exec.device().debug());
+		clear();
+		m_total = 0;
+		m_enabled = true;
+
+		// host input is replayed from the journal
+		m_machine.journal().keep_history(true);
+	}
+	m_budget = budget;
+	while (m_snapshots.size() * m_state_size > m_budget)
+		thin();
+	if (!m_snapshots.empty())
+		m_machine.journal().forget(&m_snapshots.front().journal);
+
+	// make sure the instruction hook gets called from now on
+	if (debug.cpu().live_cpu() != nullptr)
+		debug.cpu().live_cpu()->debug()->compute_debug_flags();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  disable - stop keeping history and free the
+//  snapshots
+//-------------------------------------------------
+
+void debug_reverse::disable()
+{
+	if (!m_enabled)
+		return;
+
+	m_enabled = false;
+	clear();
+	m_snapshots.shrink_to_fit();
+	m_machine.journal().keep_history(false);
+
+	debugger_cpu &debugcpu = m_machine.debugger().cpu();
+	if (debugcpu.live_cpu() != nullptr)
+		debugcpu.live_cpu()->debug()->compute_debug_flags();
+}
+
+
+//-------------------------------------------------
+//  status - describe the history on the console
+//-------------------------------------------------
+
+void debug_reverse::status()
+{
+	debugger_console &console = m_machine.debugger().console();
+	if (!m_enabled)
+	{
+		console.printf("Reverse execution is disabled\n");
+		return;
+	}
+
+	console.printf("Reverse execution is enabled: %u snapshots using %u of %u MB, one every %u instructions\n",
+			m_snapshots.size(),
+			(m_snapshots.size() * m_state_size + (1 << 20) - 1) >> 20,
+			m_budget >> 20,
+			m_interval);
+	if (!m_snapshots.empty())
+		console.printf("History goes back to %s\n", m_snapshots.front().state->m_time.to_string());
+
+	device_t *const cpu = console.get_visible_cpu();
+	if (cpu != nullptr)
+		console.printf("CPU '%s' has executed %u instructions\n", cpu->tag(), cpu->debug()->instruction_count());
+}
+
+
+//-------------------------------------------------
+//  step_back - go back a number of instructions
+//  on a CPU
+//-------------------------------------------------
+
+bool debug_reverse::step_back(device_t &device, u64 steps)
+{
+	debugger_console &console = m_machine.debugger().console();
+	if (!m_enabled)
+	{
+		console.printf("Error: reverse execution is not enabled\n");
+		return false;
+	}
+
+	device_debug &debug = *device.debug();
+	u64 const count = debug.instruction_count();
+	int const index = (steps < count) ? find_snapshot(debug, count - steps) : -1;
+	if (index < 0)
+	{
+		console.printf("Error: not enough history to step back %u instructions\n", steps);
+		return false;
+	}
+
+	m_target = position{ &debug, count - steps };
+	m_message.clear();
+	m_limit = m_total;
+	restore(index, phase::STEP);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  continue_back - go back to the most recent
+//  breakpoint or watchpoint hit, or to the start
+//  of the history
+//-------------------------------------------------
+
+bool debug_reverse::continue_back(device_t &device)
+{
+	debugger_console &console = m_machine.debugger().console();
+	if (!m_enabled)
+	{
+		console.printf("Error: reverse execution is not enabled\n");
+		return false;
+	}
+
+	device_debug &debug = *device.debug();
+	int const index = find_snapshot(debug, debug.instruction_count());
+	if (index < 0)
+	{
+		console.printf("Error: no history before this point\n");
+		return false;
+	}
+
+	m_origin = position{ &debug, debug.instruction_count() };
+	m_limit = m_total;
+	m_segment = index;
+	m_segment_end = 0;
+	restore(index, phase::SCAN);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  machine_changed - the debugger changed the
+//  machine, so no snapshot leads here any more
+//-------------------------------------------------
+
+void debug_reverse::machine_changed()
+{
+	// a snapshot is taken at the end of this timeslice
+	if (m_enabled)
+		clear();
+}
+
+
+//-------------------------------------------------
+//  instruction_hook - count an instruction;
+//  returns false if the debugger should ignore it
+//  because history is being replayed
+//-------------------------------------------------
+
+bool debug_reverse::instruction_hook(device_debug &device, offs_t pc)
+{
+	// running on from a point we went back to makes a new history
+	// unless the journal replays host input
+	if (m_rewound && (m_phase == phase::IDLE))
+	{
+		m_rewound = false;
+		if (!m_machine.journal().active())
+			discard_future();
+	}
+
+	m_total++;
+
+	switch (m_phase)
+	{
+	case phase::IDLE:
+		return true;
+
+	case phase::RESTORE:
+		return false;
+
+	case phase::STEP:
+		if (position{ &device, device.instruction_count() } == m_target)
+		{
+			arrive();
+			return true;
+		}
+		return false;
+
+	case phase::SCAN:
+		{
+			position const here{ &device, device.instruction_count() };
+			if (!m_segment_end && (here == m_origin))
+			{
+				finish_scan();
+			}
+			else
+			{
+				debug_breakpoint const *const bp = device.breakpoint_hit(pc);
+				if (bp != nullptr)
+				{
+					m_hit = true;
+					m_hit_position = here;
+					m_hit_message = string_format("Stopped at breakpoint %X", bp->index());
+				}
+			}
+		}
+		return false;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  watchpoint_hit - note a watchpoint hit while
+//  replaying; the debugger stops before the next
+//  instruction of the CPU that caused it
+//-------------------------------------------------
+
+void debug_reverse::watchpoint_hit(const debug_watchpoint &wp)
+{
+	if (m_phase != phase::SCAN)
+		return;
+
+	device_t *const cpu = m_machine.debugger().cpu().live_cpu();
+	if ((cpu == nullptr) || !cpu->debug()->observing())
+		return;
+
+	position const here{ cpu->debug(), cpu->debug()->instruction_count() + 1 };
+	if (m_segment_end || !(here == m_origin))
+	{
+		m_hit = true;
+		m_hit_position = here;
+		m_hit_message = string_format("Stopped at watchpoint %X", wp.index());
+	}
+}
+
+
+//-------------------------------------------------
+//  timeslice_end - take a snapshot or load one;
+//  called by the machine between timeslices
+//-------------------------------------------------
+
+void debug_reverse::timeslice_end()
+{
+	if (!m_enabled)
+		return;
+
+	// replay must not run past where it started
+	if (((m_phase == phase::STEP) || (m_phase == phase::SCAN)) && (m_total > m_limit))
+	{
+		clear();
+		m_machine.debugger().console().printf("Replay diverged from the recorded history; history discarded\n");
+		m_machine.debugger().cpu().set_execution_stopped();
+		return;
+	}
+
+	// earlier segments end at the snapshot that starts the next one
+	if ((m_phase == phase::SCAN) && m_segment_end && (m_total >= m_segment_end))
+		finish_scan();
+
+	if (m_phase == phase::RESTORE)
+	{
+		snapshot &snap = m_snapshots[m_restore];
+		m_machine.journal().rewind(snap.journal);
+		m_loading = true;
+		save_error const err = snap.state->load();
+		m_loading = false;
+		if (err != STATERR_NONE)
+		{
+			clear();
+			m_machine.debugger().console().printf("Error: unable to load snapshot; history discarded\n");
+			m_machine.debugger().cpu().set_execution_stopped();
+			return;
+		}
+
+		for (size_t i = 0; i < m_devices.size(); i++)
+			m_devices[i]->set_instruction_count(snap.counts[i]);
+		m_total = snap.total;
+		m_hit = false;
+		m_phase = m_next;
+	}
+	else if ((m_phase == phase::IDLE) && (m_snapshots.empty() || (m_total >= (m_snapshots.back().total + m_interval))))
+	{
+		capture();
+	}
+}
+
+
+//-------------------------------------------------
+//  device_index - find a CPU in the snapshot
+//  counts
+//-------------------------------------------------
+
+unsigned debug_reverse::device_index(const device_debug &device) const
+{
+	auto const found = std::find(m_devices.begin(), m_devices.end(), &device);
+	assert(found != m_devices.end());
+	return found - m_devices.begin();
+}
+
+
+//-------------------------------------------------
+//  find_snapshot - find the newest snapshot taken
+//  before a CPU executed an instruction
+//-------------------------------------------------
+
+int debug_reverse::find_snapshot(const device_debug &device, u64 count) const
+{
+	if (std::find(m_devices.begin(), m_devices.end(), &device) == m_devices.end())
+		return -1;
+
+	unsigned const index = device_index(device);
+	for (int i = int(m_snapshots.size()) - 1; i >= 0; i--)
+	{
+		if (m_snapshots[i].counts[index] < count)
+			return i;
+	}
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  capture - add a snapshot, making room for it
+//  if necessary
+//-------------------------------------------------
+
+void debug_reverse::capture()
+{
+	// reuse a dropped state's buffer if there is one
+	std::unique_ptr<ram_state> state;
+	if ((m_snapshots.size() + 1) * m_state_size > m_budget)
+		state = thin();
+	if (!state)
+		state = std::make_unique<ram_state>(m_machine.save());
+
+	if (state->save() != STATERR_NONE)
+	{
+		disable();
+		m_machine.debugger().console().printf("Unable to save a snapshot; reverse execution disabled\n");
+		return;
+	}
+
+	snapshot &snap = m_snapshots.emplace_back();
+	snap.state = std::move(state);
+	snap.total = m_total;
+	snap.counts.reserve(m_devices.size());
+	for (device_debug *device : m_devices)
+		snap.counts.push_back(device->instruction_count());
+	m_machine.journal().mark(snap.journal);
+	m_machine.journal().forget(&m_snapshots.front().journal);
+}
+
+
+//-------------------------------------------------
+//  thin - drop every other snapshot, keeping the
+//  newest, and double the interval; returns one
+//  of the dropped states
+//-------------------------------------------------
+
+std::unique_ptr<ram_state> debug_reverse::thin()
+{
+	std::unique_ptr<ram_state> spare;
+	size_t const count = m_snapshots.size();
+	auto dest = m_snapshots.begin();
+	for (size_t i = 0; i < count; i++)
+	{
+		if (((count - 1 - i) & 1) == 0)
+			*dest++ = std::move(m_snapshots[i]);
+		else if (!spare)
+			spare = std::move(m_snapshots[i].state);
+	}
+	m_snapshots.erase(dest, m_snapshots.end());
+	m_interval *= 2;
+	return spare;
+}
+
+
+//-------------------------------------------------
+//  restore - abandon the current timeslice and
+//  load a snapshot at the end of it
+//-------------------------------------------------
+
+void debug_reverse::restore(int index, phase next)
+{
+	debugger_cpu &debugcpu = m_machine.debugger().cpu();
+
+	m_restore = index;
+	m_next = next;
+	m_phase = phase::RESTORE;
+
+	debugcpu.reset_transient_flags();
+	debugcpu.set_execution_running();
+	m_machine.scheduler().eat_all_cycles();
+}
+
+
+//-------------------------------------------------
+//  finish_scan - go to the last hit in the
+//  segment just scanned, or scan the one before
+//-------------------------------------------------
+
+void debug_reverse::finish_scan()
+{
+	if (m_hit)
+	{
+		m_target = m_hit_position;
+		m_message = m_hit_message;
+		restore(m_segment, phase::STEP);
+	}
+	else if (m_segment > 0)
+	{
+		m_segment_end = m_snapshots[m_segment].total;
+		m_segment--;
+		restore(m_segment, phase::SCAN);
+	}
+	else
+	{
+		m_target = position{ m_origin.device, m_snapshots[0].counts[device_index(*m_origin.device)] + 1 };
+		m_message = "Reached the start of the reverse execution history";
+		restore(0, phase::STEP);
+	}
+}
+
+
+//-------------------------------------------------
+//  arrive - stop at the target
+//-------------------------------------------------
+
+void debug_reverse::arrive()
+{
+	m_phase = phase::IDLE;
+	m_rewound = true;
+	m_machine.debugger().cpu().set_execution_stopped();
+	if (!m_message.empty())
+		m_machine.debugger().console().printf("%s\n", m_message);
+}
+
+
+//-------------------------------------------------
+//  discard_future - drop snapshots taken after
+//  the current point
+//-------------------------------------------------
+
+void debug_reverse::discard_future()
+{
+	while (!m_snapshots.empty() && (m_snapshots.back().total > m_total))
+		m_snapshots.pop_back();
+}
+
+
+//-------------------------------------------------
+//  clear - forget all snapshots
+//-------------------------------------------------
+
+void debug_reverse::clear()
+{
+	m_snapshots.clear();
+	m_machine.journal().forget(nullptr);
+	m_interval = INITIAL_INTERVAL;
+	m_phase = phase::IDLE;
+	m_rewound = false;
+}
+
+
+//-------------------------------------------------
+//  reset - a reset can't be replayed, so the
+//  history before it is useless
+//-------------------------------------------------
+
+void debug_reverse::reset()
+{
+	clear();
+}
+
+
+//-------------------------------------------------
+//  postload - another state was loaded, so the
+//  history no longer leads here
+//-------------------------------------------------
+
+void debug_reverse::postload()
+{
+	if (!m_loading)
+		clear();
+}
@@ -0,0 +1,144 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    reverse.h
+
+    Reverse execution using periodic snapshots and replay.
+
+    While enabled, every observed CPU calls the instruction hook so that
+    each one keeps a count of the instructions it has executed.  At the
+    end of a timeslice, once enough instructions have gone by, the whole
+    machine is saved to an in-memory state along with those counts.
+
+    Going backwards means loading the newest snapshot taken before the
+    target and running forwards again until the target CPU's count
+    reaches the target instruction.  Reverse continue first replays the
+    history in segments, newest first, noting the last breakpoint or
+    watchpoint hit in each, and then replays to that hit.  Snapshots
+    are only ever loaded at the end of a timeslice, where save states
+    are consistent, so replay follows the original run exactly as long
+    as nothing outside the machine changes it.  When a journal is being
+    recorded or replayed, host input is fed back from the journal's
+    history, so running forwards again repeats the original run;
+    without one, running forwards from a point we went back to discards
+    the snapshots after that point.  Changing the machine from the
+    debugger discards the whole history, as replaying from any snapshot
+    before the change would lose it.
+
+    When the snapshots would exceed the memory budget, every other one
+    is dropped and the interval between snapshots is doubled, so the
+    history reaches further back at a coarser granularity.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_REVERSE_H
+#define MAME_EMU_DEBUG_REVERSE_H
+
+#pragma once
+
+#include "journal.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// ======================> debug_reverse
+
+class debug_reverse
+{
+public:
+	// construction/destruction
+	debug_reverse(running_machine &machine);
+	~debug_reverse();
+
+	// getters
+	bool enabled() const { return m_enabled; }
+	bool active() const { return m_phase != phase::IDLE; }
+
+	// control; the budget is in bytes
+	bool enable(size_t budget);
+	void disable();
+	void status();
+
+	// step the given CPU back, or go back to the previous breakpoint or
+	// watchpoint hit; these resume execution to do the replay
+	bool step_back(device_t &device, u64 steps = 1);
+	bool continue_back(device_t &device);
+
+	// forget the history because the machine was changed from the
+	// debugger, e.g. memory was written
+	void machine_changed();
+
+	// hooks
+	bool instruction_hook(device_debug &device, offs_t pc);
+	void watchpoint_hit(const debug_watchpoint &wp);
+	void timeslice_end();
+
+private:
+	enum class phase
+	{
+		IDLE,               // recording snapshots
+		RESTORE,            // waiting for the end of the timeslice to load a snapshot
+		STEP,               // replaying to the target
+		SCAN                // replaying a segment to find the last hit
+	};
+
+	struct snapshot
+	{
+		std::unique_ptr<ram_state> state;       // machine state
+		u64                 total;              // instructions executed by all CPUs
+		std::vector<u64>    counts;             // instructions executed by each CPU
+		journal_mark        journal;            // journal position
+	};
+
+	struct position
+	{
+		device_debug *      device;             // CPU
+		u64                 count;              // its instruction count
+
+		bool operator==(const position &that) const { return (device == that.device) && (count == that.count); }
+	};
+
+	// internal helpers
+	unsigned device_index(const device_debug &device) const;
+	int find_snapshot(const device_debug &device, u64 count) const;
+	void capture();
+	std::unique_ptr<ram_state> thin();
+	void restore(int index, phase next);
+	void finish_scan();
+	void arrive();
+	void discard_future();
+	void clear();
+	void reset();
+	void postload();
+
+	// internal state
+	running_machine &   m_machine;              // reference to our machine
+	bool                m_enabled;              // keeping history
+	size_t              m_budget;               // memory allowed for snapshots
+	size_t              m_state_size;           // size of one snapshot
+	u64                 m_interval;             // instructions between snapshots
+	u64                 m_total;                // instructions executed by all CPUs
+	std::vector<device_debug *> m_devices;      // CPUs whose counts are snapshotted
+	std::vector<snapshot> m_snapshots;          // snapshots, oldest first
+	bool                m_loading;              // loading one of our own snapshots
+	bool                m_rewound;              // stopped at a point we went back to
+
+	// replay state
+	phase               m_phase;                // what we're doing
+	int                 m_restore;              // snapshot to load
+	phase               m_next;                 // what to do once it's loaded
+	position            m_target;               // where to stop
+	std::string         m_message;              // what to say when we get there
+	position            m_origin;               // where reverse continue started
+	u64                 m_limit;                // total when the replay was requested
+	int                 m_segment;              // snapshot starting the segment being scanned
+	u64                 m_segment_end;          // total at the end of the segment (0 for the first)
+	bool                m_hit;                  // found a hit in this segment
+	position            m_hit_position;         // where the latest hit stops
+	std::string         m_hit_message;          // how to describe it
+};
+
+#endif // MAME_EMU_DEBUG_REVERSE_H
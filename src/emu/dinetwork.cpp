@@ -4,6 +4,8 @@
 #include "emu.h"
 #include "dinetwork.h"
 
+#include "journal.h"
+
 #include "osdnet.h"
 
 #include <algorithm>
@@ -14,6 +16,7 @@ device_network_interface::device_network_interface(const machine_config &mconfig
 	, m_poll_timer(nullptr)
 	, m_send_timer(nullptr)
 	, m_recv_timer(nullptr)
+	, m_journal(nullptr)
 {
 	// Convert to Mibps to Bps
 	m_bandwidth = bandwidth << (20 - 3);
@@ -32,12 +35,16 @@ void device_network_interface::interface_post_start()
 	m_send_timer = device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(device_network_interface::send_complete), this));
 	m_recv_timer = device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(device_network_interface::recv_complete), this));
 
+	m_journal = device().machine().journal().channel(std::string("network:") + device().tag());
+	if (m_journal)
+		m_journal_frame.resize(65536);
+
 	device().save_item(NAME(m_loopback_control));
 }
 
 void device_network_interface::interface_post_load()
 {
-	if (!m_dev)
+	if (!has_receiver())
 		m_poll_timer->reset();
 	else if (!m_loopback_control && !m_recv_timer->enabled())
 		start_net_device();
@@ -80,13 +87,46 @@ int device_network_interface::send(u8 *buf, int len, int fcs)
 
 TIMER_CALLBACK_MEMBER(device_network_interface::poll_device)
 {
-	m_dev->poll();
+	if (!m_journal)
+	{
+		m_dev->poll();
+		return;
+	}
+
+	// take frames one at a time so the journal can count them
+	while (m_poll_timer->enabled())
+	{
+		size_t const len = m_journal->input(
+				m_journal_frame.data(),
+				m_journal_frame.size(),
+				[this] (u8 *buffer, size_t length) -> size_t
+				{
+					u8 *buf;
+					int const actual = m_dev ? m_dev->receive(&buf) : 0;
+					if (actual <= 0)
+						return 0;
+					std::copy_n(buf, std::min<size_t>(actual, length), buffer);
+					return std::min<size_t>(actual, length);
+				});
+		if (!len)
+			break;
+
+		// receiving a frame may stop the poll timer
+		recv_cb(m_journal_frame.data(), int(len));
+	}
+}
+
+bool device_network_interface::has_receiver() const noexcept
+{
+	// a replayed journal supplies frames without a host interface
+	return m_dev || (m_journal && m_journal->replaying());
 }
 
 void device_network_interface::start_net_device()
 {
 	// Set device polling time to transfer time for one MTU
-	m_dev->start();
+	if (m_dev)
+		m_dev->start();
 	const attotime interval = attotime::from_hz(m_bandwidth / m_mtu);
 	m_poll_timer->adjust(attotime::zero, 0, interval);
 }
@@ -94,7 +134,8 @@ void device_network_interface::start_net_device()
 void device_network_interface::stop_net_device()
 {
 	m_poll_timer->reset();
-	m_dev->stop();
+	if (m_dev)
+		m_dev->stop();
 }
 
 TIMER_CALLBACK_MEMBER(device_network_interface::send_complete)
@@ -116,7 +157,7 @@ void device_network_interface::recv_cb(u8 *buf, int len)
 	if (result)
 	{
 		// stop receiving more data from the network
-		if (m_dev)
+		if (has_receiver())
 			stop_net_device();
 
 		// schedule receive complete callback
@@ -129,7 +170,7 @@ TIMER_CALLBACK_MEMBER(device_network_interface::recv_complete)
 	recv_complete_cb(param);
 
 	// start receiving data from the network again
-	if (m_dev && !m_loopback_control)
+	if (has_receiver() && !m_loopback_control)
 		start_net_device();
 }
 
@@ -149,20 +190,17 @@ void device_network_interface::set_mac(const u8 *mac)
 
 void device_network_interface::set_interface(int id)
 {
-	if (m_dev)
+	if (has_receiver())
 		stop_net_device();
 
 	m_dev.reset(open_netdev(id, *this));
-	if (m_dev)
-	{
-		if (!m_loopback_control)
-			start_net_device();
-	}
-	else
+	if (!m_dev)
 	{
 		device().logerror("Network interface %d not found\n", id);
 		id = -1;
 	}
+	if (has_receiver() && !m_loopback_control)
+		start_net_device();
 	m_intf = id;
 }
 
@@ -173,7 +211,7 @@ void device_network_interface::set_loopback(bool loopback)
 
 	m_loopback_control = loopback;
 
-	if (m_dev)
+	if (has_receiver())
 	{
 		if (loopback)
 			stop_net_device();
@@ -49,6 +49,7 @@ private:
 	TIMER_CALLBACK_MEMBER(send_complete);
 	TIMER_CALLBACK_MEMBER(recv_complete);
 
+	bool has_receiver() const noexcept;
 	void start_net_device();
 	void stop_net_device();
 
@@ -56,6 +57,8 @@ private:
 	emu_timer *m_poll_timer;
 	emu_timer *m_send_timer;
 	emu_timer *m_recv_timer;
+	journal_channel *m_journal;
+	std::vector<u8> m_journal_frame;
 };
 
 
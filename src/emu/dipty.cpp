@@ -11,11 +11,15 @@
 #include "emu.h"
 #include "dipty.h"
 
+#include "iopoll.h"
+#include "journal.h"
+
 device_pty_interface::device_pty_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "pty")
 	, m_pty_master()
 	, m_slave_name()
 	, m_opened(false)
+	, m_journal(nullptr)
 {
 }
 
@@ -23,6 +27,11 @@ device_pty_interface::~device_pty_interface()
 {
 }
 
+void device_pty_interface::interface_pre_start()
+{
+	m_journal = device().machine().journal().channel(std::string("pty:") + device().tag());
+}
+
 bool device_pty_interface::open()
 {
 	if (!m_opened)
@@ -42,6 +51,8 @@ bool device_pty_interface::open()
 
 void device_pty_interface::close()
 {
+	if (m_pty_master)
+		device().machine().iopoll().cancel(*m_pty_master);
 	m_pty_master.reset();
 	m_opened = false;
 }
@@ -52,6 +63,17 @@ bool device_pty_interface::is_open() const
 }
 
 ssize_t device_pty_interface::read(u8 *rx_chars , size_t count) const
+{
+	if (m_journal)
+	{
+		// replay doesn't need the pty to be open
+		size_t const actual = m_journal->input(rx_chars, count, [this] (u8 *buffer, size_t length) { return size_t(std::max<ssize_t>(host_read(buffer, length), 0)); });
+		return (actual || m_opened || m_journal->replaying()) ? ssize_t(actual) : -1;
+	}
+	return host_read(rx_chars, count);
+}
+
+ssize_t device_pty_interface::host_read(u8 *rx_chars, size_t count) const
 {
 	u32 actual_bytes;
 	if (m_opened && !m_pty_master->read(rx_chars, 0, count, actual_bytes))
@@ -67,6 +89,18 @@ void device_pty_interface::write(u8 tx_char) const
 		m_pty_master->write(&tx_char, 0, 1, actual_bytes);
 }
 
+bool device_pty_interface::notify_readable(delegate<void ()> &&callback)
+{
+	if (m_journal)
+		return m_journal->notify(std::move(callback), [this] (delegate<void ()> &&cb) { return host_notify_readable(std::move(cb)); });
+	return host_notify_readable(std::move(callback));
+}
+
+bool device_pty_interface::host_notify_readable(delegate<void ()> &&callback)
+{
+	return m_opened && device().machine().iopoll().notify_readable(*m_pty_master, std::move(callback));
+}
+
 bool device_pty_interface::is_slave_connected() const
 {
 	// TODO: really check for slave status
@@ -30,14 +30,25 @@ public:
 	ssize_t read(u8 *rx_chars, size_t count) const;
 	void write(u8 tx_char) const;
 
+	// ask for a callback once there's data to read; if this returns false, poll with read instead
+	bool notify_readable(delegate<void ()> &&callback);
+
 	bool is_slave_connected() const;
 
 	const std::string &slave_name() const { return m_slave_name; }
 
 protected:
+	virtual void interface_pre_start() override;
+
 	osd_file::ptr m_pty_master;
 	std::string m_slave_name;
 	bool m_opened;
+
+private:
+	ssize_t host_read(u8 *rx_chars, size_t count) const;
+	bool host_notify_readable(delegate<void ()> &&callback);
+
+	journal_channel *m_journal;
 };
 
 // iterator
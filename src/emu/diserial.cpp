@@ -42,7 +42,8 @@ device_serial_interface::device_serial_interface(const machine_config &mconfig,
 	m_tra_rate(attotime::never),
 	m_rcv_line(0),
 	m_tra_clock_state(false),
-	m_rcv_clock_state(false)
+	m_rcv_clock_state(false),
+	m_character_peer(nullptr)
 {
 	/* if sum of all bits in the byte is even, then the data
 	has even parity, otherwise it has odd parity */
@@ -128,6 +129,30 @@ void device_serial_interface::tra_edge()
 	}
 }
 
+TIMER_CALLBACK_MEMBER(device_serial_interface::tra_clock)
+{
+	switch (param)
+	{
+	case TRA_CHARACTER_STARTED:
+		// run out the rest of the frame, finishing where the last bit edge would have
+		tra_character_started();
+		m_tra_clock->adjust(m_tra_rate * 2 * (m_tra_bit_count - 2), TRA_CHARACTER_DONE);
+		break;
+
+	case TRA_CHARACTER_DONE:
+		LOGMASKED(LOG_TX, "Transmitted frame in character mode (%s)\n", device().machine().time().to_string());
+		m_tra_bit_count_transmitted = m_tra_bit_count;
+		m_tra_flags |= TRANSMIT_REGISTER_EMPTY;
+		m_character_peer->receive_character(m_tra_register_data, m_tra_bit_count);
+		tra_complete();
+		break;
+
+	default:
+		tx_clock_w(!m_tra_clock_state);
+		break;
+	}
+}
+
 void device_serial_interface::rcv_edge()
 {
 	rcv_callback();
@@ -314,6 +339,7 @@ void device_serial_interface::receive_register_extract()
 
 	m_rcv_byte_received  = data;
 	LOGMASKED(LOG_RX, "Receive data 0x%02x\n", m_rcv_byte_received);
+	m_character_notifiers(false, data);
 
 	if(m_df_parity == PARITY_NONE)
 		return;
@@ -347,6 +373,48 @@ void device_serial_interface::receive_register_extract()
 }
 
 
+/* can the frame just set up be handed to the peer whole? both ends must agree on the
+   framing and rate, and the receiving end must be idle; otherwise it goes bit by bit so
+   anything line-level (breaks, mismatched settings) behaves as it would on real hardware */
+bool device_serial_interface::character_peer_ready() const
+{
+	device_serial_interface const *const peer = m_character_peer;
+	if (!character_peer_compatible())
+		return false;
+	if (m_tra_rate.is_never() || (m_tra_rate != peer->m_rcv_rate))
+		return false;
+	return (peer->m_rcv_flags & RECEIVE_REGISTER_WAITING_FOR_START_BIT) && peer->m_rcv_line;
+}
+
+/* is there a peer that can take whole characters with the same framing as this end? */
+bool device_serial_interface::character_peer_compatible() const
+{
+	device_serial_interface const *const peer = m_character_peer;
+	if (!peer || !character_mode_ok() || !peer->character_mode_ok())
+		return false;
+	if ((m_df_start_bit_count != 1) || !m_df_stop_bit_count)
+		return false;
+	return (m_df_start_bit_count == peer->m_df_start_bit_count) && (m_df_word_length == peer->m_df_word_length) &&
+			(m_df_parity == peer->m_df_parity) && (m_df_stop_bit_count == peer->m_df_stop_bit_count);
+}
+
+/* clock in a whole frame from the peer as if it had arrived on the line */
+void device_serial_interface::receive_character(u16 frame, u8 bit_count)
+{
+	if (!(m_rcv_flags & RECEIVE_REGISTER_WAITING_FOR_START_BIT) || !m_rcv_line)
+	{
+		LOGMASKED(LOG_RX, "Receiver busy, dropped frame from character mode peer\n");
+		return;
+	}
+
+	receive_register_update_bit(1); // idle line ahead of the start bit
+	for (int bit = bit_count - 1; (bit >= 0) && !is_receive_register_full(); bit--)
+		receive_register_update_bit(BIT(frame, bit));
+	if (is_receive_register_full())
+		rcv_complete();
+}
+
+
 /***** TRANSMIT REGISTER *****/
 
 void device_serial_interface::transmit_register_reset()
@@ -368,15 +436,50 @@ void device_serial_interface::transmit_register_add_bit(int bit)
 /* generate data in stream format ready for transfer */
 void device_serial_interface::transmit_register_setup(u8 data_byte)
 {
-	int i;
-	u8 transmit_data;
+	transmit_register_build(data_byte);
 
 	if(m_tra_clock && !m_tra_rate.is_never())
-		m_tra_clock->adjust(m_tra_rate, 0, m_tra_rate);
+	{
+		// in character mode the end of the start bit is the first edge anyone can see (the first rising edge is half a bit in)
+		if (character_peer_ready())
+			m_tra_clock->adjust(m_tra_rate * 3, TRA_CHARACTER_STARTED);
+		else
+			m_tra_clock->adjust(m_tra_rate, TRA_CLOCK_EDGE, m_tra_rate);
+	}
+}
+
+/* hand a character straight to the peer with no frame time at all, if it can take one now */
+bool device_serial_interface::transmit_character_unthrottled(u8 data_byte)
+{
+	device_serial_interface *const peer = m_character_peer;
+	if (!is_transmit_register_empty() || !character_peer_compatible())
+		return false;
+	if (!(peer->m_rcv_flags & RECEIVE_REGISTER_WAITING_FOR_START_BIT) || !peer->m_rcv_line || !peer->rcv_character_ready())
+		return false;
+
+	transmit_register_build(data_byte);
+	m_tra_bit_count_transmitted = m_tra_bit_count;
+	m_tra_flags |= TRANSMIT_REGISTER_EMPTY;
+	peer->receive_character(m_tra_register_data, m_tra_bit_count);
+	return true;
+}
+
+/* tell the peer this end has room for another character */
+void device_serial_interface::rcv_character_consumed()
+{
+	if (m_character_peer)
+		m_character_peer->tra_peer_ready();
+}
+
+void device_serial_interface::transmit_register_build(u8 data_byte)
+{
+	int i;
+	u8 transmit_data;
 
 	m_tra_bit_count_transmitted = 0;
 	m_tra_bit_count = 0;
 	m_tra_flags &=~TRANSMIT_REGISTER_EMPTY;
+	m_character_notifiers(true, u8(data_byte & ~(0xff << m_df_word_length)));
 
 	/* start bit */
 	for (i=0; i<m_df_start_bit_count; i++)
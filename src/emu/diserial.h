@@ -81,6 +81,13 @@ public:
 	void rx_clock_w(int state);
 	void clock_w(int state);
 
+	// character mode: frames go to the device at the other end of the link whole rather than bit by bit
+	void set_character_peer(device_serial_interface *peer) { m_character_peer = peer; }
+
+	// observe characters as they're transmitted (true) or received (false), in either mode
+	util::notifier_subscription add_character_notifier(delegate<void (bool, u8)> &&n) { return m_character_notifiers.subscribe(std::move(n)); }
+	template <typename T> util::notifier_subscription add_character_notifier(T &&n) { return add_character_notifier(delegate<void (bool, u8)>(std::forward<T>(n))); }
+
 protected:
 	void set_data_frame(int start_bit_count, int data_bit_count, parity_t parity, stop_bits_t stop_bits);
 
@@ -102,6 +109,9 @@ protected:
 	void transmit_register_add_bit(int bit);
 	void transmit_register_setup(u8 data_byte);
 	u8 transmit_register_get_data_bit();
+	bool transmit_character_unthrottled(u8 data_byte);
+	bool character_peer_compatible() const;
+	void rcv_character_consumed();
 
 	u8 serial_helper_get_parity(u8 data) { return m_serial_parity_table[data]; }
 
@@ -119,6 +129,16 @@ protected:
 	virtual void tra_complete() { }
 	virtual void rcv_complete() { }
 
+	// character mode support; a device that does more than drive its line in tra_callback
+	// must do the equivalent in tra_character_started, which is called at the end of the start bit
+	virtual bool character_mode_ok() const { return false; }
+	virtual void tra_character_started() { }
+
+	// unthrottled transfers; a receiver that can't always take a character reports when it can
+	// and calls rcv_character_consumed when space frees up, which reaches the peer as tra_peer_ready
+	virtual bool rcv_character_ready() const { return true; }
+	virtual void tra_peer_ready() { }
+
 	// interface-level overrides
 	virtual void interface_pre_start() override;
 	virtual void interface_post_start() override;
@@ -129,8 +149,15 @@ protected:
 	const char *stop_bits_tostring(stop_bits_t stop_bits);
 
 private:
+	enum
+	{
+		TRA_CLOCK_EDGE = 0,
+		TRA_CHARACTER_STARTED,
+		TRA_CHARACTER_DONE
+	};
+
 	TIMER_CALLBACK_MEMBER(rcv_clock) { rx_clock_w(!m_rcv_clock_state); }
-	TIMER_CALLBACK_MEMBER(tra_clock) { tx_clock_w(!m_tra_clock_state); }
+	TIMER_CALLBACK_MEMBER(tra_clock);
 
 	u8 m_serial_parity_table[256];
 
@@ -177,8 +204,14 @@ private:
 
 	int m_tra_clock_state, m_rcv_clock_state;
 
+	device_serial_interface *m_character_peer;
+	util::notifier<bool, u8> m_character_notifiers;
+
 	void tra_edge();
 	void rcv_edge();
+	bool character_peer_ready() const;
+	void transmit_register_build(u8 data_byte);
+	void receive_character(u16 frame, u8 bit_count);
 };
 
 
@@ -459,7 +459,7 @@ void device_mixer_interface::interface_pre_start()
 	m_output_clear.resize(m_outputs);
 
 	// allocate the mixer stream
-	m_mixer_stream = stream_alloc(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate(), STREAM_DEFAULT_FLAGS);
+	m_mixer_stream = stream_alloc(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate(), STREAM_PARALLEL_SAFE);
 }
 
 
@@ -84,6 +84,9 @@ class debug_watchpoint;
 class debug_registerpoint;
 class debug_exceptionpoint;
 
+// declared in debug/reverse.h
+class debug_reverse;
+
 // declared in debugger.h
 class debugger_manager;
 
@@ -161,6 +164,9 @@ class input_device_item;
 // declared in image.h
 class image_manager;
 
+// declared in iopoll.h
+class io_poll_manager;
+
 // declared in ioport.h
 class analog_field;
 struct input_device_default;
@@ -171,6 +177,10 @@ class ioport_manager;
 class ioport_port;
 struct ioport_port_live;
 
+// declared in journal.h
+class journal_channel;
+class journal_manager;
+
 // declared in machine.h
 class running_machine;
 
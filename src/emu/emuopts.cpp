@@ -74,6 +74,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     core_options::option_type::STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     core_options::option_type::STRING,     "record an input file" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         core_options::option_type::BOOLEAN,    "close the program at the end of playback" },
+	{ OPTION_JOURNAL,                                    nullptr,     core_options::option_type::STRING,     "record a journal of all host inputs" },
+	{ OPTION_JOURNAL_KEYFRAME,                           "60",        core_options::option_type::INTEGER,    "seconds of emulated time between journal keyframe save states; 0 disables them" },
+	{ OPTION_REPLAY,                                     nullptr,     core_options::option_type::STRING,     "replay a journal of host inputs" },
+	{ OPTION_REPLAY_KEYFRAME,                            "0",         core_options::option_type::INTEGER,    "journal keyframe to start replaying from; 0 starts at the beginning" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,     core_options::option_type::PATH,       "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,     core_options::option_type::PATH,       "optional filename to write an AVI movie of the current session" },
@@ -146,6 +150,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_VOLUME ";vol",                              "0",         core_options::option_type::INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
 	{ OPTION_COMPRESSOR,                                 "1",         core_options::option_type::BOOLEAN,    "enable compressor for sound" },
 	{ OPTION_SPEAKER_REPORT "(0-4)",                     "0",         core_options::option_type::INTEGER,    "print report of speaker ouput maxima (0=none, or 1-4 for more detail)" },
+	{ OPTION_STREAM_REPORT,                              "0",         core_options::option_type::BOOLEAN,    "print report of time spent updating each sound stream" },
 
 	// input options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE INPUT OPTIONS" },
@@ -187,6 +192,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UPDATEINPAUSE,                              "0",         core_options::option_type::BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,     core_options::option_type::PATH,       "script for debugger" },
 	{ OPTION_DEBUGLOG,                                   "0",         core_options::option_type::BOOLEAN,    "write debug console output to debug.log" },
+	{ OPTION_COVERAGE,                                   nullptr,     core_options::option_type::PATH,       "write instruction coverage of Musashi 68k CPUs to this file on exit" },
+	{ OPTION_COVERAGE_FORMAT,                            "drcov",     core_options::option_type::STRING,     "instruction coverage file format (drcov|lcov)" },
 
 	// comm options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE COMM OPTIONS" },
@@ -212,6 +219,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_MOUSE,                                   "1",         core_options::option_type::BOOLEAN,    "display UI mouse cursor" },
 	{ OPTION_LANGUAGE ";lang",                           "",          core_options::option_type::STRING,     "set UI display language" },
 	{ OPTION_NVRAM_SAVE ";nvwrite",                      "1",         core_options::option_type::BOOLEAN,    "save NVRAM data on exit" },
+	{ OPTION_HD_OVERLAY,                                 "none",      core_options::option_type::STRING,     "hold hard disk writes in a copy-on-write overlay (none|memory|writeback)" },
+	{ OPTION_HD_MMAP,                                    "0",         core_options::option_type::BOOLEAN,    "access raw hard disk images through a memory mapping" },
+	{ OPTION_HD_READAHEAD "(0-65536)",                   "0",         core_options::option_type::INTEGER,    "kilobytes to prefetch ahead of sequential reads from memory-mapped hard disk images" },
+	{ OPTION_RTC_BASE_TIME,                              "0",         core_options::option_type::INTEGER,    "fixed starting time for real-time clocks, in seconds since 1970-01-01 00:00 UTC (0 = use host time)" },
 
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "SCRIPTING OPTIONS" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     core_options::option_type::STRING,     "command to execute after machine boot" },
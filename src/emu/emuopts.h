@@ -57,6 +57,10 @@
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
+#define OPTION_JOURNAL              "journal"
+#define OPTION_JOURNAL_KEYFRAME     "journal_keyframe"
+#define OPTION_REPLAY               "replay"
+#define OPTION_REPLAY_KEYFRAME      "replay_keyframe"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #define OPTION_WAVWRITE             "wavwrite"
@@ -121,6 +125,7 @@
 #define OPTION_VOLUME               "volume"
 #define OPTION_COMPRESSOR           "compressor"
 #define OPTION_SPEAKER_REPORT       "speaker_report"
+#define OPTION_STREAM_REPORT        "stream_report"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -159,6 +164,8 @@
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
 #define OPTION_DEBUGLOG             "debuglog"
+#define OPTION_COVERAGE             "coverage"
+#define OPTION_COVERAGE_FORMAT      "coverage_format"
 
 // core misc options
 #define OPTION_DRC                  "drc"
@@ -172,6 +179,10 @@
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
 #define OPTION_NVRAM_SAVE           "nvram_save"
+#define OPTION_HD_OVERLAY           "hd_overlay"
+#define OPTION_HD_MMAP              "hd_mmap"
+#define OPTION_HD_READAHEAD         "hd_readahead"
+#define OPTION_RTC_BASE_TIME        "rtc_base_time"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -343,6 +354,10 @@ public:
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
+	const char *journal() const { return value(OPTION_JOURNAL); }
+	int journal_keyframe() const { return int_value(OPTION_JOURNAL_KEYFRAME); }
+	const char *replay() const { return value(OPTION_REPLAY); }
+	int replay_keyframe() const { return int_value(OPTION_REPLAY_KEYFRAME); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
@@ -407,6 +422,7 @@ public:
 	int volume() const { return int_value(OPTION_VOLUME); }
 	bool compressor() const { return bool_value(OPTION_COMPRESSOR); }
 	int speaker_report() const { return int_value(OPTION_SPEAKER_REPORT); }
+	bool stream_report() const { return bool_value(OPTION_STREAM_REPORT); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -443,6 +459,8 @@ public:
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
 	bool debuglog() const { return bool_value(OPTION_DEBUGLOG); }
+	const char *coverage() const { return value(OPTION_COVERAGE); }
+	const char *coverage_format() const { return value(OPTION_COVERAGE_FORMAT); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
@@ -456,6 +474,10 @@ public:
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
 	bool nvram_save() const { return bool_value(OPTION_NVRAM_SAVE); }
+	const char *hd_overlay() const { return value(OPTION_HD_OVERLAY); }
+	bool hd_mmap() const { return bool_value(OPTION_HD_MMAP); }
+	int hd_readahead() const { return int_value(OPTION_HD_READAHEAD); }
+	int rtc_base_time() const { return int_value(OPTION_RTC_BASE_TIME); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
@@ -0,0 +1,182 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    iopoll.cpp
+
+    Readiness notification for host-side stream files.
+
+    A thread sleeps in the OSD poller and flags files as they become
+    readable.  The callbacks are run on the emulation thread between
+    timeslices, so devices never see them in the middle of executing.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "iopoll.h"
+
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+
+//**************************************************************************
+//  I/O POLL MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  io_poll_manager - constructor
+//-------------------------------------------------
+
+io_poll_manager::io_poll_manager(running_machine &machine)
+	: m_machine(machine)
+	, m_unsupported(false)
+	, m_failed(false)
+	, m_pending(false)
+	, m_exiting(false)
+{
+}
+
+
+//-------------------------------------------------
+//  ~io_poll_manager - destructor
+//-------------------------------------------------
+
+io_poll_manager::~io_poll_manager()
+{
+	if (m_thread.joinable())
+	{
+		m_exiting.store(true, std::memory_order_release);
+		m_poller->interrupt();
+		m_thread.join();
+	}
+}
+
+
+//-------------------------------------------------
+//  notify_readable - arm a file for a single
+//  notification
+//-------------------------------------------------
+
+bool io_poll_manager::notify_readable(osd_file &file, notify_delegate &&callback)
+{
+	// start the poll thread the first time anyone asks
+	if (!m_poller)
+	{
+		if (m_unsupported)
+			return false;
+
+		std::error_condition const err = osd_file_poller::create(m_poller);
+		if (err)
+		{
+			osd_printf_verbose("I/O readiness notification unavailable (%s), falling back to polling\n", err.message());
+			m_unsupported = true;
+			return false;
+		}
+
+		try
+		{
+			m_thread = std::thread([this] () { poll_thread(); });
+		}
+		catch (std::system_error const &)
+		{
+			m_poller.reset();
+			m_unsupported = true;
+			return false;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_failed || m_poller->arm(file, &file))
+	{
+		m_watches.erase(&file);
+		return false;
+	}
+	m_watches.insert_or_assign(&file, watch{ std::move(callback), false });
+	return true;
+}
+
+
+//-------------------------------------------------
+//  cancel - stop watching a file
+//-------------------------------------------------
+
+void io_poll_manager::cancel(osd_file &file)
+{
+	if (!m_poller)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_watches.erase(&file))
+		m_poller->disarm(file);
+}
+
+
+//-------------------------------------------------
+//  poll_thread - wait for files to become
+//  readable and flag them for the emulation
+//  thread
+//-------------------------------------------------
+
+void io_poll_manager::poll_thread()
+{
+	std::vector<void *> ready;
+	while (!m_exiting.load(std::memory_order_acquire))
+	{
+		std::error_condition const err = m_poller->wait(std::chrono::milliseconds(-1), ready);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (err && (err != std::errc::interrupted))
+		{
+			// give up rather than spin; waking every file makes its device
+			// try to arm it again, which fails, so it goes back to polling
+			osd_printf_error("I/O readiness notification failed (%s), falling back to polling\n", err.message());
+			m_failed = true;
+			for (auto &watch : m_watches)
+				watch.second.ready = true;
+			m_pending.store(true, std::memory_order_release);
+			return;
+		}
+
+		for (void *const cookie : ready)
+		{
+			// files cancelled since the wait began won't be found
+			auto const found = m_watches.find(reinterpret_cast<osd_file *>(cookie));
+			if (found != m_watches.end())
+			{
+				found->second.ready = true;
+				m_pending.store(true, std::memory_order_release);
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  deliver - run callbacks for files that have
+//  become readable
+//-------------------------------------------------
+
+void io_poll_manager::deliver()
+{
+	std::vector<notify_delegate> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.store(false, std::memory_order_relaxed);
+		for (auto it = m_watches.begin(); m_watches.end() != it; )
+		{
+			if (it->second.ready)
+			{
+				callbacks.emplace_back(std::move(it->second.callback));
+				it = m_watches.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	// callbacks may arm their files again
+	for (notify_delegate &callback : callbacks)
+		callback();
+}
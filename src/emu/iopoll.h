@@ -0,0 +1,71 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    iopoll.h
+
+    Readiness notification for host-side stream files.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_IOPOLL_H
+#define MAME_EMU_IOPOLL_H
+
+#pragma once
+
+#include "osdfile.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+// ======================> io_poll_manager
+
+class io_poll_manager
+{
+public:
+	typedef delegate<void ()> notify_delegate;
+
+	// construction/destruction
+	io_poll_manager(running_machine &machine);
+	~io_poll_manager();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+
+	// ask for a single callback on the emulation thread once the file has
+	// data to read; returns false if the host or the file can't do this,
+	// in which case the caller has to keep polling
+	bool notify_readable(osd_file &file, notify_delegate &&callback);
+
+	// forget a file before closing it
+	void cancel(osd_file &file);
+
+	// deliver notifications that have arrived since the last call
+	void dispatch() { if (m_pending.load(std::memory_order_acquire)) deliver(); }
+
+private:
+	struct watch
+	{
+		notify_delegate callback;
+		bool ready;
+	};
+
+	void poll_thread();
+	void deliver();
+
+	// internal state
+	running_machine &   m_machine;                  // reference to our machine
+	osd_file_poller::ptr m_poller;                  // OSD readiness notification
+	bool                m_unsupported;              // host can't notify us
+	bool                m_failed;                   // poll thread gave up
+	std::thread         m_thread;                   // thread waiting for notifications
+	std::mutex          m_mutex;                    // protects the watch list
+	std::unordered_map<osd_file *, watch> m_watches; // armed files
+	std::atomic<bool>   m_pending;                  // some files are ready
+	std::atomic<bool>   m_exiting;                  // poll thread should exit
+};
+
+#endif // MAME_EMU_IOPOLL_H
@@ -14,6 +14,7 @@
 #include "emuopts.h"
 #include "fileio.h"
 #include "inputdev.h"
+#include "journal.h"
 #include "main.h"
 #include "natkeyboard.h"
 #include "profiler.h"
@@ -1736,7 +1737,8 @@ void ioport_port::update_defvalue(bool flush_defaults)
 ioport_port_live::ioport_port_live(ioport_port &port) :
 	defvalue(0),
 	digital(0),
-	outputvalue(0)
+	outputvalue(0),
+	journal(nullptr)
 {
 	// iterate over fields
 	for (ioport_field &field : port.fields())
@@ -1866,6 +1868,10 @@ time_t ioport_manager::initialize()
 	// open playback and record files if specified
 	time_t basetime = playback_init();
 	record_init();
+
+	// journal each port separately so unchanged ports cost nothing
+	for (auto &port : m_portlist)
+		port.second->live().journal = machine().journal().channel(std::string("ioport:") + port.first);
 	return basetime;
 }
 
@@ -2186,6 +2192,7 @@ void ioport_manager::frame_update()
 		// handle playback/record
 		playback_port(*port.second.get());
 		record_port(*port.second.get());
+		journal_port(*port.second.get());
 
 		// call device line write handlers
 		ioport_value newvalue = port.second->read();
@@ -3253,6 +3260,52 @@ void ioport_manager::record_port(ioport_port &port)
 }
 
 
+//-------------------------------------------------
+//  journal_port - per-port callback for the
+//  input journal
+//-------------------------------------------------
+
+void ioport_manager::journal_port(ioport_port &port)
+{
+	ioport_port_live &live = port.live();
+	if (!live.journal)
+		return;
+
+	// the same state that INP files record, in a fixed byte order
+	m_journal_state.resize(8 + 13 * live.analoglist.size());
+	u8 *dest = m_journal_state.data();
+	put_u32le(dest + 0, live.defvalue);
+	put_u32le(dest + 4, live.digital);
+	dest += 8;
+	for (analog_field &analog : live.analoglist)
+	{
+		put_u32le(dest + 0, analog.m_accum);
+		put_u32le(dest + 4, analog.m_previous);
+		put_u32le(dest + 8, analog.m_sensitivity);
+		dest[12] = analog.m_reverse ? 1 : 0;
+		dest += 13;
+	}
+
+	// when replaying this brings back the recorded state
+	live.journal->sample(m_journal_state);
+	if (m_journal_state.size() != (8 + 13 * live.analoglist.size()))
+		return;
+
+	u8 const *src = m_journal_state.data();
+	live.defvalue = get_u32le(src + 0);
+	live.digital = get_u32le(src + 4);
+	src += 8;
+	for (analog_field &analog : live.analoglist)
+	{
+		analog.m_accum = s32(get_u32le(src + 0));
+		analog.m_previous = s32(get_u32le(src + 4));
+		analog.m_sensitivity = s32(get_u32le(src + 8));
+		analog.m_reverse = src[12] != 0;
+		src += 13;
+	}
+}
+
+
 
 //**************************************************************************
 //  I/O PORT CONFIGURER
@@ -919,6 +919,7 @@ struct ioport_port_live
 	ioport_value            defvalue;           // combined default value across the port
 	ioport_value            digital;            // current value from all digital inputs
 	ioport_value            outputvalue;        // current value for outputs
+	journal_channel *       journal;            // input journal channel (nullptr if not journalling)
 };
 
 
@@ -996,6 +997,8 @@ private:
 	void record_frame(const attotime &curtime);
 	void record_port(ioport_port &port);
 
+	void journal_port(ioport_port &port);
+
 	// internal state
 	running_machine &       m_machine;              // reference to owning machine
 	bool                    m_safe_to_read;         // clear at start; set after state is loaded
@@ -1019,6 +1022,7 @@ private:
 	util::read_stream::ptr  m_playback_stream;      // playback stream (nullptr if not recording)
 	u64                     m_playback_accumulated_speed; // accumulated speed during playback
 	u32                     m_playback_accumulated_frames; // accumulated frames during playback
+	std::vector<u8>         m_journal_state;        // scratch buffer for journalled port states
 
 	// storage for inactive configuration
 	std::unique_ptr<util::xml::file> m_deselected_card_config;
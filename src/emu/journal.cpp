@@ -0,0 +1,1072 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    journal.cpp
+
+    Record/replay journal for non-deterministic inputs.
+
+    When replaying, the header of the next record is read ahead and a
+    timer is set for its time.  Records are taken off the stream once
+    emulated time reaches them, either when the timer fires or when a
+    channel asks for input, and queued on their channels.  Wake-ups
+    are only delivered from the timer, so devices never see a callback
+    in the middle of asking for input.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "journal.h"
+#include "journalfmt.h"
+
+#include "emuopts.h"
+#include "fileio.h"
+
+#include "util/ioprocsfilter.h"
+#include "util/multibyte.h"
+#include "util/path.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace {
+
+constexpr char JOURNAL_MAGIC[8] = { 'M', 'A', 'M', 'E', 'J', 'R', 'N', '1' };
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  JOURNAL CHANNEL
+//**************************************************************************
+
+//-------------------------------------------------
+//  journal_channel - constructor
+//-------------------------------------------------
+
+journal_channel::journal_channel(journal_manager &manager, std::string &&name)
+	: m_manager(manager)
+	, m_name(std::move(name))
+	, m_id(0)
+	, m_calls(0)
+	, m_last(0)
+	, m_waiting(false)
+	, m_polling(false)
+	, m_wake(false)
+	, m_host_ready(false)
+{
+}
+
+
+//-------------------------------------------------
+//  sample - log or replay a state
+//-------------------------------------------------
+
+void journal_channel::sample(std::vector<u8> &state)
+{
+	m_calls++;
+	if (replaying())
+	{
+		m_manager.pump();
+		while (!m_pending.empty() && (m_pending.front().index <= m_calls))
+		{
+			if (m_pending.front().index < m_calls)
+				m_manager.out_of_sync(*this);
+			m_state = std::move(m_pending.front().data);
+			m_pending.pop_front();
+		}
+		if (!m_state.empty())
+			state = m_state;
+	}
+	else if (state != m_state)
+	{
+		m_state = state;
+		record_data(state.data(), state.size());
+	}
+}
+
+
+//-------------------------------------------------
+//  replay_input - take logged input for this
+//  call from the queue
+//-------------------------------------------------
+
+size_t journal_channel::replay_input(u8 *buffer, size_t length)
+{
+	m_manager.pump();
+
+	// data for calls we've already passed means we've lost track
+	while (!m_pending.empty() && (m_pending.front().index < m_calls))
+	{
+		m_manager.out_of_sync(*this);
+		m_pending.pop_front();
+	}
+	if (m_pending.empty() || (m_pending.front().index != m_calls))
+		return 0;
+
+	std::vector<u8> const &data = m_pending.front().data;
+	if (data.size() > length)
+		m_manager.out_of_sync(*this);
+	size_t const actual = std::min(data.size(), length);
+	std::copy_n(data.begin(), actual, buffer);
+	m_pending.pop_front();
+	return actual;
+}
+
+
+//-------------------------------------------------
+//  replay_notify - park the callback until the
+//  journal says the host woke us up
+//-------------------------------------------------
+
+bool journal_channel::replay_notify()
+{
+	m_manager.pump();
+	m_waiting = !m_polling;
+	return m_waiting;
+}
+
+
+//-------------------------------------------------
+//  record_data - log input from the host
+//-------------------------------------------------
+
+void journal_channel::record_data(const u8 *data, size_t length)
+{
+	if (!m_manager.recording())
+		return;
+
+	m_manager.announce(*this);
+	m_manager.write_record(journal_manager::RECORD_DATA, m_id);
+	m_manager.write_number(m_calls - m_last);
+	m_manager.write_number(length);
+	m_manager.write_bytes(data, length);
+	m_last = m_calls;
+}
+
+
+//-------------------------------------------------
+//  host_ready - the host says input is ready
+//  while recording
+//-------------------------------------------------
+
+void journal_channel::host_ready()
+{
+	// the device doesn't hear about it until history catches up
+	if (m_manager.m_rewound)
+	{
+		m_host_ready = true;
+		return;
+	}
+
+	m_waiting = false;
+	if (m_manager.recording())
+	{
+		m_manager.announce(*this);
+		m_manager.write_record(journal_manager::RECORD_WAKE, m_id);
+	}
+
+	// the callback may ask to be notified again
+	notify_delegate const callback(m_callback);
+	callback();
+}
+
+
+
+//**************************************************************************
+//  JOURNAL MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  journal_manager - constructor
+//-------------------------------------------------
+
+journal_manager::journal_manager(running_machine &machine)
+	: m_machine(machine)
+	, m_active(false)
+	, m_time(attotime::zero)
+	, m_keyframes(0)
+	, m_keyframe_timer(nullptr)
+	, m_replaying(false)
+	, m_have_next(false)
+	, m_next_type(0)
+	, m_next_time(attotime::zero)
+	, m_next_id(0)
+	, m_next_offset(0)
+	, m_next_previous(attotime::zero)
+	, m_seeking(false)
+	, m_warned(false)
+	, m_replay_timer(nullptr)
+	, m_source(*this)
+	, m_keep_history(false)
+	, m_history_base(0)
+	, m_history_read(0)
+	, m_rewound(false)
+	, m_rewinding(false)
+{
+	bool const record = machine.options().journal()[0] != 0;
+	m_replaying = machine.options().replay()[0] != 0;
+	if (record && m_replaying)
+		fatalerror("Can't record and replay a journal at the same time\n");
+	m_active = record || m_replaying;
+
+	// id zero is never handed out
+	m_ids.push_back(nullptr);
+	m_id_names.emplace_back();
+}
+
+
+//-------------------------------------------------
+//  ~journal_manager - destructor
+//-------------------------------------------------
+
+journal_manager::~journal_manager()
+{
+}
+
+
+//-------------------------------------------------
+//  channel - find or create a channel
+//-------------------------------------------------
+
+journal_channel *journal_manager::channel(std::string_view name)
+{
+	if (!m_active)
+		return nullptr;
+
+	for (auto const &chan : m_channels)
+	{
+		if (chan->name() == name)
+			return chan.get();
+	}
+	journal_channel &chan = *m_channels.emplace_back(std::make_unique<journal_channel>(*this, std::string(name)));
+
+	// devices create their channels after a keyframe seek has read their ids
+	for (u32 id = 1; id < m_id_names.size(); id++)
+	{
+		if (m_id_names[id] == name)
+			m_ids[id] = &chan;
+	}
+	return &chan;
+}
+
+
+//-------------------------------------------------
+//  map_channel - associate a journal id with a
+//  channel name read from the journal
+//-------------------------------------------------
+
+journal_channel *journal_manager::map_channel(u32 id, std::string &&name)
+{
+	auto const found = std::find_if(m_channels.begin(), m_channels.end(), [&name] (auto const &c) { return c->name() == name; });
+	if (m_ids.size() <= id)
+	{
+		m_ids.resize(id + 1, nullptr);
+		m_id_names.resize(id + 1);
+	}
+	m_ids[id] = (found != m_channels.end()) ? found->get() : nullptr;
+	m_id_names[id] = std::move(name);
+	return m_ids[id];
+}
+
+
+//-------------------------------------------------
+//  start - open the journal once the base time
+//  is known
+//-------------------------------------------------
+
+void journal_manager::start(time_t &basetime)
+{
+	if (!m_active)
+		return;
+
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&journal_manager::exit, this));
+	machine().save().register_presave(save_prepost_delegate(FUNC(journal_manager::presave), this));
+	machine().save().register_postload(save_prepost_delegate(FUNC(journal_manager::postload), this));
+
+	// both timers exist in both modes so keyframes load in either
+	m_keyframe_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(journal_manager::keyframe_timer), this));
+	m_replay_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(journal_manager::replay_timer), this));
+
+	if (m_replaying)
+		basetime = replay_init();
+	else
+		record_init(basetime);
+}
+
+
+//-------------------------------------------------
+//  exit - close the journal
+//-------------------------------------------------
+
+void journal_manager::exit()
+{
+	record_end();
+	replay_end();
+}
+
+
+//-------------------------------------------------
+//  record_init - open the journal for recording
+//-------------------------------------------------
+
+void journal_manager::record_init(time_t basetime)
+{
+	const char *filename = machine().options().journal();
+
+	// open the journal file
+	m_file = std::make_unique<emu_file>(machine().options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	std::error_condition const filerr = m_file->open(filename);
+	if (filerr)
+		throw emu_fatalerror("journal_manager::record_init: Failed to open file for recording (%s:%d %s)", filerr.category().name(), filerr.value(), filerr.message());
+
+	// write the header
+	std::string_view const sysname = machine().system().name;
+	u8 header[sizeof(JOURNAL_MAGIC) + 1 + 255 + 8];
+	u8 const namelength = u8(std::min<size_t>(sysname.length(), 255));
+	std::memcpy(&header[0], JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+	header[sizeof(JOURNAL_MAGIC)] = namelength;
+	std::memcpy(&header[sizeof(JOURNAL_MAGIC) + 1], sysname.data(), namelength);
+	put_u64le(&header[sizeof(JOURNAL_MAGIC) + 1 + namelength], u64(s64(basetime)));
+	m_file->write(header, sizeof(JOURNAL_MAGIC) + 1 + namelength + 8);
+
+	// enable compression
+	m_record_stream = util::zlib_write(*m_file, 6, 16384);
+
+	// take keyframes periodically
+	m_keyframe_base = core_filename_extract_base(filename, true);
+	int const interval = machine().options().journal_keyframe();
+	if (interval > 0)
+	{
+		if (!(machine().system().flags & MACHINE_SUPPORTS_SAVE))
+			osd_printf_warning("Journal keyframes may not work because this system doesn't support save states\n");
+		m_keyframe_timer->adjust(attotime::from_seconds(interval), 0, attotime::from_seconds(interval));
+	}
+	osd_printf_info("Recording journal %s\n", filename);
+}
+
+
+//-------------------------------------------------
+//  record_end - stop recording
+//-------------------------------------------------
+
+void journal_manager::record_end(const char *message)
+{
+	if (m_record_stream)
+	{
+		m_record_stream.reset();
+		m_file.reset();
+		if (m_keyframe_timer)
+			m_keyframe_timer->reset();
+
+		if (message != nullptr)
+			machine().popmessage("Journal Recording Ended\nReason: %s", message);
+	}
+}
+
+
+//-------------------------------------------------
+//  announce - give a channel an id, writing its
+//  name the first time
+//-------------------------------------------------
+
+void journal_manager::announce(journal_channel &chan)
+{
+	if (chan.m_id != 0)
+		return;
+
+	chan.m_id = u32(m_ids.size());
+	m_ids.push_back(&chan);
+	write_record(RECORD_CHANNEL, chan.m_id);
+	write_number(chan.name().length());
+	write_bytes(chan.name().data(), chan.name().length());
+}
+
+
+//-------------------------------------------------
+//  write_record - write a record type, time and
+//  channel
+//-------------------------------------------------
+
+void journal_manager::write_record(u8 type, u32 id)
+{
+	if (!m_record_stream)
+		return;
+
+	attotime const now = machine().time();
+	auto const [seconds, attoseconds] = journal_format::encode_time(m_time, now);
+	write_bytes(&type, 1);
+	write_number(seconds);
+	write_number(attoseconds);
+	write_number(id);
+	m_time = now;
+}
+
+
+//-------------------------------------------------
+//  write_number - write an unsigned LEB128 value
+//-------------------------------------------------
+
+void journal_manager::write_number(u64 value)
+{
+	u8 buffer[10];
+	write_bytes(buffer, journal_format::encode_number(buffer, value));
+}
+
+
+//-------------------------------------------------
+//  write_bytes - write raw data, stopping the
+//  recording on error
+//-------------------------------------------------
+
+void journal_manager::write_bytes(const void *data, size_t length)
+{
+	if (!m_record_stream || m_rewound)
+		return;
+
+	if (util::write(*m_record_stream, data, length).first)
+		record_end("Write error");
+	else if (m_keep_history)
+		m_history.insert(m_history.end(), reinterpret_cast<const u8 *>(data), reinterpret_cast<const u8 *>(data) + length);
+}
+
+
+//-------------------------------------------------
+//  keyframe_timer - ask for a keyframe save
+//  state
+//-------------------------------------------------
+
+TIMER_CALLBACK_MEMBER(journal_manager::keyframe_timer)
+{
+	// the timer comes back armed when a keyframe is loaded for replay
+	if (!m_record_stream)
+	{
+		m_keyframe_timer->reset();
+		return;
+	}
+	if (m_rewound)
+		return;
+
+	if (m_keyframe_pending.empty())
+	{
+		m_keyframe_pending = util::string_format("%s-%u", m_keyframe_base, m_keyframes + 1);
+		machine().schedule_save(std::string(m_keyframe_pending));
+	}
+}
+
+
+//-------------------------------------------------
+//  presave - mark the journal position of a
+//  keyframe
+//-------------------------------------------------
+
+void journal_manager::presave()
+{
+	if (!recording() || m_keyframe_pending.empty())
+		return;
+
+	// every channel needs an id so its counts can be restored
+	for (auto const &chan : m_channels)
+		announce(*chan);
+
+	write_record(RECORD_KEYFRAME, 0);
+	write_number(++m_keyframes);
+	write_number(m_keyframe_pending.length());
+	write_bytes(m_keyframe_pending.data(), m_keyframe_pending.length());
+	write_number(m_channels.size());
+	for (auto const &chan : m_channels)
+	{
+		write_number(chan->m_id);
+		write_number(chan->m_calls);
+		write_number(chan->m_last);
+		write_number((chan->m_waiting ? KEYFRAME_WAITING : 0) | (chan->m_polling ? KEYFRAME_POLLING : 0));
+
+		// sampled states are logged in full after a keyframe
+		chan->m_state.clear();
+	}
+	m_keyframe_pending.clear();
+}
+
+
+//-------------------------------------------------
+//  replay_init - open the journal for replay
+//  and return the recorded base time
+//-------------------------------------------------
+
+time_t journal_manager::replay_init()
+{
+	const char *filename = machine().options().replay();
+
+	// open the journal file
+	m_file = std::make_unique<emu_file>(machine().options().input_directory(), OPEN_FLAG_READ);
+	std::error_condition const filerr = m_file->open(filename);
+	if (filerr == std::errc::no_such_file_or_directory)
+		fatalerror("Journal file %s not found\n", filename);
+	if (filerr)
+		fatalerror("Failed to open file %s for replay (%s:%d %s)\n", filename, filerr.category().name(), filerr.value(), filerr.message());
+
+	// read and check the header
+	u8 magic[sizeof(JOURNAL_MAGIC) + 1];
+	char sysname[256];
+	u8 basetime[8];
+	if ((m_file->read(magic, sizeof(magic)) != sizeof(magic)) || std::memcmp(magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)))
+		fatalerror("Journal file %s is invalid\n", filename);
+	if ((m_file->read(sysname, magic[sizeof(JOURNAL_MAGIC)]) != magic[sizeof(JOURNAL_MAGIC)]) || (m_file->read(basetime, sizeof(basetime)) != sizeof(basetime)))
+		fatalerror("Journal file %s is corrupt or invalid (missing header)\n", filename);
+	std::string_view const recorded(sysname, magic[sizeof(JOURNAL_MAGIC)]);
+	if (recorded != machine().system().name)
+		osd_printf_info("Journal file is for machine '%s', not for current machine '%s'\n", recorded, machine().system().name);
+	osd_printf_info("Replaying journal %s\n", filename);
+
+	// enable compression and read ahead
+	m_replay_stream = util::zlib_read(*m_file, 16384);
+	read_next();
+
+	// skip ahead to a keyframe if asked to
+	int const keyframe = machine().options().replay_keyframe();
+	if (keyframe > 0)
+		seek(keyframe);
+	if (m_have_next)
+		m_replay_timer->adjust(m_next_time);
+
+	return time_t(s64(get_u64le(basetime)));
+}
+
+
+//-------------------------------------------------
+//  replay_end - stop replaying
+//-------------------------------------------------
+
+void journal_manager::replay_end(const char *message)
+{
+	if (m_rewound && !m_replay_stream)
+		end_rewind();
+
+	if (m_replay_stream)
+	{
+		m_replay_stream.reset();
+		m_file.reset();
+		m_have_next = false;
+		if (m_replay_timer)
+			m_replay_timer->reset();
+
+		if (message != nullptr)
+			machine().popmessage("Journal Replay Ended\nReason: %s", message);
+
+		// close the program at the end of the journal
+		if (machine().options().exit_after_playback() && (machine().phase() == machine_phase::RUNNING))
+		{
+			osd_printf_info("Exiting MAME now...\n");
+			machine().schedule_exit();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  out_of_sync - report that replay has diverged
+//  from the recording
+//-------------------------------------------------
+
+void journal_manager::out_of_sync(journal_channel &chan)
+{
+	if (!m_warned)
+	{
+		m_warned = true;
+		osd_printf_warning("Journal replay out of sync on %s at %s\n", chan.name(), machine().time().as_string());
+		machine().popmessage("Journal replay out of sync");
+	}
+}
+
+
+//-------------------------------------------------
+//  read_next - read the next record's header
+//-------------------------------------------------
+
+void journal_manager::read_next()
+{
+	m_have_next = false;
+
+	// when recording, history runs out where the recording is up to
+	if (m_rewound && !m_replay_stream && (m_history_read == (m_history_base + m_history.size())))
+		end_rewind();
+	if (!m_replay_stream && !m_rewound)
+		return;
+
+	m_next_offset = history_offset();
+	m_next_previous = m_time;
+	u64 seconds, attoseconds, id;
+	auto const [err, actual] = util::read(m_source, &m_next_type, 1);
+	if (err || (actual != 1))
+	{
+		replay_end("End of journal");
+		return;
+	}
+	if (!read_number(seconds) || !read_number(attoseconds) || !read_number(id) || !journal_format::decode_time(m_time, seconds, attoseconds, m_next_time))
+	{
+		replay_end("Journal is corrupt");
+		return;
+	}
+
+	m_next_id = u32(id);
+	m_time = m_next_time;
+	m_have_next = true;
+}
+
+
+//-------------------------------------------------
+//  read_number - read an unsigned LEB128 value
+//-------------------------------------------------
+
+bool journal_manager::read_number(u64 &value)
+{
+	return journal_format::decode_number(m_source, value);
+}
+
+
+//-------------------------------------------------
+//  read_bytes - read raw data
+//-------------------------------------------------
+
+bool journal_manager::read_bytes(void *data, size_t length)
+{
+	auto const [err, actual] = util::read(m_source, data, length);
+	return !err && (actual == length);
+}
+
+
+//-------------------------------------------------
+//  read_string - read a length-prefixed string
+//-------------------------------------------------
+
+bool journal_manager::read_string(std::string &result)
+{
+	u64 length;
+	if (!read_number(length) || (length > 0x10000))
+		return false;
+	result.resize(length);
+	return read_bytes(result.data(), length);
+}
+
+
+//-------------------------------------------------
+//  read_keyframe - read the body of a keyframe
+//  record
+//-------------------------------------------------
+
+bool journal_manager::read_keyframe(u64 &index, std::string &name, std::vector<keyframe_channel> &channels)
+{
+	u64 count;
+	if (!read_number(index) || !read_string(name) || !read_number(count))
+		return false;
+
+	channels.clear();
+	for (u64 i = 0; i < count; i++)
+	{
+		u64 id, calls, last, flags;
+		if (!read_number(id) || !read_number(calls) || !read_number(last) || !read_number(flags))
+			return false;
+		channels.push_back(keyframe_channel{ u32(id), calls, last, u8(flags) });
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  pump - take records that are due off the
+//  stream and hand them to their channels
+//-------------------------------------------------
+
+void journal_manager::pump()
+{
+	attotime const now = machine().time();
+	bool wake = false;
+	while (m_have_next && (m_next_time <= now))
+	{
+		journal_channel *const chan = (m_next_id < m_ids.size()) ? m_ids[m_next_id] : nullptr;
+		bool ok = true;
+		switch (m_next_type)
+		{
+		case RECORD_CHANNEL:
+			{
+				std::string name;
+				ok = read_string(name);
+				if (ok)
+				{
+					// channels that don't exist here have their records dropped
+					if (!map_channel(m_next_id, std::string(name)))
+						osd_printf_warning("Journal channel %s doesn't exist in this machine\n", name);
+				}
+			}
+			break;
+
+		case RECORD_DATA:
+			{
+				u64 delta, length;
+				journal_channel::pending entry;
+				ok = read_number(delta) && read_number(length) && (length <= 0x1000000);
+				if (ok)
+				{
+					entry.data.resize(length);
+					ok = read_bytes(entry.data.data(), length);
+				}
+				if (ok && chan)
+				{
+					chan->m_last += delta;
+					entry.index = chan->m_last;
+					chan->m_pending.emplace_back(std::move(entry));
+				}
+			}
+			break;
+
+		case RECORD_WAKE:
+			if (chan)
+			{
+				chan->m_wake = true;
+				wake = true;
+			}
+			break;
+
+		case RECORD_POLL:
+			if (chan)
+				chan->m_polling = true;
+			break;
+
+		case RECORD_KEYFRAME:
+			{
+				u64 index;
+				std::string name;
+				std::vector<keyframe_channel> channels;
+				ok = read_keyframe(index, name, channels);
+			}
+			break;
+
+		default:
+			ok = false;
+			break;
+		}
+
+		if (!ok)
+		{
+			replay_end("Journal is corrupt");
+			break;
+		}
+		read_next();
+	}
+
+	// wake-ups are delivered from the timer
+	if (wake)
+		m_replay_timer->adjust(attotime::zero);
+	else if (m_have_next)
+		m_replay_timer->adjust(m_next_time - now);
+}
+
+
+//-------------------------------------------------
+//  seek - skip to a keyframe and load its state
+//-------------------------------------------------
+
+void journal_manager::seek(u64 index)
+{
+	while (m_have_next)
+	{
+		bool ok = true;
+		if (m_next_type == RECORD_CHANNEL)
+		{
+			std::string name;
+			ok = read_string(name);
+			if (ok)
+				map_channel(m_next_id, std::move(name)); // devices haven't started yet
+		}
+		else if (m_next_type == RECORD_DATA)
+		{
+			u64 delta, length;
+			std::vector<u8> data;
+			ok = read_number(delta) && read_number(length) && (length <= 0x1000000);
+			if (ok)
+			{
+				data.resize(length);
+				ok = read_bytes(data.data(), length);
+			}
+		}
+		else if (m_next_type == RECORD_KEYFRAME)
+		{
+			u64 found;
+			std::string name;
+			ok = read_keyframe(found, name, m_seek);
+			if (ok && (found == index))
+			{
+				// the channel counts are restored once the state has loaded
+				osd_printf_info("Replaying from journal keyframe %u (%s)\n", index, name);
+				m_seeking = true;
+				machine().schedule_load(std::move(name));
+				read_next();
+				return;
+			}
+		}
+		else if ((m_next_type != RECORD_WAKE) && (m_next_type != RECORD_POLL))
+		{
+			ok = false;
+		}
+
+		if (!ok)
+		{
+			replay_end("Journal is corrupt");
+			break;
+		}
+		read_next();
+	}
+	fatalerror("Journal keyframe %u not found\n", index);
+}
+
+
+//-------------------------------------------------
+//  replay_timer - take due records and deliver
+//  wake-ups
+//-------------------------------------------------
+
+TIMER_CALLBACK_MEMBER(journal_manager::replay_timer)
+{
+	pump();
+	for (auto const &chan : m_channels)
+	{
+		if (chan->m_host_ready && !m_rewound)
+		{
+			chan->m_host_ready = false;
+			chan->host_ready();
+		}
+		if (chan->m_wake)
+		{
+			chan->m_wake = false;
+			if (!chan->m_waiting || chan->m_callback.isnull())
+			{
+				out_of_sync(*chan);
+				continue;
+			}
+			chan->m_waiting = false;
+			journal_channel::notify_delegate const callback(chan->m_callback);
+			callback();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  postload - restore channel counts after a
+//  keyframe loads
+//-------------------------------------------------
+
+void journal_manager::postload()
+{
+	if (m_seeking)
+	{
+		m_seeking = false;
+		for (auto const &chan : m_channels)
+		{
+			chan->m_pending.clear();
+			chan->m_state.clear();
+			chan->m_wake = false;
+		}
+		for (keyframe_channel const &entry : m_seek)
+		{
+			journal_channel *const chan = (entry.id < m_ids.size()) ? m_ids[entry.id] : nullptr;
+			if (chan)
+			{
+				chan->m_calls = entry.calls;
+				chan->m_last = entry.last;
+				chan->m_waiting = (entry.flags & KEYFRAME_WAITING) != 0;
+				chan->m_polling = (entry.flags & KEYFRAME_POLLING) != 0;
+			}
+			else if (entry.id < m_id_names.size())
+			{
+				osd_printf_warning("Journal channel %s doesn't exist in this machine\n", m_id_names[entry.id]);
+			}
+		}
+		m_seek.clear();
+	}
+	else if (m_rewinding)
+	{
+		// rewind has already put the channels back
+		m_rewinding = false;
+	}
+	else if (m_active)
+	{
+		osd_printf_warning("State loaded while journalling; the journal no longer matches the machine\n");
+	}
+
+	// the loaded state has the timers as they were when it was saved
+	if (m_keyframe_timer && !m_record_stream)
+		m_keyframe_timer->reset();
+	if (m_replay_timer)
+	{
+		if (m_have_next)
+			m_replay_timer->adjust((m_next_time > machine().time()) ? (m_next_time - machine().time()) : attotime::zero);
+		else
+			m_replay_timer->reset();
+	}
+}
+
+
+//-------------------------------------------------
+//  keep_history - start or stop keeping records
+//  in memory for the reverse debugger
+//-------------------------------------------------
+
+void journal_manager::keep_history(bool keep)
+{
+	m_keep_history = keep && m_active;
+	if (!m_keep_history)
+		forget(nullptr);
+}
+
+
+//-------------------------------------------------
+//  mark - note the current position so it can be
+//  gone back to
+//-------------------------------------------------
+
+void journal_manager::mark(journal_mark &mark) const
+{
+	// a record that has been read ahead hasn't happened yet
+	mark.m_offset = m_have_next ? m_next_offset : history_offset();
+	mark.m_time = m_have_next ? m_next_previous : m_time;
+	mark.m_channels.clear();
+	if (!m_keep_history)
+		return;
+
+	mark.m_channels.reserve(m_channels.size());
+	for (auto const &chan : m_channels)
+	{
+		mark.m_channels.emplace_back(journal_mark::channel{
+				chan.get(),
+				chan->m_calls,
+				chan->m_last,
+				chan->m_waiting,
+				chan->m_polling,
+				chan->m_state,
+				chan->m_pending });
+	}
+}
+
+
+//-------------------------------------------------
+//  rewind - go back to a mark and replay the
+//  records since then from memory
+//-------------------------------------------------
+
+void journal_manager::rewind(const journal_mark &mark)
+{
+	if (!m_keep_history || (mark.m_offset < m_history_base))
+		return;
+
+	for (auto const &chan : m_channels)
+	{
+		chan->m_pending.clear();
+		chan->m_wake = false;
+	}
+	for (journal_mark::channel const &entry : mark.m_channels)
+	{
+		journal_channel &chan = *entry.chan;
+		chan.m_calls = entry.calls;
+		chan.m_last = entry.last;
+		chan.m_waiting = entry.waiting;
+		chan.m_polling = entry.polling;
+		chan.m_state = entry.state;
+		chan.m_pending = entry.pending;
+	}
+
+	// postload arms the replay timer for the first record
+	m_rewinding = true;
+	m_time = mark.m_time;
+	m_history_read = mark.m_offset;
+	m_rewound = m_history_read < (m_history_base + m_history.size());
+	read_next();
+}
+
+
+//-------------------------------------------------
+//  forget - drop history from before the oldest
+//  mark still needed
+//-------------------------------------------------
+
+void journal_manager::forget(const journal_mark *oldest)
+{
+	u64 keep = oldest ? oldest->m_offset : (m_history_base + m_history.size());
+	if (m_rewound)
+		keep = std::min(keep, m_history_read);
+	if (keep <= m_history_base)
+		return;
+
+	m_history.erase(m_history.begin(), m_history.begin() + (keep - m_history_base));
+	m_history_base = keep;
+}
+
+
+//-------------------------------------------------
+//  end_rewind - history has caught up with the
+//  recording
+//-------------------------------------------------
+
+void journal_manager::end_rewind()
+{
+	m_rewound = false;
+	m_have_next = false;
+
+	// pass on anything the host said in the meantime
+	for (auto const &chan : m_channels)
+	{
+		if (chan->m_host_ready)
+		{
+			m_replay_timer->adjust(attotime::zero);
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  history_offset - the offset that the next byte
+//  read comes from
+//-------------------------------------------------
+
+u64 journal_manager::history_offset() const
+{
+	return m_rewound ? m_history_read : (m_history_base + m_history.size());
+}
+
+
+//-------------------------------------------------
+//  read_some - read records from the history
+//  while going back over it, and from the file
+//  otherwise
+//-------------------------------------------------
+
+std::error_condition journal_manager::record_source::read_some(void *buffer, std::size_t length, std::size_t &actual) noexcept
+{
+	journal_manager &manager = m_manager;
+	actual = 0;
+	if (manager.m_rewound)
+	{
+		u64 const end = manager.m_history_base + manager.m_history.size();
+		size_t const count = size_t(std::min<u64>(length, end - manager.m_history_read));
+		std::copy_n(manager.m_history.data() + (manager.m_history_read - manager.m_history_base), count, reinterpret_cast<u8 *>(buffer));
+		manager.m_history_read += count;
+		actual = count;
+		if ((actual == length) || !manager.m_replay_stream)
+			return std::error_condition();
+
+		// replay carries on from the file where it left off
+		manager.m_rewound = false;
+	}
+	if (!manager.m_replay_stream)
+		return std::error_condition();
+
+	size_t count;
+	std::error_condition const err = manager.m_replay_stream->read_some(reinterpret_cast<u8 *>(buffer) + actual, length - actual, count);
+	if (manager.m_keep_history)
+		manager.m_history.insert(manager.m_history.end(), reinterpret_cast<u8 *>(buffer) + actual, reinterpret_cast<u8 *>(buffer) + actual + count);
+	actual += count;
+	return err;
+}
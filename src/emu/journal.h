@@ -0,0 +1,320 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    journal.h
+
+    Record/replay journal for non-deterministic inputs.
+
+    Everything the host feeds into a running machine (input port
+    states, bytes from serial streams and pseudo terminals, network
+    frames and the base time used by RTCs) passes through a journal
+    channel.  When recording, each channel logs what the host gave it;
+    when replaying, the channel hands back the logged data instead of
+    asking the host.  Data is matched up by counting the calls each
+    channel sees, so it doesn't depend on when the host happened to
+    have something ready.
+
+    The file starts with an uncompressed header:
+
+        char[8]   magic "MAMEJRN1"
+        u8        length of the system name, followed by the name
+        s64       base time (little-endian seconds since the epoch)
+
+    It is followed by a zlib stream of records.  Numbers are unsigned
+    LEB128 values.  Each record starts with a u8 type, the emulated
+    time relative to the previous record (seconds shifted left by one
+    with the sign in bit 0, then attoseconds) and a channel id:
+
+        RECORD_CHANNEL   name length, name
+        RECORD_DATA      calls since the channel's previous data record,
+                         length, data
+        RECORD_WAKE      (nothing; the host said input was ready)
+        RECORD_POLL      (nothing; the host can't notify, so poll)
+        RECORD_KEYFRAME  keyframe number, state name length, state
+                         name, channel count, and for each channel its
+                         id, call count, last data call and flags
+                         (KEYFRAME_*); the channel id is zero
+
+    Keyframes are save states taken periodically while recording, so
+    that a replay can start part way through the journal.
+
+    The reverse debugger goes back by loading an in-memory state, so
+    while it's keeping history the records written or read are kept in
+    memory too.  Going back to a journal_mark replays the records since
+    that point from memory before returning to the host or the file.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_JOURNAL_H
+#define MAME_EMU_JOURNAL_H
+
+#pragma once
+
+#include "ioprocs.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+// ======================> journal_channel
+
+class journal_channel
+{
+	friend class journal_manager;
+	friend class journal_mark;
+
+public:
+	typedef delegate<void ()> notify_delegate;
+
+	// construction/destruction
+	journal_channel(journal_manager &manager, std::string &&name);
+
+	// getters
+	const std::string &name() const { return m_name; }
+	bool replaying() const;
+
+	// read from the host with host(buffer, length) when recording, or
+	// from the journal when replaying; returns the number of bytes read
+	template <typename T> size_t input(u8 *buffer, size_t length, T &&host);
+
+	// ask for a callback once input is available; when recording this
+	// wraps host(delegate), which returns false if the caller has to poll
+	template <typename T> bool notify(notify_delegate &&callback, T &&host);
+
+	// log a state that's usually the same as last time, or replace it
+	// with the logged state when replaying
+	void sample(std::vector<u8> &state);
+
+private:
+	struct pending
+	{
+		u64                 index;          // call that receives the data
+		std::vector<u8>     data;           // logged data
+	};
+
+	size_t replay_input(u8 *buffer, size_t length);
+	bool replay_notify();
+	void record_data(const u8 *data, size_t length);
+	void host_ready();
+
+	// internal state
+	journal_manager &   m_manager;          // reference to our manager
+	std::string const   m_name;             // unique name
+	u32                 m_id;               // id in the journal (0 until announced)
+	u64                 m_calls;            // number of input calls so far
+	u64                 m_last;             // call of the most recent data
+	bool                m_waiting;          // device is waiting for a callback
+	bool                m_polling;          // host can't notify
+	bool                m_wake;             // callback is due
+	bool                m_host_ready;       // host said input was ready while history was replayed
+	notify_delegate     m_callback;         // device's most recent callback
+	std::deque<pending> m_pending;          // replayed data not consumed yet
+	std::vector<u8>     m_state;            // most recent sampled state
+};
+
+
+// ======================> journal_mark
+
+// a point in the journal that the reverse debugger can go back to
+class journal_mark
+{
+	friend class journal_manager;
+
+private:
+	struct channel
+	{
+		journal_channel *   chan;
+		u64                 calls;
+		u64                 last;
+		bool                waiting;
+		bool                polling;
+		std::vector<u8>     state;
+		std::deque<journal_channel::pending> pending;
+	};
+
+	u64                 m_offset = 0;       // history offset of the next record
+	attotime            m_time;             // time of the record before it
+	std::vector<channel> m_channels;        // channel states
+};
+
+
+// ======================> journal_manager
+
+class journal_manager
+{
+	friend class journal_channel;
+
+public:
+	// construction/destruction
+	journal_manager(running_machine &machine);
+	~journal_manager();
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool active() const { return m_active; }
+	bool recording() const { return m_record_stream && !m_rewound; }
+	bool replaying() const { return m_replaying || m_rewound; }
+
+	// start journalling once the base time is known; replaces it when replaying
+	void start(time_t &basetime);
+
+	// find or create a channel; returns nullptr if not journalling
+	journal_channel *channel(std::string_view name);
+
+	// history for the reverse debugger; marks are taken at the end of a
+	// timeslice, and rewind is called just before loading the state
+	// saved with the mark
+	void keep_history(bool keep);
+	void mark(journal_mark &mark) const;
+	void rewind(const journal_mark &mark);
+	void forget(const journal_mark *oldest);
+
+private:
+	enum : u8
+	{
+		RECORD_CHANNEL = 1,
+		RECORD_DATA,
+		RECORD_WAKE,
+		RECORD_POLL,
+		RECORD_KEYFRAME
+	};
+
+	enum : u8
+	{
+		KEYFRAME_WAITING = 0x01,
+		KEYFRAME_POLLING = 0x02
+	};
+
+	struct keyframe_channel
+	{
+		u32     id;
+		u64     calls;
+		u64     last;
+		u8      flags;
+	};
+
+	// recording
+	void record_init(time_t basetime);
+	void record_end(const char *message = nullptr);
+	void announce(journal_channel &chan);
+	void write_record(u8 type, u32 id);
+	void write_number(u64 value);
+	void write_bytes(const void *data, size_t length);
+	TIMER_CALLBACK_MEMBER(keyframe_timer);
+	void presave();
+
+	// replay
+	class record_source : public util::read_stream
+	{
+	public:
+		record_source(journal_manager &manager) : m_manager(manager) { }
+		virtual std::error_condition read_some(void *buffer, std::size_t length, std::size_t &actual) noexcept override;
+
+	private:
+		journal_manager &m_manager;
+	};
+
+	time_t replay_init();
+	void replay_end(const char *message = nullptr);
+	void out_of_sync(journal_channel &chan);
+	void read_next();
+	bool read_number(u64 &value);
+	bool read_bytes(void *data, size_t length);
+	bool read_string(std::string &result);
+	bool read_keyframe(u64 &index, std::string &name, std::vector<keyframe_channel> &channels);
+	void pump();
+	void seek(u64 index);
+	journal_channel *map_channel(u32 id, std::string &&name);
+	TIMER_CALLBACK_MEMBER(replay_timer);
+	void postload();
+	void end_rewind();
+	u64 history_offset() const;
+
+	void exit();
+
+	// internal state
+	running_machine &   m_machine;              // reference to our machine
+	bool                m_active;               // recording or replaying
+	std::vector<std::unique_ptr<journal_channel> > m_channels; // all channels
+	std::vector<journal_channel *> m_ids;       // channels by journal id
+	std::vector<std::string> m_id_names;        // channel names by journal id, for replay
+	std::unique_ptr<emu_file> m_file;           // journal file
+	attotime            m_time;                 // time of the previous record
+
+	// recording state
+	util::write_stream::ptr m_record_stream;    // compressed records
+	std::string         m_keyframe_base;        // base name for keyframe states
+	std::string         m_keyframe_pending;     // keyframe save in progress
+	u64                 m_keyframes;            // keyframes taken so far
+	emu_timer *         m_keyframe_timer;       // periodic keyframe timer
+
+	// replay state
+	util::read_stream::ptr m_replay_stream;     // compressed records
+	bool                m_replaying;            // replaying (possibly finished)
+	bool                m_have_next;            // next record's header has been read
+	u8                  m_next_type;            // type of the next record
+	attotime            m_next_time;            // time of the next record
+	u32                 m_next_id;              // channel id of the next record
+	u64                 m_next_offset;          // history offset of the next record
+	attotime            m_next_previous;        // time of the record before it
+	std::vector<keyframe_channel> m_seek;       // channel state to restore after a keyframe loads
+	bool                m_seeking;              // keyframe load in progress
+	bool                m_warned;               // out of sync already reported
+	emu_timer *         m_replay_timer;         // fires at the next record
+	record_source       m_source;               // reads from the history or the file
+
+	// history for the reverse debugger
+	bool                m_keep_history;         // keeping records in memory
+	std::vector<u8>     m_history;              // records since m_history_base
+	u64                 m_history_base;         // offset of the first byte kept
+	u64                 m_history_read;         // offset being replayed
+	bool                m_rewound;              // replaying records from the history
+	bool                m_rewinding;            // expecting the state load that goes back
+};
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+inline bool journal_channel::replaying() const
+{
+	return m_manager.replaying();
+}
+
+template <typename T>
+inline size_t journal_channel::input(u8 *buffer, size_t length, T &&host)
+{
+	m_calls++;
+	if (replaying())
+		return replay_input(buffer, length);
+
+	size_t const actual = host(buffer, length);
+	if (actual)
+		record_data(buffer, actual);
+	return actual;
+}
+
+template <typename T>
+inline bool journal_channel::notify(notify_delegate &&callback, T &&host)
+{
+	m_callback = std::move(callback);
+	if (replaying())
+		return replay_notify();
+
+	m_waiting = host(notify_delegate(&journal_channel::host_ready, this));
+	if (!m_waiting && !m_polling)
+	{
+		m_polling = true;
+		m_manager.announce(*this);
+		m_manager.write_record(journal_manager::RECORD_POLL, m_id);
+	}
+	return m_waiting;
+}
+
+#endif // MAME_EMU_JOURNAL_H
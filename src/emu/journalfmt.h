@@ -0,0 +1,101 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    journalfmt.h
+
+    Encoding of numbers and record times in journal files.
+
+    These don't need a running machine, so the journal's file format
+    can be checked on its own.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_JOURNALFMT_H
+#define MAME_EMU_JOURNALFMT_H
+
+#pragma once
+
+#include "attotime.h"
+#include "ioprocs.h"
+
+#include <utility>
+
+
+namespace journal_format {
+
+//-------------------------------------------------
+//  encode_number - encode an unsigned LEB128
+//  value, returning its length in bytes
+//-------------------------------------------------
+
+inline unsigned encode_number(u8 (&buffer)[10], u64 value) noexcept
+{
+	unsigned length = 0;
+	do
+	{
+		buffer[length] = u8(value & 0x7f);
+		value >>= 7;
+		if (value)
+			buffer[length] |= 0x80;
+		length++;
+	}
+	while (value);
+	return length;
+}
+
+
+//-------------------------------------------------
+//  decode_number - read an unsigned LEB128 value,
+//  failing on errors and overlong encodings
+//-------------------------------------------------
+
+inline bool decode_number(util::read_stream &stream, u64 &value) noexcept
+{
+	value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		u8 byte;
+		auto const [err, actual] = util::read(stream, &byte, 1);
+		if (err || (actual != 1))
+			return false;
+		value |= u64(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  encode_time - encode a record time relative to
+//  the previous record as (seconds << 1 | sign,
+//  attoseconds)
+//-------------------------------------------------
+
+inline std::pair<u64, u64> encode_time(attotime const &previous, attotime const &now) noexcept
+{
+	// time can step backwards when a device asks for input part way
+	// through a timeslice
+	attotime const delta = (now >= previous) ? (now - previous) : (previous - now);
+	return std::make_pair((u64(delta.seconds()) << 1) | ((now < previous) ? 1 : 0), u64(delta.attoseconds()));
+}
+
+
+//-------------------------------------------------
+//  decode_time - recover a record time from its
+//  encoding, failing if it's malformed
+//-------------------------------------------------
+
+inline bool decode_time(attotime const &previous, u64 seconds, u64 attoseconds, attotime &result) noexcept
+{
+	if (attoseconds >= u64(ATTOSECONDS_PER_SECOND))
+		return false;
+	attotime const delta(seconds_t(seconds >> 1), attoseconds_t(attoseconds));
+	result = (seconds & 1) ? (previous - delta) : (previous + delta);
+	return true;
+}
+
+} // namespace journal_format
+
+#endif // MAME_EMU_JOURNALFMT_H
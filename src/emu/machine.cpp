@@ -14,12 +14,15 @@
 #include "crsshair.h"
 #include "debug/debugcpu.h"
 #include "debug/debugvw.h"
+#include "debug/reverse.h"
 #include "debugger.h"
 #include "dirtc.h"
 #include "emuopts.h"
 #include "fileio.h"
 #include "http.h"
 #include "image.h"
+#include "iopoll.h"
+#include "journal.h"
 #include "main.h"
 #include "natkeyboard.h"
 #include "network.h"
@@ -158,8 +161,14 @@ void running_machine::start()
 	m_ui = manager().create_ui(*this);
 	m_ui->set_startup_text("Initializing...", true);
 
-	// initialize the base time (needed for doing record/playback)
+	// initialize the base time (needed for doing record/playback); a fixed
+	// base time makes the emulated clocks reproducible from run to run
 	::time(&m_base_time);
+	if (options().rtc_base_time() > 0)
+		m_base_time = time_t(options().rtc_base_time());
+
+	// the input journal has to exist before anything asks for a channel
+	m_journal = std::make_unique<journal_manager>(*this);
 
 	// initialize the input system and input ports for the game
 	// this must be done before memory_init in order to allow specifying
@@ -168,6 +177,9 @@ void running_machine::start()
 	if (newbase != 0)
 		m_base_time = newbase;
 
+	// a replayed journal supplies the base time it was recorded with
+	m_journal->start(m_base_time);
+
 	// initialize natural keyboard support after ports have been initialized
 	m_natkeyboard = std::make_unique<natural_keyboard>(*this);
 
@@ -189,6 +201,9 @@ void running_machine::start()
 	// save the random seed or save states might be broken in drivers that use the rand() method
 	save().save_item(NAME(m_rand_seed));
 
+	// host I/O notifications have to be available before images are loaded
+	m_iopoll = std::make_unique<io_poll_manager>(*this);
+
 	// initialize image devices
 	m_image = std::make_unique<image_manager>(*this);
 	m_tilemap = std::make_unique<tilemap_manager>(*this);
@@ -330,7 +345,14 @@ int running_machine::run(bool quiet)
 
 			// execute CPUs if not paused
 			if (!m_paused)
+			{
 				m_scheduler.timeslice();
+				m_iopoll->dispatch();
+
+				// reverse execution takes and loads snapshots between timeslices
+				if ((debug_flags & DEBUG_FLAG_ENABLED) != 0)
+					debugger().cpu().reverse().timeslice_end();
+			}
 			// otherwise, just pump video updates through
 			else
 				m_video->frame_update();
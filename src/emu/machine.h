@@ -128,6 +128,8 @@ public:
 	sound_manager &sound() const { assert(m_sound != nullptr); return *m_sound; }
 	video_manager &video() const { assert(m_video != nullptr); return *m_video; }
 	network_manager &network() const { assert(m_network != nullptr); return *m_network; }
+	io_poll_manager &iopoll() const { assert(m_iopoll != nullptr); return *m_iopoll; }
+	journal_manager &journal() const { assert(m_journal != nullptr); return *m_journal; }
 	bookkeeping_manager &bookkeeping() const { assert(m_bookkeeping != nullptr); return *m_bookkeeping; }
 	configuration_manager  &configuration() const { assert(m_configuration != nullptr); return *m_configuration; }
 	output_manager  &output() const { assert(m_output != nullptr); return *m_output; }
@@ -277,6 +279,8 @@ private:
 	std::unique_ptr<tilemap_manager> m_tilemap;        // internal data from tilemap.cpp
 	std::unique_ptr<debug_view_manager> m_debug_view;  // internal data from debugvw.cpp
 	std::unique_ptr<network_manager> m_network;        // internal data from network.cpp
+	std::unique_ptr<io_poll_manager> m_iopoll;         // internal data from iopoll.cpp
+	std::unique_ptr<journal_manager> m_journal;        // internal data from journal.cpp
 	std::unique_ptr<bookkeeping_manager> m_bookkeeping;// internal data from bookkeeping.cpp
 	std::unique_ptr<configuration_manager> m_configuration; // internal data from config.cpp
 	std::unique_ptr<output_manager> m_output;          // internal data from output.cpp
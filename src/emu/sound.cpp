@@ -556,6 +556,7 @@ sound_stream::sound_stream(device_t &device, u32 inputs, u32 outputs, u32 output
 	m_output_adaptive(sample_rate == SAMPLE_RATE_OUTPUT_ADAPTIVE),
 	m_synchronous((flags & STREAM_SYNCHRONOUS) != 0),
 	m_resampling_disabled((flags & STREAM_DISABLE_INPUT_RESAMPLING) != 0),
+	m_parallel_safe((flags & STREAM_PARALLEL_SAFE) != 0),
 	m_sync_timer(nullptr),
 	m_last_update_end_time(attotime::zero),
 	m_input(inputs),
@@ -563,7 +564,11 @@ sound_stream::sound_stream(device_t &device, u32 inputs, u32 outputs, u32 output
 	m_empty_buffer(100),
 	m_output_base(output_base),
 	m_output(outputs),
-	m_output_view(outputs)
+	m_output_view(outputs),
+	m_cost_report(device.machine().options().stream_report()),
+	m_update_calls(0),
+	m_update_samples(0),
+	m_update_ticks(0)
 {
 	sound_assert(outputs > 0);
 
@@ -662,6 +667,7 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	// wire it up
 	m_input[index].set_source((input_stream != nullptr) ? &input_stream->m_output[output_index] : nullptr);
 	m_input[index].set_gain(gain);
+	m_device.machine().sound().m_schedule_dirty = true;
 
 	// update sample rates now that we know the input
 	sample_rate_changed();
@@ -695,6 +701,12 @@ void sound_stream::update()
 
 read_stream_view sound_stream::update_view(attotime start, attotime end, u32 outputnum)
 {
+	// streams with more than one consumer may be asked for data from several
+	// threads, but only while the graph is being updated in parallel
+	std::unique_lock<std::recursive_mutex> lock(m_update_lock, std::defer_lock);
+	if (m_device.machine().sound().parallel_running())
+		lock.lock();
+
 	sound_assert(start <= end);
 	sound_assert(outputnum < m_output.size());
 
@@ -739,7 +751,19 @@ read_stream_view sound_stream::update_view(attotime start, attotime end, u32 out
 #endif
 
 			// if we have an extended callback, that's all we need
-			m_callback_ex(*this, m_input_view, m_output_view);
+			if (!m_cost_report)
+			{
+				m_callback_ex(*this, m_input_view, m_output_view);
+			}
+			else
+			{
+				// inputs are already up to date, so this is the cost of this stream alone
+				osd_ticks_t const start_ticks = osd_ticks();
+				m_callback_ex(*this, m_input_view, m_output_view);
+				m_update_ticks += osd_ticks() - start_ticks;
+				m_update_calls++;
+				m_update_samples += samples;
+			}
 
 #if (SOUND_DEBUG)
 			// make sure everything was overwritten
@@ -930,7 +954,7 @@ read_stream_view sound_stream::empty_view(attotime start, attotime end)
 //-------------------------------------------------
 
 default_resampler_stream::default_resampler_stream(device_t &device) :
-	sound_stream(device, 1, 1, 0, SAMPLE_RATE_OUTPUT_ADAPTIVE, stream_update_delegate(&default_resampler_stream::resampler_sound_update, this), STREAM_DISABLE_INPUT_RESAMPLING),
+	sound_stream(device, 1, 1, 0, SAMPLE_RATE_OUTPUT_ADAPTIVE, stream_update_delegate(&default_resampler_stream::resampler_sound_update, this), sound_stream_flags(STREAM_DISABLE_INPUT_RESAMPLING | STREAM_PARALLEL_SAFE)),
 	m_max_latency(0)
 {
 	// create a name
@@ -1037,10 +1061,12 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 
 			// add in complete samples until we only have a fraction left
 			stream_buffer::sample_t remaining = step - scale;
-			while (remaining >= 1.0)
+			if (remaining >= 1.0)
 			{
-				sample += rebased.get(srcindex++);
-				remaining -= 1.0;
+				s32 const whole = s32(remaining);
+				sample += rebased.sum(srcindex, whole);
+				srcindex += whole;
+				remaining -= stream_buffer::sample_t(whole);
 			}
 
 			// add in the final partial sample
@@ -1083,7 +1109,12 @@ sound_manager::sound_manager(running_machine &machine) :
 	m_attenuation(0),
 	m_unique_id(0),
 	m_wavfile(),
-	m_first_reset(true)
+	m_first_reset(true),
+	m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ)),
+	m_schedule_dirty(true),
+	m_schedule_parallel(false),
+	m_parallel_running(false),
+	m_schedule_end(attotime::zero)
 {
 	// count the mixers
 #if VERBOSE
@@ -1100,6 +1131,8 @@ sound_manager::sound_manager(running_machine &machine) :
 	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&sound_manager::resume, this));
 	machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&sound_manager::reset, this));
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&sound_manager::stop_recording, this));
+	if (machine.options().stream_report())
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&sound_manager::stream_report, this));
 
 	// register global states
 	machine.save().save_item(NAME(m_last_update));
@@ -1119,6 +1152,8 @@ sound_manager::sound_manager(running_machine &machine) :
 
 sound_manager::~sound_manager()
 {
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -1136,6 +1171,7 @@ sound_stream *sound_manager::stream_alloc(device_t &device, u32 inputs, u32 outp
 			output_base += stream->output_count();
 
 	m_stream_list.push_back(std::make_unique<sound_stream>(device, inputs, outputs, output_base, sample_rate, callback, flags));
+	m_schedule_dirty = true;
 	return m_stream_list.back().get();
 }
 
@@ -1529,6 +1565,9 @@ void sound_manager::update(s32 param)
 	std::fill_n(&m_leftmix[0], m_samples_this_update, 0);
 	std::fill_n(&m_rightmix[0], m_samples_this_update, 0);
 
+	// generate independent parts of the graph concurrently where it pays off
+	update_graph(endtime);
+
 	// force all the speaker streams to generate the proper number of samples
 	for (speaker_device &speaker : m_speakers)
 		speaker.mix(&m_leftmix[0], &m_rightmix[0], m_last_update, endtime, m_samples_this_update, (m_muted & MUTE_REASON_SYSTEM));
@@ -1649,3 +1688,250 @@ void sound_manager::update(s32 param)
 	// notify that new samples have been generated
 	emulator_info::sound_hook();
 }
+
+
+//-------------------------------------------------
+//  stream_report - print the time spent in each
+//  stream's update callback, most expensive first
+//-------------------------------------------------
+
+void sound_manager::stream_report()
+{
+	// gather every stream, including the resamplers hidden behind stream inputs
+	std::vector<sound_stream const *> streams;
+	osd_ticks_t total = 0;
+	for (auto &stream : m_stream_list)
+	{
+		streams.push_back(stream.get());
+		for (auto &resampler : stream->m_resampler_list)
+			streams.push_back(resampler.get());
+	}
+	for (sound_stream const *stream : streams)
+		total += stream->m_update_ticks;
+	std::stable_sort(
+			streams.begin(),
+			streams.end(),
+			[] (sound_stream const *a, sound_stream const *b) { return a->m_update_ticks > b->m_update_ticks; });
+
+	double const tps = double(osd_ticks_per_second());
+	osd_printf_info("Sound stream update cost (%s kernels, %.3f ms total):\n", emu::sound_simd::isa_name(), double(total) * 1000.0 / tps);
+	for (sound_stream const *stream : streams)
+	{
+		if (!stream->m_update_calls)
+			continue;
+		double const ns = double(stream->m_update_ticks) * 1e9 / tps;
+		osd_printf_info("%7.3f ms %5.1f%% %8.2f ns/sample %10u samples %8u calls %7u Hz  %s\n",
+				ns / 1e6,
+				total ? (100.0 * double(stream->m_update_ticks) / double(total)) : 0.0,
+				stream->m_update_samples ? (ns / double(stream->m_update_samples)) : 0.0,
+				stream->m_update_samples,
+				stream->m_update_calls,
+				stream->sample_rate(),
+				stream->name());
+	}
+}
+
+
+//-------------------------------------------------
+//  build_schedule - sort the streams feeding the
+//  speakers into phases that can be updated
+//  concurrently
+//-------------------------------------------------
+
+void sound_manager::build_schedule()
+{
+	m_schedule_dirty = false;
+	m_schedule.clear();
+	m_schedule_parallel = false;
+
+	// compute the height of each stream above the leaves of the graph
+	std::unordered_map<sound_stream *, int> heights;
+	for (speaker_device &speaker : m_speakers)
+	{
+		int dummy;
+		sound_stream *const output = speaker.output_to_stream_output(0, dummy);
+		if (output)
+			schedule_height(output, heights);
+	}
+
+	// streams of equal height never depend on each other; group them by device
+	// so that no device has two of its streams updated at the same time
+	for (auto &stream : m_stream_list)
+	{
+		auto const found = heights.find(stream.get());
+		if (found == heights.end())
+			continue;
+		if (m_schedule.size() <= found->second)
+			m_schedule.resize(found->second + 1);
+
+		auto &phase = m_schedule[found->second];
+		auto group = std::find_if(
+				phase.begin(),
+				phase.end(),
+				[&stream] (update_group const &g) { return !g.streams.empty() && &g.streams.front()->device() == &stream->device(); });
+		if (group == phase.end())
+		{
+			phase.push_back(update_group{ this, { }, { }, nullptr });
+			group = phase.end() - 1;
+		}
+		group->streams.push_back(stream.get());
+	}
+
+	// resamplers sit between their source and the consuming stream; all the
+	// inputs fed by one stream go in one group, since they pick from and
+	// share that stream's resamplers
+	for (auto &stream : m_stream_list)
+	{
+		if (heights.find(stream.get()) == heights.end())
+			continue;
+		for (int inputnum = 0; inputnum < stream->input_count(); inputnum++)
+		{
+			sound_stream_input &input = stream->input(inputnum);
+			if (!input.valid() || !input.resampled())
+				continue;
+
+			sound_stream *const source = &input.source().stream();
+			auto &phase = m_schedule[heights[source] + 1];
+			auto group = std::find_if(
+					phase.begin(),
+					phase.end(),
+					[source] (update_group const &g) { return !g.inputs.empty() && &g.inputs.front()->source().stream() == source; });
+			if (group == phase.end())
+			{
+				phase.push_back(update_group{ this, { }, { }, nullptr });
+				group = phase.end() - 1;
+			}
+			group->inputs.push_back(&input);
+		}
+	}
+
+	// only groups made entirely of streams that opted in may run on a worker;
+	// everything else in a phase is merged into the first group, which always
+	// runs on the emulation thread (resampling only touches the resamplers)
+	for (auto &phase : m_schedule)
+	{
+		std::vector<update_group> sorted;
+		sorted.push_back(update_group{ this, { }, { }, nullptr });
+		for (update_group &group : phase)
+		{
+			if (std::all_of(group.streams.begin(), group.streams.end(), [] (sound_stream const *s) { return s->parallel_safe(); }))
+				sorted.push_back(std::move(group));
+			else
+				sorted.front().streams.insert(sorted.front().streams.end(), group.streams.begin(), group.streams.end());
+		}
+		if (sorted.front().streams.empty() && sorted.front().inputs.empty())
+			sorted.erase(sorted.begin());
+		phase = std::move(sorted);
+	}
+
+	// only worth the synchronisation if there is more than one group to run at once
+	if (heights.size() >= PARALLEL_MIN_STREAMS)
+	{
+		for (auto &phase : m_schedule)
+			if (phase.size() > 1)
+				m_schedule_parallel = true;
+	}
+	LOG("sound schedule: %d streams in %d phases, %s\n", int(heights.size()), int(m_schedule.size()), m_schedule_parallel ? "parallel" : "serial");
+}
+
+
+//-------------------------------------------------
+//  schedule_height - return the number of stream
+//  levels below the given stream
+//-------------------------------------------------
+
+int sound_manager::schedule_height(sound_stream *stream, std::unordered_map<sound_stream *, int> &heights)
+{
+	auto const found = heights.find(stream);
+	if (found != heights.end())
+		return found->second;
+
+	// a resampled input puts its resampler one level above the source
+	int height = 0;
+	for (int inputnum = 0; inputnum < stream->input_count(); inputnum++)
+	{
+		auto &input = stream->input(inputnum);
+		if (input.valid())
+			height = std::max(height, schedule_height(&input.source().stream(), heights) + (input.resampled() ? 2 : 1));
+	}
+	heights.emplace(stream, height);
+	return height;
+}
+
+
+//-------------------------------------------------
+//  update_graph - bring every stream feeding the
+//  speakers up to the given time, one phase at a
+//  time with the groups in each phase spread
+//  across the work queue
+//-------------------------------------------------
+
+void sound_manager::update_graph(attotime endtime)
+{
+	if (m_first_reset)
+		return;
+	if (m_schedule_dirty)
+		build_schedule();
+
+	// small graphs, and the profiler which is not thread-safe, leave everything
+	// to be pulled serially by the speakers
+	if (!m_schedule_parallel || !m_work_queue || g_profiler.enabled())
+		return;
+
+	// each stream ends up with exactly the samples a serial pull to the same
+	// end time would have produced, so the output does not depend on ordering
+	m_schedule_end = endtime;
+	m_parallel_running = true;
+	for (auto &phase : m_schedule)
+	{
+		// hand all but the first group to the pool and run that one here; the
+		// next phase reads what this one writes, so wait for as long as it takes
+		if (phase.size() > 1)
+			osd_work_item_queue_multiple(m_work_queue, &sound_manager::update_group_callback, phase.size() - 1, &phase[1], sizeof(update_group), WORK_ITEM_FLAG_AUTO_RELEASE);
+		update_group_callback(&phase[0], 0);
+		if (phase.size() > 1)
+		{
+			while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second()))
+				;
+		}
+
+		// pass on the first failure from any thread
+		for (auto &group : phase)
+		{
+			if (group.error)
+			{
+				std::exception_ptr error;
+				std::swap(error, group.error);
+				for (auto &other : phase)
+					other.error = nullptr;
+				m_parallel_running = false;
+				std::rethrow_exception(error);
+			}
+		}
+	}
+	m_parallel_running = false;
+}
+
+
+//-------------------------------------------------
+//  update_group_callback - work item to update
+//  one group of streams
+//-------------------------------------------------
+
+void *sound_manager::update_group_callback(void *param, int threadid)
+{
+	auto &group = *reinterpret_cast<update_group *>(param);
+	try
+	{
+		attotime const end = group.manager->m_schedule_end;
+		for (sound_stream_input *input : group.inputs)
+			input->update(std::min(input->owner().sample_time(), end), end);
+		for (sound_stream *stream : group.streams)
+			stream->update_view(std::min(stream->sample_time(), end), end);
+	}
+	catch (...)
+	{
+		group.error = std::current_exception();
+	}
+	return nullptr;
+}
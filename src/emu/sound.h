@@ -61,8 +61,12 @@
 #ifndef MAME_EMU_SOUND_H
 #define MAME_EMU_SOUND_H
 
+#include "soundsimd.h"
 #include "wavwrite.h"
 
+#include <exception>
+#include <mutex>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -328,7 +332,42 @@ public:
 		return m_buffer->get(index);
 	}
 
+	// return a pointer to the raw samples starting at the given index and
+	// clamp count to the number that are contiguous in the buffer; if you
+	// use this, you need to apply the gain yourself for correctness
+	sample_t const *getraw_run(s32 index, s32 &count) const
+	{
+		sound_assert(u32(index) < samples());
+		u32 const bufindex = index_to_buffer_index(index);
+		count = std::min<s32>(count, m_buffer->size() - bufindex);
+		return &m_buffer->m_buffer[bufindex];
+	}
+
+	// return the gain-scaled sum of a range of samples
+	sample_t sum(s32 start, s32 count) const
+	{
+		sample_t result = 0;
+		while (count > 0)
+		{
+			s32 run = count;
+			sample_t const *src = getraw_run(start, run);
+			result += emu::sound_simd::sum(src, run);
+			start += run;
+			count -= run;
+		}
+		return result * m_gain;
+	}
+
 protected:
+	// given a stream starting offset, return the buffer index
+	u32 index_to_buffer_index(s32 start) const
+	{
+		u32 index = start + m_start;
+		if (index >= m_buffer->size())
+			index -= m_buffer->size();
+		return index;
+	}
+
 	// normalize start/end
 	void normalize_start_end()
 	{
@@ -416,11 +455,12 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
+		while (count > 0)
 		{
-			m_buffer->put(index, value);
-			index = m_buffer->next_index(index);
+			s32 run = count;
+			std::fill_n(getwrite_run(start, run), run, value);
+			start += run;
+			count -= run;
 		}
 	}
 	void fill(sample_t value, s32 start) { fill(value, start, samples() - start); }
@@ -431,11 +471,14 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
+		while (count > 0)
 		{
-			m_buffer->put(index, src.get(start + sampindex));
-			index = m_buffer->next_index(index);
+			s32 run = count;
+			sample_t *dest = getwrite_run(start, run);
+			sample_t const *source = src.getraw_run(start, run);
+			emu::sound_simd::scale(dest, source, src.gain(), run);
+			start += run;
+			count -= run;
 		}
 	}
 	void copy(read_stream_view const &src, s32 start) { copy(src, start, samples() - start); }
@@ -446,24 +489,28 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
+		while (count > 0)
 		{
-			m_buffer->put(index, m_buffer->get(index) + src.get(start + sampindex));
-			index = m_buffer->next_index(index);
+			s32 run = count;
+			sample_t *dest = getwrite_run(start, run);
+			sample_t const *source = src.getraw_run(start, run);
+			emu::sound_simd::mix(dest, source, src.gain(), run);
+			start += run;
+			count -= run;
 		}
 	}
 	void add(read_stream_view const &src, s32 start) { add(src, start, samples() - start); }
 	void add(read_stream_view const &src) { add(src, 0, samples()); }
 
 private:
-	// given a stream starting offset, return the buffer index
-	u32 index_to_buffer_index(s32 start) const
+	// return a pointer to the samples starting at the given index and clamp
+	// count to the number that are contiguous in the buffer
+	sample_t *getwrite_run(s32 index, s32 &count)
 	{
-		u32 index = start + m_start;
-		if (index >= m_buffer->size())
-			index -= m_buffer->size();
-		return index;
+		sound_assert(u32(index) < samples());
+		u32 const bufindex = index_to_buffer_index(index);
+		count = std::min<s32>(count, m_buffer->size() - bufindex);
+		return &m_buffer->m_buffer[bufindex];
 	}
 };
 
@@ -545,6 +592,7 @@ public:
 	bool valid() const { return (m_native_source != nullptr); }
 	sound_stream &owner() const { sound_assert(valid()); return *m_owner; }
 	sound_stream_output &source() const { sound_assert(valid()); return *m_native_source; }
+	bool resampled() const { return (m_resampler_source != nullptr); }
 	u32 index() const { return m_index; }
 	stream_buffer::sample_t gain() const { return m_gain; }
 	stream_buffer::sample_t user_gain() const { return m_user_gain; }
@@ -596,7 +644,12 @@ enum sound_stream_flags : u32
 
 	// specify that input streams should not be resampled; stream update handler
 	// must be able to accommodate multiple strams of differing input rates
-	STREAM_DISABLE_INPUT_RESAMPLING = 0x02
+	STREAM_DISABLE_INPUT_RESAMPLING = 0x02,
+
+	// specify that the update handler only touches the device's own state and
+	// its stream buffers (no machine().rand(), logging, callbacks or timers),
+	// so it may run on a worker thread alongside other such streams
+	STREAM_PARALLEL_SAFE = 0x04
 };
 
 
@@ -622,6 +675,7 @@ public:
 	bool output_adaptive() const { return m_output_adaptive; }
 	bool synchronous() const { return m_synchronous; }
 	bool resampling_disabled() const { return m_resampling_disabled; }
+	bool parallel_safe() const { return m_parallel_safe; }
 
 	// input and output getters
 	u32 input_count() const { return m_input.size(); }
@@ -694,6 +748,7 @@ private:
 	bool m_output_adaptive;                        // adaptive stream that runs at the sample rate of its output
 	bool m_synchronous;                            // synchronous stream that runs at the rate of its input
 	bool m_resampling_disabled;                    // is resampling of input streams disabled?
+	bool m_parallel_safe;                          // may be updated on a worker thread?
 	emu_timer *m_sync_timer;                       // update timer for synchronous streams
 
 	attotime m_last_update_end_time;               // last end_time() in update
@@ -711,6 +766,15 @@ private:
 
 	// callback information
 	stream_update_delegate m_callback_ex;          // extended callback function
+
+	// serialises updates when the graph is evaluated on several threads
+	std::recursive_mutex m_update_lock;
+
+	// update cost accounting
+	bool m_cost_report;                            // gather update costs for the stream report?
+	u64 m_update_calls;                            // number of callback invocations
+	u64 m_update_samples;                          // number of samples generated
+	osd_ticks_t m_update_ticks;                    // time spent in the callback
 };
 
 
@@ -757,6 +821,9 @@ class sound_manager
 public:
 	static constexpr int STREAMS_UPDATE_FREQUENCY = 50;
 
+	// graphs with fewer streams than this are always updated serially
+	static constexpr unsigned PARALLEL_MIN_STREAMS = 4;
+
 	// construction/destruction
 	sound_manager(running_machine &machine);
 	~sound_manager();
@@ -769,6 +836,7 @@ public:
 	int sample_count() const { return m_samples_this_update; }
 	int unique_id() { return m_unique_id++; }
 	stream_buffer::sample_t compressor_scale() const { return m_compressor_scale; }
+	bool parallel_running() const { return m_parallel_running; }
 
 	// allocate a new stream with a new-style callback
 	sound_stream *stream_alloc(device_t &device, u32 inputs, u32 outputs, u32 sample_rate, stream_update_delegate callback, sound_stream_flags flags);
@@ -824,6 +892,26 @@ private:
 	// periodic sound update, called STREAMS_UPDATE_FREQUENCY per second
 	void update(s32 param = 0);
 
+	// print the per-stream update cost report
+	void stream_report();
+
+	// a set of streams updated together by one thread: one device's
+	// parallel-safe streams, the resampled inputs fed by one stream, or
+	// all the others in a phase
+	struct update_group
+	{
+		sound_manager *manager;
+		std::vector<sound_stream *> streams;
+		std::vector<sound_stream_input *> inputs;
+		std::exception_ptr error;
+	};
+
+	// parallel graph evaluation
+	void build_schedule();
+	int schedule_height(sound_stream *stream, std::unordered_map<sound_stream *, int> &heights);
+	void update_graph(attotime endtime);
+	static void *update_group_callback(void *param, int threadid);
+
 	// internal state
 	running_machine &m_machine;           // reference to the running machine
 	emu_timer *m_update_timer;            // timer that runs the update function
@@ -851,6 +939,14 @@ private:
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list; // list of streams
 	std::map<sound_stream *, u8> m_orphan_stream_list; // list of orphaned streams
 	bool m_first_reset;                   // is this our first reset?
+
+	// parallel graph evaluation
+	osd_work_queue *m_work_queue;         // worker pool for independent streams
+	std::vector<std::vector<update_group> > m_schedule; // groups by height above the leaves
+	bool m_schedule_dirty;                // graph changed since the schedule was built?
+	bool m_schedule_parallel;             // schedule worth running in parallel?
+	bool m_parallel_running;              // are worker threads updating streams?
+	attotime m_schedule_end;              // end time for the current parallel update
 };
 
 
@@ -0,0 +1,164 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    soundsimd.cpp
+
+    AVX2 versions of the sound stream kernels, and the startup check
+    that decides whether to use them.
+
+    This file deliberately doesn't need emu.h, so the kernels can be
+    benchmarked on their own.
+
+***************************************************************************/
+
+#include "soundsimd.h"
+
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+
+namespace emu::sound_simd {
+
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+
+// GCC and clang need to be told they may use AVX2 in these functions; MSVC
+// lets intrinsics through regardless
+#if defined(__GNUC__) || defined(__clang__)
+#define MAME_SOUND_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MAME_SOUND_SIMD_TARGET_AVX2
+#endif
+
+namespace {
+
+//-------------------------------------------------
+//  detect_avx2 - check that the CPU has AVX2 and
+//  the OS saves the YMM registers
+//-------------------------------------------------
+
+bool detect_avx2() noexcept
+{
+#if defined(__AVX2__)
+	return true;
+#elif defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	if (!(info[2] & (1 << 27)) || ((_xgetbv(0) & 0x06) != 0x06))
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return false;
+#endif
+}
+
+} // anonymous namespace
+
+
+bool const use_avx2 = detect_avx2();
+
+
+//-------------------------------------------------
+//  scale_avx2 - dest[i] = src[i] * gain
+//-------------------------------------------------
+
+MAME_SOUND_SIMD_TARGET_AVX2 void scale_avx2(float *dest, float const *src, float gain, s32 count) noexcept
+{
+	s32 index = 0;
+	__m256 const g = _mm256_set1_ps(gain);
+	for ( ; (index + 8) <= count; index += 8)
+		_mm256_storeu_ps(&dest[index], _mm256_mul_ps(_mm256_loadu_ps(&src[index]), g));
+	for ( ; index < count; index++)
+		dest[index] = src[index] * gain;
+}
+
+
+//-------------------------------------------------
+//  mix_avx2 - dest[i] += src[i] * gain
+//-------------------------------------------------
+
+MAME_SOUND_SIMD_TARGET_AVX2 void mix_avx2(float *dest, float const *src, float gain, s32 count) noexcept
+{
+	s32 index = 0;
+	__m256 const g = _mm256_set1_ps(gain);
+	for ( ; (index + 8) <= count; index += 8)
+		_mm256_storeu_ps(&dest[index], _mm256_add_ps(_mm256_loadu_ps(&dest[index]), _mm256_mul_ps(_mm256_loadu_ps(&src[index]), g)));
+	for ( ; index < count; index++)
+		dest[index] += src[index] * gain;
+}
+
+
+//-------------------------------------------------
+//  mix_pan_avx2 - mix a mono source into a pair
+//  of destinations with separate gains
+//-------------------------------------------------
+
+MAME_SOUND_SIMD_TARGET_AVX2 void mix_pan_avx2(float *left, float *right, float const *src, float leftgain, float rightgain, s32 count) noexcept
+{
+	s32 index = 0;
+	__m256 const lg = _mm256_set1_ps(leftgain);
+	__m256 const rg = _mm256_set1_ps(rightgain);
+	for ( ; (index + 8) <= count; index += 8)
+	{
+		__m256 const s = _mm256_loadu_ps(&src[index]);
+		_mm256_storeu_ps(&left[index], _mm256_add_ps(_mm256_loadu_ps(&left[index]), _mm256_mul_ps(s, lg)));
+		_mm256_storeu_ps(&right[index], _mm256_add_ps(_mm256_loadu_ps(&right[index]), _mm256_mul_ps(s, rg)));
+	}
+	for ( ; index < count; index++)
+	{
+		left[index] += src[index] * leftgain;
+		right[index] += src[index] * rightgain;
+	}
+}
+
+
+//-------------------------------------------------
+//  sum_avx2 - return the sum of a run of samples
+//-------------------------------------------------
+
+MAME_SOUND_SIMD_TARGET_AVX2 float sum_avx2(float const *src, s32 count) noexcept
+{
+	s32 index = 0;
+	__m256 acc = _mm256_setzero_ps();
+	for ( ; (index + 8) <= count; index += 8)
+		acc = _mm256_add_ps(acc, _mm256_loadu_ps(&src[index]));
+	__m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+	half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+	half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+	float result = _mm_cvtss_f32(half);
+	for ( ; index < count; index++)
+		result += src[index];
+	return result;
+}
+
+#endif // MAME_SOUND_SIMD_AVX2_DISPATCH
+
+
+//-------------------------------------------------
+//  isa_name - name of the instruction set the
+//  kernels are using
+//-------------------------------------------------
+
+char const *isa_name() noexcept
+{
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+	return use_avx2 ? "AVX2" : "SSE2";
+#elif defined(MAME_SOUND_SIMD_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
+
+} // namespace emu::sound_simd
@@ -0,0 +1,176 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    soundsimd.h
+
+    Vectorised inner loops for the sound stream graph: gain, mixing and
+    summing of contiguous runs of samples. The baseline implementation
+    is chosen at compile time in the same way as rgbutil.h, falling back
+    to plain loops the compiler is free to auto-vectorise. On x86, AVX2
+    versions are built alongside and used for longer runs when the CPU
+    supports them.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_SOUNDSIMD_H
+#define MAME_EMU_SOUNDSIMD_H
+
+#pragma once
+
+#include "osdcomm.h"
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define MAME_SOUND_SIMD_SSE2
+#define MAME_SOUND_SIMD_AVX2_DISPATCH
+#include <emmintrin.h>
+#elif (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define MAME_SOUND_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace emu::sound_simd {
+
+using osd::s32;
+
+// name of the instruction set the kernels are using
+char const *isa_name() noexcept;
+
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+// shorter runs aren't worth the call
+constexpr s32 AVX2_MIN_RUN = 16;
+
+// set at startup if the CPU and OS support AVX2
+extern bool const use_avx2;
+
+void scale_avx2(float *dest, float const *src, float gain, s32 count) noexcept;
+void mix_avx2(float *dest, float const *src, float gain, s32 count) noexcept;
+void mix_pan_avx2(float *left, float *right, float const *src, float leftgain, float rightgain, s32 count) noexcept;
+float sum_avx2(float const *src, s32 count) noexcept;
+#endif
+
+
+//-------------------------------------------------
+//  scale - dest[i] = src[i] * gain
+//-------------------------------------------------
+
+inline void scale(float *dest, float const *src, float gain, s32 count)
+{
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+	if (use_avx2 && (count >= AVX2_MIN_RUN))
+		return scale_avx2(dest, src, gain, count);
+#endif
+	s32 index = 0;
+#if defined(MAME_SOUND_SIMD_SSE2)
+	__m128 const g = _mm_set1_ps(gain);
+	for ( ; (index + 4) <= count; index += 4)
+		_mm_storeu_ps(&dest[index], _mm_mul_ps(_mm_loadu_ps(&src[index]), g));
+#elif defined(MAME_SOUND_SIMD_NEON)
+	float32x4_t const g = vdupq_n_f32(gain);
+	for ( ; (index + 4) <= count; index += 4)
+		vst1q_f32(&dest[index], vmulq_f32(vld1q_f32(&src[index]), g));
+#endif
+	for ( ; index < count; index++)
+		dest[index] = src[index] * gain;
+}
+
+
+//-------------------------------------------------
+//  mix - dest[i] += src[i] * gain
+//-------------------------------------------------
+
+inline void mix(float *dest, float const *src, float gain, s32 count)
+{
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+	if (use_avx2 && (count >= AVX2_MIN_RUN))
+		return mix_avx2(dest, src, gain, count);
+#endif
+	s32 index = 0;
+#if defined(MAME_SOUND_SIMD_SSE2)
+	__m128 const g = _mm_set1_ps(gain);
+	for ( ; (index + 4) <= count; index += 4)
+		_mm_storeu_ps(&dest[index], _mm_add_ps(_mm_loadu_ps(&dest[index]), _mm_mul_ps(_mm_loadu_ps(&src[index]), g)));
+#elif defined(MAME_SOUND_SIMD_NEON)
+	float32x4_t const g = vdupq_n_f32(gain);
+	for ( ; (index + 4) <= count; index += 4)
+		vst1q_f32(&dest[index], vmlaq_f32(vld1q_f32(&dest[index]), vld1q_f32(&src[index]), g));
+#endif
+	for ( ; index < count; index++)
+		dest[index] += src[index] * gain;
+}
+
+
+//-------------------------------------------------
+//  mix_pan - mix a mono source into a pair of
+//  destinations with separate gains
+//-------------------------------------------------
+
+inline void mix_pan(float *left, float *right, float const *src, float leftgain, float rightgain, s32 count)
+{
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+	if (use_avx2 && (count >= AVX2_MIN_RUN))
+		return mix_pan_avx2(left, right, src, leftgain, rightgain, count);
+#endif
+	s32 index = 0;
+#if defined(MAME_SOUND_SIMD_SSE2)
+	__m128 const lg = _mm_set1_ps(leftgain);
+	__m128 const rg = _mm_set1_ps(rightgain);
+	for ( ; (index + 4) <= count; index += 4)
+	{
+		__m128 const s = _mm_loadu_ps(&src[index]);
+		_mm_storeu_ps(&left[index], _mm_add_ps(_mm_loadu_ps(&left[index]), _mm_mul_ps(s, lg)));
+		_mm_storeu_ps(&right[index], _mm_add_ps(_mm_loadu_ps(&right[index]), _mm_mul_ps(s, rg)));
+	}
+#elif defined(MAME_SOUND_SIMD_NEON)
+	float32x4_t const lg = vdupq_n_f32(leftgain);
+	float32x4_t const rg = vdupq_n_f32(rightgain);
+	for ( ; (index + 4) <= count; index += 4)
+	{
+		float32x4_t const s = vld1q_f32(&src[index]);
+		vst1q_f32(&left[index], vmlaq_f32(vld1q_f32(&left[index]), s, lg));
+		vst1q_f32(&right[index], vmlaq_f32(vld1q_f32(&right[index]), s, rg));
+	}
+#endif
+	for ( ; index < count; index++)
+	{
+		left[index] += src[index] * leftgain;
+		right[index] += src[index] * rightgain;
+	}
+}
+
+
+//-------------------------------------------------
+//  sum - return the sum of a run of samples
+//-------------------------------------------------
+
+inline float sum(float const *src, s32 count)
+{
+#if defined(MAME_SOUND_SIMD_AVX2_DISPATCH)
+	if (use_avx2 && (count >= AVX2_MIN_RUN))
+		return sum_avx2(src, count);
+#endif
+	s32 index = 0;
+	float result = 0.0f;
+#if defined(MAME_SOUND_SIMD_SSE2)
+	__m128 acc = _mm_setzero_ps();
+	for ( ; (index + 4) <= count; index += 4)
+		acc = _mm_add_ps(acc, _mm_loadu_ps(&src[index]));
+	acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+	acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+	result = _mm_cvtss_f32(acc);
+#elif defined(MAME_SOUND_SIMD_NEON)
+	float32x4_t acc = vdupq_n_f32(0.0f);
+	for ( ; (index + 4) <= count; index += 4)
+		acc = vaddq_f32(acc, vld1q_f32(&src[index]));
+	float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	result = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+	for ( ; index < count; index++)
+		result += src[index];
+	return result;
+}
+
+} // namespace emu::sound_simd
+
+#endif // MAME_EMU_SOUNDSIMD_H
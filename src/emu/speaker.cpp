@@ -119,28 +119,28 @@ void speaker_device::mix(stream_buffer::sample_t *leftmix, stream_buffer::sample
 	// mix if sound is enabled
 	if (!suppress)
 	{
-		// if the speaker is hard panned to the left, send only to the left
-		if (m_pan == -1.0f)
-			for (int sample = 0; sample < expected_samples; sample++)
-				leftmix[sample] += view.get(sample);
-
-		// if the speaker is hard panned to the right, send only to the right
-		else if (m_pan == 1.0f)
-			for (int sample = 0; sample < expected_samples; sample++)
-				rightmix[sample] += view.get(sample);
-
-		// otherwise, send to both
-		else
+		const float leftpan = (m_pan <= 0.0f) ? 1.0f : 1.0f - m_pan;
+		const float rightpan = (m_pan >= 0.0f) ? 1.0f : 1.0f + m_pan;
+
+		// work through contiguous runs of the stream buffer
+		for (int sample = 0; sample < expected_samples; )
 		{
-			const float leftpan = (m_pan <= 0.0f) ? 1.0f : 1.0f - m_pan;
-			const float rightpan = (m_pan >= 0.0f) ? 1.0f : 1.0f + m_pan;
+			s32 run = expected_samples - sample;
+			stream_buffer::sample_t const *src = view.getraw_run(sample, run);
 
-			for (int sample = 0; sample < expected_samples; sample++)
-			{
-				stream_buffer::sample_t cursample = view.get(sample);
-				leftmix[sample] += cursample * leftpan;
-				rightmix[sample] += cursample * rightpan;
-			}
+			// if the speaker is hard panned to the left, send only to the left
+			if (m_pan == -1.0f)
+				emu::sound_simd::mix(&leftmix[sample], src, view.gain(), run);
+
+			// if the speaker is hard panned to the right, send only to the right
+			else if (m_pan == 1.0f)
+				emu::sound_simd::mix(&rightmix[sample], src, view.gain(), run);
+
+			// otherwise, send to both
+			else
+				emu::sound_simd::mix_pan(&leftmix[sample], &rightmix[sample], src, view.gain() * leftpan, view.gain() * rightpan, run);
+
+			sample += run;
 		}
 	}
 }
@@ -19,6 +19,7 @@
 #include "imagedev/cassette.h"
 
 #include "debugger.h"
+#include "diserial.h"
 #include "drivenum.h"
 #include "emuopts.h"
 #include "fileio.h"
@@ -206,31 +207,173 @@ struct plugin_options_plugins
 };
 
 
+void resume_task(lua_State *L, int ref, bool status, std::optional<u64> value = std::nullopt)
+{
+	lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+	lua_State *const thread = lua_tothread(L, -1);
+	lua_pop(L, 1);
+	lua_pushboolean(thread, status ? 1 : 0);
+	if (value)
+		lua_pushinteger(thread, lua_Integer(*value));
+	int nresults = 0;
+	int const stat = lua_resume(thread, nullptr, value ? 2 : 1, &nresults);
+	if ((stat != LUA_OK) && (stat != LUA_YIELD))
+	{
+		osd_printf_error("[LUA ERROR] in resume: %s\n", lua_tostring(thread, -1));
+		lua_pop(thread, 1);
+	}
+	else
+	{
+		lua_pop(thread, nresults);
+	}
+	luaL_unref(L, LUA_REGISTRYINDEX, ref);
+}
+
+
 template <typename T>
 void resume_tasks(lua_State *L, T &&tasks, bool status)
 {
 	for (int ref : tasks)
+		resume_task(L, ref, status);
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  data_waiter - a coroutine suspended until the
+//  emulated system produces some data; the
+//  condition is checked natively so Lua only runs
+//  once it's met
+//-------------------------------------------------
+
+class lua_engine::data_waiter
+{
+public:
+	data_waiter(data_waiter const &) = delete;
+	data_waiter(data_waiter &&) = delete;
+	virtual ~data_waiter() = default;
+
+	int ref() const noexcept { return m_ref; }
+	bool fired() const noexcept { return m_fired; }
+	u64 data() const noexcept { return m_data; }
+
+protected:
+	data_waiter(lua_engine &host, int ref) : m_host(host), m_ref(ref), m_fired(false), m_data(0) { }
+
+	// the coroutine is resumed from a timer, outside the access
+	void fire(u64 data)
 	{
-		lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
-		lua_State *const thread = lua_tothread(L, -1);
-		lua_pop(L, 1);
-		lua_pushboolean(thread, status ? 1 : 0);
-		int nresults = 0;
-		int const stat = lua_resume(thread, nullptr, 1, &nresults);
-		if ((stat != LUA_OK) && (stat != LUA_YIELD))
-		{
-			osd_printf_error("[LUA ERROR] in resume: %s\n", lua_tostring(thread, -1));
-			lua_pop(thread, 1);
-		}
-		else
+		m_fired = true;
+		m_data = data;
+		m_host.m_wake_timer->adjust(attotime::zero);
+	}
+
+private:
+	lua_engine &m_host;
+	int const m_ref;
+	bool m_fired;
+	u64 m_data;
+};
+
+
+//-------------------------------------------------
+//  write_waiter - wait for a matching write to an
+//  address
+//-------------------------------------------------
+
+class lua_engine::write_waiter : public data_waiter
+{
+public:
+	write_waiter(lua_engine &host, address_space &space, offs_t address, std::optional<u64> value, u64 mask, int ref)
+		: data_waiter(host, ref)
+		, m_space(space)
+		, m_handler()
+		, m_address(address)
+		, m_value(value)
+		, m_mask(mask)
+		, m_installing(0U)
+	{
+		m_notifier = space.add_change_notifier(
+				[this] (read_or_write mode)
+				{
+					if (read_or_write::READ != mode)
+						install();
+				});
+		install();
+	}
+
+	virtual ~write_waiter()
+	{
+		++m_installing;
+		m_handler.remove();
+	}
+
+private:
+	void install()
+	{
+		switch (m_space.data_width())
 		{
-			lua_pop(thread, nresults);
+		case  8: do_install<u8>();  break;
+		case 16: do_install<u16>(); break;
+		case 32: do_install<u32>(); break;
+		case 64: do_install<u64>(); break;
 		}
-		luaL_unref(L, LUA_REGISTRYINDEX, ref);
 	}
-}
 
-} // anonymous namespace
+	template <typename T>
+	void do_install()
+	{
+		if (m_installing)
+			return;
+		++m_installing;
+		m_handler.remove();
+		m_handler = m_space.install_write_tap(
+				m_address,
+				m_address,
+				"lua_wait",
+				[this] (offs_t offset, T &data, T mem_mask)
+				{
+					// only writes to the watched lanes count, and only those lanes are compared
+					if (!fired() && (mem_mask & m_mask) && (!m_value || !((data ^ *m_value) & m_mask & mem_mask)))
+						fire(data & mem_mask);
+				},
+				&m_handler);
+		--m_installing;
+	}
+
+	address_space &m_space;
+	memory_passthrough_handler m_handler;
+	util::notifier_subscription m_notifier;
+	offs_t const m_address;
+	std::optional<u64> const m_value;
+	u64 const m_mask;
+	unsigned m_installing;
+};
+
+
+//-------------------------------------------------
+//  serial_waiter - wait for a serial device to
+//  send or receive a character
+//-------------------------------------------------
+
+class lua_engine::serial_waiter : public data_waiter
+{
+public:
+	serial_waiter(lua_engine &host, device_serial_interface &serial, std::optional<u8> value, bool transmit, bool receive, int ref)
+		: data_waiter(host, ref)
+	{
+		m_notifier = serial.add_character_notifier(
+				[this, value, transmit, receive] (bool transmitted, u8 data)
+				{
+					if (!fired() && (transmitted ? transmit : receive) && (!value || (*value == data)))
+						fire(data);
+				});
+	}
+
+private:
+	util::notifier_subscription m_notifier;
+};
 
 
 namespace sol {
@@ -477,6 +620,7 @@ lua_engine::lua_engine()
 	: m_lua_state(nullptr)
 	, m_machine(nullptr)
 	, m_timer(nullptr)
+	, m_wake_timer(nullptr)
 {
 	m_lua_state = luaL_newstate();  // create state
 	m_sol_state = std::make_unique<sol::state_view>(m_lua_state); // create sol view
@@ -653,6 +797,8 @@ void lua_engine::on_machine_stop()
 	m_waiting_tasks.clear();
 	resume_tasks(m_lua_state, expired, false);
 	expired.clear();
+	cancel_writers();
+	m_wake_timer = nullptr;
 
 	m_notifiers->on_stop();
 	execute_function("LUA_ON_STOP");
@@ -702,6 +848,8 @@ void lua_engine::on_machine_postload()
 	m_waiting_tasks.clear();
 	resume_tasks(m_lua_state, expired, false);
 	expired.clear();
+	m_wake_timer->reset();
+	cancel_writers();
 
 	m_notifiers->on_postload();
 }
@@ -751,6 +899,7 @@ void lua_engine::attach_notifiers()
 	machine().save().register_postload(save_prepost_delegate(FUNC(lua_engine::on_machine_postload), this));
 
 	m_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(lua_engine::resume), this));
+	m_wake_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(lua_engine::resume_writers), this));
 }
 
 //-------------------------------------------------
@@ -869,6 +1018,31 @@ void lua_engine::initialize()
 				m_frame_tasks.emplace_back(luaL_ref(s, LUA_REGISTRYINDEX));
 				return sol::variadic_results(args.begin(), args.end());
 			});
+	emu["wait_write"] = sol::yielding(
+			[this] (sol::this_state s, addr_space &sp, offs_t address, std::optional<u64> value, std::optional<u64> mask)
+			{
+				int const ret = lua_pushthread(s);
+				if (ret == 1)
+					luaL_error(s, "cannot wait from outside coroutine");
+				int const ref = luaL_ref(s, LUA_REGISTRYINDEX);
+				m_data_waiters.emplace_back(std::make_unique<write_waiter>(*this, sp.space, address, value, mask ? *mask : ~u64(0), ref));
+			});
+	emu["wait_serial"] = sol::yielding(
+			[this] (sol::this_state s, device_t &dev, std::optional<u8> value, std::optional<std::string_view> direction)
+			{
+				device_serial_interface *const serial = dynamic_cast<device_serial_interface *>(&dev);
+				if (!serial)
+					luaL_error(s, "device is not a serial device");
+				bool const transmit = !direction || (*direction == "tx");
+				bool const receive = !direction || (*direction == "rx");
+				if (!transmit && !receive)
+					luaL_error(s, "direction must be \"tx\" or \"rx\"");
+				int const ret = lua_pushthread(s);
+				if (ret == 1)
+					luaL_error(s, "cannot wait from outside coroutine");
+				int const ref = luaL_ref(s, LUA_REGISTRYINDEX);
+				m_data_waiters.emplace_back(std::make_unique<serial_waiter>(*this, *serial, value, transmit, receive, ref));
+			});
 	emu.set_function("add_machine_reset_notifier", make_notifier_adder(m_notifiers->on_reset, "machine reset"));
 	emu.set_function("add_machine_stop_notifier", make_notifier_adder(m_notifiers->on_stop, "machine stop"));
 	emu.set_function("add_machine_pause_notifier", make_notifier_adder(m_notifiers->on_pause, "machine pause"));
@@ -2181,6 +2355,7 @@ void lua_engine::close()
 	m_menu.clear();
 	m_update_tasks.clear();
 	m_frame_tasks.clear();
+	m_data_waiters.clear();
 	m_sol_state.reset();
 	if (m_lua_state)
 	{
@@ -2207,6 +2382,42 @@ void lua_engine::resume(s32 param)
 	resume_tasks(m_lua_state, expired, true);
 }
 
+//-------------------------------------------------
+//  resume_writers - resume all coroutines whose
+//  awaited data has arrived since the last call
+//-------------------------------------------------
+
+void lua_engine::resume_writers(s32 param)
+{
+	// remove the taps first so resumed coroutines can wait again
+	std::vector<std::pair<int, u64> > fired;
+	auto const pos = std::stable_partition(
+			m_data_waiters.begin(),
+			m_data_waiters.end(),
+			[] (auto const &w) { return !w->fired(); });
+	for (auto it = pos; m_data_waiters.end() != it; ++it)
+		fired.emplace_back((*it)->ref(), (*it)->data());
+	m_data_waiters.erase(pos, m_data_waiters.end());
+
+	for (auto const &task : fired)
+		resume_task(m_lua_state, task.first, true, task.second);
+}
+
+//-------------------------------------------------
+//  cancel_writers - resume all coroutines waiting
+//  for data with a failure status
+//-------------------------------------------------
+
+void lua_engine::cancel_writers()
+{
+	std::vector<int> cancelled;
+	cancelled.reserve(m_data_waiters.size());
+	for (auto const &waiter : m_data_waiters)
+		cancelled.emplace_back(waiter->ref());
+	m_data_waiters.clear();
+	resume_tasks(m_lua_state, cancelled, false);
+}
+
 //-------------------------------------------------
 //  load_script - load script from file path
 //-------------------------------------------------
@@ -159,6 +159,9 @@ private:
 	class palette_wrapper;
 	template <typename T> class bitmap_helper;
 	class tap_helper;
+	class data_waiter;
+	class write_waiter;
+	class serial_waiter;
 	class addr_space_change_notif;
 	class symbol_table_wrapper;
 	class expression_wrapper;
@@ -171,6 +174,7 @@ private:
 	std::vector<std::string> m_menu;
 
 	emu_timer *m_timer;
+	emu_timer *m_wake_timer;
 
 	// machine event notifiers
 	std::optional<notifiers> m_notifiers;
@@ -179,6 +183,7 @@ private:
 	std::vector<std::pair<attotime, int> > m_waiting_tasks;
 	std::vector<int> m_update_tasks;
 	std::vector<int> m_frame_tasks;
+	std::vector<std::unique_ptr<data_waiter> > m_data_waiters;
 
 	template <typename... T>
 	auto make_notifier_adder(util::notifier<T...> &notifier, const char *desc);
@@ -197,6 +202,8 @@ private:
 	void on_machine_postload();
 
 	void resume(s32 param);
+	void resume_writers(s32 param);
+	void cancel_writers();
 	void register_function(sol::function func, const char *id);
 	template <typename T> size_t enumerate_functions(const char *id, T &&callback);
 	bool execute_function(const char *id);
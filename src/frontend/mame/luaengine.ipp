@@ -541,6 +541,8 @@ struct lua_engine::addr_space
 	template <typename T> void log_mem_write(offs_t address, T val);
 	template <typename T> T direct_mem_read(offs_t address);
 	template <typename T> void direct_mem_write(offs_t address, T val);
+	void block_read(offs_t address, u8 *dest, size_t length);
+	void block_write(offs_t address, u8 const *src, size_t length);
 
 	address_space &space;
 	device_memory_interface &dev;
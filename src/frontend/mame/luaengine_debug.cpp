@@ -15,6 +15,7 @@
 #include "debug/debugcpu.h"
 #include "debug/debugvw.h"
 #include "debug/express.h"
+#include "debug/memsearch.h"
 #include "debug/points.h"
 #include "debug/textbuf.h"
 #include "debugger.h"
@@ -539,4 +540,77 @@ void lua_engine::initialize_debug(sol::table &emu)
 	watchpoint_type["condition"] = sol::property(&debug_watchpoint::condition);
 	watchpoint_type["action"] = sol::property(&debug_watchpoint::action);
 
+
+	static const enum_parser<endianness_t, 2> s_endianness_parser =
+	{
+		{ "little", ENDIANNESS_LITTLE },
+		{ "big", ENDIANNESS_BIG }
+	};
+
+	auto memory_search_type = emu.new_usertype<debug_memory_search>(
+			"memory_search",
+			sol::call_constructor, sol::factories(
+				[] (sol::this_state s, size_t length, unsigned width, std::optional<std::string_view> endian, std::optional<bool> is_signed, std::optional<unsigned> step)
+				{
+					if ((width != 1) && (width != 2) && (width != 4) && (width != 8))
+						luaL_error(s, "Invalid width. Must be 1/2/4/8");
+					return std::make_unique<debug_memory_search>(
+							length,
+							width,
+							s_endianness_parser(endian ? *endian : std::string_view()),
+							is_signed && *is_signed,
+							step ? *step : 0);
+				}));
+	memory_search_type.set_function(
+			"filter",
+			[] (debug_memory_search &search, sol::this_state s, std::string_view cond, std::string_view newdata, sol::object olddata, std::optional<s64> value)
+			{
+				debug_memory_search::condition c;
+				if (!debug_memory_search::parse_condition(cond, c))
+					luaL_error(s, "Invalid condition");
+				if (newdata.size() < search.length())
+					luaL_error(s, "Snapshot is shorter than the search length");
+				std::string_view old;
+				if (olddata.is<std::string_view>())
+				{
+					old = olddata.as<std::string_view>();
+					if (old.size() < search.length())
+						luaL_error(s, "Snapshot is shorter than the search length");
+				}
+				else if ((c != debug_memory_search::condition::EQV) && (c != debug_memory_search::condition::NEV) &&
+						(c != debug_memory_search::condition::LTV) && (c != debug_memory_search::condition::GTV))
+				{
+					luaL_error(s, "Condition requires a previous snapshot");
+				}
+				search.filter(
+						reinterpret_cast<u8 const *>(newdata.data()),
+						old.empty() ? nullptr : reinterpret_cast<u8 const *>(old.data()),
+						c,
+						u64(value ? *value : 0));
+				return search.count();
+			});
+	memory_search_type.set_function(
+			"matches",
+			[] (debug_memory_search &search, sol::this_state s, std::optional<size_t> limit)
+			{
+				sol::table result = sol::state_view(s).create_table();
+				int index = 1;
+				for (size_t offset : search.matches(limit ? *limit : ~size_t(0)))
+					result[index++] = offset;
+				return result;
+			});
+	memory_search_type.set_function(
+			"value",
+			[] (debug_memory_search &search, std::string_view data, size_t offset) -> std::optional<s64>
+			{
+				if ((offset + search.width()) > data.size())
+					return std::nullopt;
+				return s64(search.value(reinterpret_cast<u8 const *>(data.data()), offset));
+			});
+	memory_search_type.set_function("reset", &debug_memory_search::reset);
+	memory_search_type["count"] = sol::property(&debug_memory_search::count);
+	memory_search_type["length"] = sol::property(&debug_memory_search::length);
+	memory_search_type["width"] = sol::property(&debug_memory_search::width);
+	memory_search_type["step"] = sol::property(&debug_memory_search::step);
+
 }
@@ -11,7 +11,10 @@
 #include "emu.h"
 #include "luaengine.ipp"
 
+#include "multibyte.h"
+
 #include <cstring>
+#include <string_view>
 
 
 namespace {
@@ -120,6 +123,18 @@ void share_write(memory_share &share, offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  memory_block - raw bytes of a region or share,
+//  accessed in place
+//  -> manager.machine.memory.regions[":maincpu"]:view()
+//-------------------------------------------------
+
+struct memory_block
+{
+	u8 *base;
+	size_t size;
+};
+
 } // anonymous namespace
 
 
@@ -525,6 +540,87 @@ void lua_engine::addr_space::direct_mem_write(offs_t address, T val)
 	}
 }
 
+//-------------------------------------------------
+//  block_read - read a run of bytes, using whole
+//  bus-width accesses where they're aligned
+//  -> manager.machine.devices[":maincpu"].spaces["program"]:read_block(0xC000, 0x100)
+//-------------------------------------------------
+
+void lua_engine::addr_space::block_read(offs_t address, u8 *dest, size_t length)
+{
+	unsigned const width = space.data_width() / 8;
+	bool const big = space.endianness() == ENDIANNESS_BIG;
+	offs_t const mask = space.addrmask();
+	size_t done = 0;
+	while (done < length)
+	{
+		offs_t const addr = (address + done) & mask;
+		if ((space.addr_shift() != 0) || (width == 1) || (addr & (width - 1)) || ((length - done) < width))
+		{
+			dest[done++] = space.read_byte(addr);
+			continue;
+		}
+		switch (width)
+		{
+		case 2:
+			if (big)
+				put_u16be(&dest[done], space.read_word(addr));
+			else
+				put_u16le(&dest[done], space.read_word(addr));
+			break;
+		case 4:
+			if (big)
+				put_u32be(&dest[done], space.read_dword(addr));
+			else
+				put_u32le(&dest[done], space.read_dword(addr));
+			break;
+		case 8:
+			if (big)
+				put_u64be(&dest[done], space.read_qword(addr));
+			else
+				put_u64le(&dest[done], space.read_qword(addr));
+			break;
+		}
+		done += width;
+	}
+}
+
+//-------------------------------------------------
+//  block_write - write a run of bytes, using whole
+//  bus-width accesses where they're aligned
+//  -> manager.machine.devices[":maincpu"].spaces["program"]:write_block(0xC000, data)
+//-------------------------------------------------
+
+void lua_engine::addr_space::block_write(offs_t address, u8 const *src, size_t length)
+{
+	unsigned const width = space.data_width() / 8;
+	bool const big = space.endianness() == ENDIANNESS_BIG;
+	offs_t const mask = space.addrmask();
+	size_t done = 0;
+	while (done < length)
+	{
+		offs_t const addr = (address + done) & mask;
+		if ((space.addr_shift() != 0) || (width == 1) || (addr & (width - 1)) || ((length - done) < width))
+		{
+			space.write_byte(addr, src[done++]);
+			continue;
+		}
+		switch (width)
+		{
+		case 2:
+			space.write_word(addr, big ? get_u16be(&src[done]) : get_u16le(&src[done]));
+			break;
+		case 4:
+			space.write_dword(addr, big ? get_u32be(&src[done]) : get_u32le(&src[done]));
+			break;
+		case 8:
+			space.write_qword(addr, big ? get_u64be(&src[done]) : get_u64le(&src[done]));
+			break;
+		}
+		done += width;
+	}
+}
+
 //-------------------------------------------------
 //  initialize_memory - register memory user types
 //-------------------------------------------------
@@ -647,6 +743,47 @@ void lua_engine::initialize_memory(sol::table &emu)
 				luaL_pushresultsize(&buff, byte_count);
 				return sol::make_reference(s, sol::stack_reference(s, -1));
 			});
+	addr_space_type.set_function("read_block",
+			[] (addr_space &sp, sol::this_state s, offs_t address, offs_t length)
+			{
+				buffer_helper buf(s);
+				auto space = buf.prepare(length);
+				sp.block_read(address, reinterpret_cast<u8 *>(space.get()), length);
+				space.add(length);
+				buf.push();
+				return sol::make_reference(s, sol::stack_reference(s, -1));
+			});
+	addr_space_type.set_function("write_block",
+			[] (addr_space &sp, offs_t address, std::string_view data)
+			{
+				sp.block_write(address, reinterpret_cast<u8 const *>(data.data()), data.size());
+			});
+	addr_space_type.set_function("find",
+			[] (addr_space &sp, sol::this_state s, offs_t first, offs_t last, std::string_view pattern) -> std::optional<offs_t>
+			{
+				if ((first > sp.space.addrmask()) || (last > sp.space.addrmask()) || (last < first))
+				{
+					luaL_error(s, "Invalid offset");
+					return std::nullopt;
+				}
+				if (pattern.empty() || ((last - first) < (pattern.size() - 1)))
+					return std::nullopt;
+
+				// search in chunks that overlap by one byte less than the pattern
+				constexpr size_t CHUNK = 0x10000;
+				std::vector<u8> buffer(CHUNK + pattern.size() - 1);
+				u64 const end = u64(last) + 1;
+				for (u64 start = first; (start + pattern.size()) <= end; start += CHUNK)
+				{
+					size_t const length = std::min<u64>(buffer.size(), end - start);
+					sp.block_read(offs_t(start), buffer.data(), length);
+					std::string_view const chunk(reinterpret_cast<char const *>(buffer.data()), length);
+					size_t const found = chunk.find(pattern);
+					if (found != std::string_view::npos)
+						return offs_t(start + found);
+				}
+				return std::nullopt;
+			});
 	addr_space_type.set_function("add_change_notifier",
 			[this] (addr_space &sp, sol::protected_function &&cb)
 			{
@@ -767,6 +904,7 @@ void lua_engine::initialize_memory(sol::table &emu)
 	region_type.set_function("write_u32", &region_write<u32>);
 	region_type.set_function("write_i64", &region_write<s64>);
 	region_type.set_function("write_u64", &region_write<u64>);
+	region_type.set_function("view", [] (memory_region &region) { return memory_block{ region.base(), region.bytes() }; });
 	region_type["tag"] = sol::property(&memory_region::name);
 	region_type["size"] = sol::property(&memory_region::bytes);
 	region_type["length"] = sol::property([] (memory_region &r) { return r.bytes() / r.bytewidth(); });
@@ -792,6 +930,7 @@ void lua_engine::initialize_memory(sol::table &emu)
 	share_type.set_function("write_u32", &share_write<u32>);
 	share_type.set_function("write_i64", &share_write<s64>);
 	share_type.set_function("write_u64", &share_write<u64>);
+	share_type.set_function("view", [] (memory_share &share) { return memory_block{ reinterpret_cast<u8 *>(share.ptr()), share.bytes() }; });
 	share_type["tag"] = sol::property(&memory_share::name);
 	share_type["size"] = sol::property(&memory_share::bytes);
 	share_type["length"] = sol::property([] (memory_share &s) { return s.bytes() / s.bytewidth(); });
@@ -799,4 +938,45 @@ void lua_engine::initialize_memory(sol::table &emu)
 	share_type["bitwidth"] = sol::property(&memory_share::bitwidth);
 	share_type["bytewidth"] = sol::property(&memory_share::bytewidth);
 
+
+	auto block_type = sol().registry().new_usertype<memory_block>("memblock", sol::no_constructor);
+	block_type.set_function(
+			"read",
+			[] (memory_block const &block, sol::this_state s, size_t offset, size_t length)
+			{
+				buffer_helper buf(s);
+				size_t const copyable = (offset < block.size) ? std::min(length, block.size - offset) : 0;
+				auto space = buf.prepare(copyable);
+				if (copyable)
+					std::memcpy(space.get(), &block.base[offset], copyable);
+				space.add(copyable);
+				buf.push();
+				return sol::make_reference(s, sol::stack_reference(s, -1));
+			});
+	block_type.set_function(
+			"write",
+			[] (memory_block &block, size_t offset, std::string_view data)
+			{
+				if (offset < block.size)
+					std::memcpy(&block.base[offset], data.data(), std::min(data.size(), block.size - offset));
+			});
+	block_type.set_function(
+			"find",
+			[] (memory_block const &block, std::string_view pattern, std::optional<size_t> start) -> std::optional<size_t>
+			{
+				std::string_view const bytes(reinterpret_cast<char const *>(block.base), block.size);
+				size_t const found = bytes.find(pattern, start ? *start : 0);
+				if (found == std::string_view::npos)
+					return std::nullopt;
+				return found;
+			});
+	block_type.set_function(
+			"equals",
+			[] (memory_block const &block, size_t offset, std::string_view data)
+			{
+				return (offset <= block.size) && (data.size() <= (block.size - offset)) && !std::memcmp(&block.base[offset], data.data(), data.size());
+			});
+	block_type.set_function(sol::meta_function::length, [] (memory_block const &block) { return block.size; });
+	block_type["size"] = sol::readonly(&memory_block::size);
+
 }
@@ -22,10 +22,12 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
 #include <ctime>
+#include <iterator>
 #include <new>
 #include <tuple>
 
@@ -2827,6 +2829,59 @@ chd_file_compressor::~chd_file_compressor()
 		delete elem;
 }
 
+/**
+ * @fn  std::error_condition chd_file_compressor::train_dictionary()
+ *
+ * @brief   -------------------------------------------------
+ *            train_dictionary - if one of our codecs uses a
+ *            shared dictionary, train it from hunks sampled
+ *            evenly across the source and store it in the
+ *            metadata; must be called before compress_begin
+ *          -------------------------------------------------.
+ *
+ * @return  A std::error_condition; not_supported if no codec wants a dictionary.
+ */
+
+std::error_condition chd_file_compressor::train_dictionary()
+{
+	auto const codec = std::find_if(std::begin(m_compression), std::end(m_compression), &chd_codec_list::codec_uses_dictionary);
+	if (codec == std::end(m_compression))
+		return std::errc::not_supported;
+
+	// aim for around 100 bytes of samples per dictionary byte
+	constexpr uint32_t MAX_DICTIONARY_BYTES = 64 * 1024;
+	constexpr uint64_t MAX_SAMPLE_BYTES = 100 * MAX_DICTIONARY_BYTES;
+	uint32_t const samplecount = uint32_t(std::min<uint64_t>(hunk_count(), MAX_SAMPLE_BYTES / hunk_bytes() + 1));
+	std::vector<uint8_t> samples(uint64_t(samplecount) * hunk_bytes());
+	std::vector<size_t> sizes;
+	sizes.reserve(samplecount);
+	uint64_t total = 0;
+	for (uint32_t samplenum = 0; samplenum < samplecount; samplenum++)
+	{
+		// blank hunks teach the dictionary nothing
+		uint64_t const hunknum = uint64_t(samplenum) * hunk_count() / samplecount;
+		uint8_t *const dest = &samples[total];
+		uint32_t const length = read_data(dest, hunknum * hunk_bytes(), hunk_bytes());
+		if (length && std::any_of(dest, dest + length, [] (uint8_t b) { return b != 0; }))
+		{
+			sizes.push_back(length);
+			total += length;
+		}
+	}
+	samples.resize(total);
+
+	// the trainer needs a reasonable spread of samples to work with
+	if (sizes.size() < 8)
+		return error::INVALID_DATA;
+
+	std::vector<uint8_t> dictionary;
+	std::error_condition err = chd_codec_list::train_dictionary(*codec, samples, sizes, uint32_t(std::min<uint64_t>(MAX_DICTIONARY_BYTES, total / 10)), dictionary);
+	// leave it out of the SHA-1: it depends on the compression settings, not the content
+	if (!err)
+		err = write_metadata(ZSTD_DICT_METADATA_TAG, 0, dictionary, 0);
+	return err;
+}
+
 /**
  * @fn  void chd_file_compressor::compress_begin()
  *
@@ -3322,6 +3377,321 @@ void chd_file_compressor::hashmap::add(uint64_t itemnum, util::crc16_t crc16, ut
 	m_map[crc16] = entry;
 }
 
+//**************************************************************************
+//  CHD PARALLEL READER
+//**************************************************************************
+
+/**
+ * @fn  chd_parallel_reader::chd_parallel_reader(chd_file &file)
+ *
+ * @brief   -------------------------------------------------
+ *            chd_parallel_reader - constructor
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  file    The CHD to read from.  Must stay open for the
+ *                          lifetime of the reader.
+ */
+
+chd_parallel_reader::chd_parallel_reader(chd_file &file)
+	: m_file(file),
+		m_parallel(false),
+		m_work_queue(nullptr),
+		m_batch_hunk(0),
+		m_batch_count(0),
+		m_batch_buffer(nullptr),
+		m_batch_pending(false),
+		m_decompress_error(false)
+{
+	m_parallel = can_decompress_in_parallel();
+	if (m_parallel)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+/**
+ * @fn  chd_parallel_reader::~chd_parallel_reader()
+ *
+ * @brief   -------------------------------------------------
+ *            ~chd_parallel_reader - destructor
+ *          -------------------------------------------------.
+ */
+
+chd_parallel_reader::~chd_parallel_reader()
+{
+	// don't free buffers out from under the workers
+	if (m_batch_pending)
+		read_hunks_end();
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
+}
+
+/**
+ * @fn  bool chd_parallel_reader::can_decompress_in_parallel() const
+ *
+ * @brief   -------------------------------------------------
+ *            can_decompress_in_parallel - determine whether
+ *            hunks can be decoded independently; anything else
+ *            is read serially through the CHD
+ *          -------------------------------------------------.
+ *
+ * @return  true if the map and codecs allow it.
+ */
+
+bool chd_parallel_reader::can_decompress_in_parallel() const
+{
+	// only V5 maps give us the codec, length and CRC of each hunk up front
+	if (!m_file.opened() || (m_file.version() < 5) || !m_file.compressed())
+		return false;
+
+	// A/V codecs need per-file configuration we can't replicate per thread
+	for (int codecnum = 0; codecnum < std::size(m_file.m_compression); codecnum++)
+		if (m_file.compression(codecnum) == CHD_CODEC_AVHUFF)
+			return false;
+	return true;
+}
+
+/**
+ * @fn  std::error_condition chd_parallel_reader::read_hunks_begin(uint32_t hunknum, uint32_t count, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks_begin - read the compressed data for a
+ *            run of hunks and queue them for decompression
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The first hunk to read.
+ * @param   count           Number of hunks to read.
+ * @param [out] buffer      Receives count hunks of data.  Must not be touched until
+ *                          read_hunks_end returns.
+ *
+ * @return  A std::error_condition.
+ */
+
+std::error_condition chd_parallel_reader::read_hunks_begin(uint32_t hunknum, uint32_t count, void *buffer)
+{
+	if (m_batch_pending)
+		return chd_file::error::OPERATION_PENDING;
+	if (!m_file.opened())
+		return chd_file::error::NOT_OPEN;
+	if ((hunknum >= m_file.hunk_count()) || (count > (m_file.hunk_count() - hunknum)))
+		return chd_file::error::HUNK_OUT_OF_RANGE;
+
+	uint32_t const hunkbytes = m_file.hunk_bytes();
+	m_batch_hunk = hunknum;
+	m_batch_count = count;
+	m_batch_buffer = reinterpret_cast<uint8_t *>(buffer);
+	m_decompress_error = false;
+	m_work_items.clear();
+	m_deferred.clear();
+
+	// without parallel support, everything is read in read_hunks_end
+	if (!m_parallel)
+	{
+		for (uint32_t index = 0; index < count; index++)
+			m_deferred.emplace_back(hunknum + index, m_batch_buffer + (uint64_t(index) * hunkbytes));
+		m_batch_pending = true;
+		return std::error_condition();
+	}
+
+	// size the compressed buffer up front; items reference it while we keep reading
+	uint32_t total = 0;
+	for (uint32_t index = 0; index < count; index++)
+	{
+		uint8_t const *const rawmap = &m_file.m_rawmap[m_file.m_mapentrybytes * (hunknum + index)];
+		if (rawmap[0] <= COMPRESSION_TYPE_3)
+			total += get_u24be(&rawmap[1]);
+	}
+	if (m_compressed.size() < total)
+		m_compressed.resize(total);
+	m_work_items.reserve(count);
+
+	try
+	{
+		// read sequentially, handing hunks to the workers in small groups as we go
+		static constexpr uint32_t QUEUE_GROUP = 16;
+		uint32_t compoffs = 0;
+		size_t queued = 0;
+		for (uint32_t index = 0; index < count; index++)
+		{
+			uint8_t *const dest = m_batch_buffer + (uint64_t(index) * hunkbytes);
+			uint8_t const *const rawmap = &m_file.m_rawmap[m_file.m_mapentrybytes * (hunknum + index)];
+			uint32_t const blocklen = get_u24be(&rawmap[1]);
+			uint64_t const blockoffs = get_u48be(&rawmap[4]);
+			util::crc16_t const blockcrc = get_u16be(&rawmap[10]);
+			std::unique_lock<std::mutex> lock(m_file_mutex);
+			switch (rawmap[0])
+			{
+				case COMPRESSION_TYPE_0:
+				case COMPRESSION_TYPE_1:
+				case COMPRESSION_TYPE_2:
+				case COMPRESSION_TYPE_3:
+					m_file.file_read(blockoffs, &m_compressed[compoffs], blocklen);
+					m_work_items.push_back(work_item{ this, dest, compoffs, blocklen, rawmap[0], blockcrc });
+					compoffs += blocklen;
+					break;
+
+				case COMPRESSION_NONE:
+					m_file.file_read(blockoffs, dest, hunkbytes);
+					m_work_items.push_back(work_item{ this, dest, 0, 0, 0xff, blockcrc });
+					break;
+
+				default:
+					m_deferred.emplace_back(hunknum + index, dest);
+					break;
+			}
+			lock.unlock();
+
+			if ((m_work_items.size() - queued) >= QUEUE_GROUP)
+			{
+				osd_work_item_queue_multiple(m_work_queue, async_decompress_static, m_work_items.size() - queued, &m_work_items[queued], sizeof(work_item), WORK_ITEM_FLAG_AUTO_RELEASE);
+				queued = m_work_items.size();
+			}
+		}
+		if (m_work_items.size() > queued)
+			osd_work_item_queue_multiple(m_work_queue, async_decompress_static, m_work_items.size() - queued, &m_work_items[queued], sizeof(work_item), WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+	catch (std::error_condition const &err)
+	{
+		// queued items point into the caller's buffer and m_work_items, so
+		// they must all have finished before we return
+		while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second())) { }
+		return err;
+	}
+
+	m_batch_pending = true;
+	return std::error_condition();
+}
+
+/**
+ * @fn  std::error_condition chd_parallel_reader::read_hunks_end()
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks_end - wait for the current batch and
+ *            resolve hunks that couldn't be decoded in parallel
+ *          -------------------------------------------------.
+ *
+ * @return  A std::error_condition.
+ */
+
+std::error_condition chd_parallel_reader::read_hunks_end()
+{
+	if (!m_batch_pending)
+		return chd_file::error::INVALID_STATE;
+	m_batch_pending = false;
+
+	if (m_work_queue)
+		while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second())) { }
+	if (m_decompress_error)
+		return chd_file::error::DECOMPRESSION_ERROR;
+
+	// now resolve self/parent references in hunk order
+	uint32_t const hunkbytes = m_file.hunk_bytes();
+	for (auto const &[hunknum, dest] : m_deferred)
+	{
+		// copies of a hunk the workers just decoded can come straight out of the buffer
+		if (m_parallel)
+		{
+			uint8_t const *const rawmap = &m_file.m_rawmap[m_file.m_mapentrybytes * hunknum];
+			uint64_t const source = get_u48be(&rawmap[4]);
+			if ((rawmap[0] == COMPRESSION_SELF) && (source >= m_batch_hunk) && (source < (m_batch_hunk + m_batch_count)))
+			{
+				uint8_t const *const sourcemap = &m_file.m_rawmap[m_file.m_mapentrybytes * source];
+				if (sourcemap[0] <= COMPRESSION_NONE)
+				{
+					memcpy(dest, m_batch_buffer + ((source - m_batch_hunk) * hunkbytes), hunkbytes);
+					continue;
+				}
+			}
+		}
+
+		std::error_condition const err = m_file.read_hunk(hunknum, dest);
+		if (err)
+			return err;
+	}
+	return std::error_condition();
+}
+
+/**
+ * @fn  std::error_condition chd_parallel_reader::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunks - read a run of hunks and wait for
+ *            them to be decompressed
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The first hunk to read.
+ * @param   count           Number of hunks to read.
+ * @param [out] buffer      Receives count hunks of data.
+ *
+ * @return  A std::error_condition.
+ */
+
+std::error_condition chd_parallel_reader::read_hunks(uint32_t hunknum, uint32_t count, void *buffer)
+{
+	std::error_condition err = read_hunks_begin(hunknum, count, buffer);
+	if (!err)
+		err = read_hunks_end();
+	return err;
+}
+
+/**
+ * @fn  void *chd_parallel_reader::async_decompress_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_decompress - decompress a single hunk on
+ *            a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   The work item.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_parallel_reader::async_decompress_static(void *param, int threadid)
+{
+	auto *const item = reinterpret_cast<work_item *>(param);
+	item->m_reader->async_decompress(*item, threadid);
+	return nullptr;
+}
+
+void chd_parallel_reader::async_decompress(work_item &item, int threadid)
+{
+	uint32_t const hunkbytes = m_file.hunk_bytes();
+
+	// uncompressed hunks were read directly; just check them
+	if (item.m_compression == 0xff)
+	{
+		if (util::crc16_creator::simple(item.m_dest, hunkbytes) != item.m_crc)
+			m_decompress_error = true;
+		return;
+	}
+
+	try
+	{
+		// use our thread's codec, creating it on first use
+		assert(threadid < std::size(m_codecs));
+		chd_decompressor::ptr &codec = m_codecs[threadid][item.m_compression];
+		if (!codec)
+		{
+			// some codecs read their setup from metadata, so keep the file to ourselves
+			std::lock_guard<std::mutex> lock(m_file_mutex);
+			codec = chd_codec_list::new_decompressor(m_file.compression(item.m_compression), m_file);
+			if (!codec)
+				throw std::error_condition(chd_file::error::UNKNOWN_COMPRESSION);
+		}
+
+		uint8_t const *const compressed = &m_compressed[item.m_compoffs];
+		codec->decompress(compressed, item.m_complen, item.m_dest, hunkbytes);
+		if (!codec->lossy() && (util::crc16_creator::simple(item.m_dest, hunkbytes) != item.m_crc))
+			m_decompress_error = true;
+		if (codec->lossy() && (util::crc16_creator::simple(compressed, item.m_complen) != item.m_crc))
+			m_decompress_error = true;
+	}
+	catch (...)
+	{
+		m_decompress_error = true;
+	}
+}
+
 bool chd_file::is_hd() const
 {
 	metadata_entry metaentry;
@@ -21,9 +21,12 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 
 /***************************************************************************
@@ -243,6 +246,9 @@ extern const char *AV_METADATA_FORMAT;
 // A/V laserdisc frame metadata
 constexpr chd_metadata_tag AV_LD_METADATA_TAG = CHD_MAKE_TAG('A','V','L','D');
 
+// trained dictionary for the zsdc codec
+constexpr chd_metadata_tag ZSTD_DICT_METADATA_TAG = CHD_MAKE_TAG('Z','D','C','T');
+
 
 
 //**************************************************************************
@@ -255,6 +261,7 @@ constexpr chd_metadata_tag AV_LD_METADATA_TAG = CHD_MAKE_TAG('A','V','L','D');
 class chd_file
 {
 	friend class chd_file_compressor;
+	friend class chd_parallel_reader;
 	friend class chd_verifier;
 
 	// constants
@@ -448,6 +455,7 @@ public:
 	virtual ~chd_file_compressor();
 
 	// compression management
+	std::error_condition train_dictionary();
 	void compress_begin();
 	std::error_condition compress_continue(double &progress, double &ratio);
 
@@ -578,6 +586,55 @@ private:
 };
 
 
+// ======================> chd_parallel_reader
+
+// class for reading runs of hunks from a CHD, decompressing them on all available cores
+class chd_parallel_reader
+{
+public:
+	// construction/destruction
+	chd_parallel_reader(chd_file &file);
+	~chd_parallel_reader();
+
+	// reading; a batch is queued by read_hunks_begin and completes in read_hunks_end
+	std::error_condition read_hunks_begin(uint32_t hunknum, uint32_t count, void *buffer);
+	std::error_condition read_hunks_end();
+	std::error_condition read_hunks(uint32_t hunknum, uint32_t count, void *buffer);
+
+private:
+	// a single hunk to decompress
+	struct work_item
+	{
+		chd_parallel_reader * m_reader;         // pointer back to the reader
+		uint8_t *             m_dest;           // where the hunk ends up
+		uint32_t              m_compoffs;       // offset of the compressed data in m_compressed
+		uint32_t              m_complen;        // compressed data length
+		uint8_t               m_compression;    // codec index, or 0xff if the data was read uncompressed
+		util::crc16_t         m_crc;            // CRC-16 from the map
+	};
+
+	// internal helpers
+	bool can_decompress_in_parallel() const;
+	static void *async_decompress_static(void *param, int threadid);
+	void async_decompress(work_item &item, int threadid);
+
+	// internal state
+	chd_file &              m_file;             // CHD we're reading from
+	bool                    m_parallel;         // can this CHD be decompressed on worker threads?
+	osd_work_queue *        m_work_queue;       // queue for decompressing on other threads
+	std::vector<work_item>  m_work_items;       // hunks queued in the current batch
+	std::vector<uint8_t>    m_compressed;       // compressed data for the current batch
+	std::vector<std::pair<uint32_t, uint8_t *> > m_deferred; // hunks resolved serially once the batch is done
+	uint32_t                m_batch_hunk;       // first hunk in the current batch
+	uint32_t                m_batch_count;      // number of hunks in the current batch
+	uint8_t *               m_batch_buffer;     // destination of the current batch
+	bool                    m_batch_pending;    // is a batch in flight?
+	std::atomic<bool>       m_decompress_error; // error found by a worker
+	std::mutex              m_file_mutex;       // serialises our reads with codecs that load metadata
+	chd_decompressor::ptr   m_codecs[WORK_MAX_THREADS + 1][4]; // per-thread decompressors
+};
+
+
 // error category for CHD errors
 std::error_category const &chd_category() noexcept;
 inline std::error_condition make_error_condition(chd_file::error err) noexcept { return std::error_condition(int(err), chd_category()); }
@@ -20,6 +20,7 @@
 #include "lzma/C/LzmaDec.h"
 #include "lzma/C/LzmaEnc.h"
 
+#include <zdict.h>
 #include <zlib.h>
 #include <zstd.h>
 
@@ -142,6 +143,46 @@ private:
 };
 
 
+// ======================> chd_zstd_dict_compressor
+
+// Zstandard compressor using a dictionary trained over the image
+class chd_zstd_dict_compressor : public chd_compressor
+{
+public:
+	// construction/destruction
+	chd_zstd_dict_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_dict_compressor();
+
+	// core functionality
+	virtual uint32_t compress(const uint8_t *src, uint32_t srclen, uint8_t *dest) override;
+
+private:
+	// internal state
+	ZSTD_CCtx *             m_context;
+	ZSTD_CDict *            m_dictionary;
+};
+
+
+// ======================> chd_zstd_dict_decompressor
+
+// Zstandard decompressor using a dictionary trained over the image
+class chd_zstd_dict_decompressor : public chd_decompressor
+{
+public:
+	// construction/destruction
+	chd_zstd_dict_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy);
+	~chd_zstd_dict_decompressor();
+
+	// core functionality
+	virtual void decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen) override;
+
+private:
+	// internal state
+	ZSTD_DCtx *             m_context;
+	ZSTD_DDict *            m_dictionary;
+};
+
+
 // ======================> chd_lzma_allocator
 
 // allocation helper clas for zlib
@@ -533,6 +574,7 @@ const codec_entry f_codec_list[] =
 	// general codecs
 	{ CHD_CODEC_ZLIB,       false,  "Deflate",              &codec_entry::construct_compressor<chd_zlib_compressor>,     &codec_entry::construct_decompressor<chd_zlib_decompressor> },
 	{ CHD_CODEC_ZSTD,       false,  "Zstandard",            &codec_entry::construct_compressor<chd_zstd_compressor>,     &codec_entry::construct_decompressor<chd_zstd_decompressor> },
+	{ CHD_CODEC_ZSTD_DICT,  false,  "Zstandard Dictionary", &codec_entry::construct_compressor<chd_zstd_dict_compressor>, &codec_entry::construct_decompressor<chd_zstd_dict_decompressor> },
 	{ CHD_CODEC_LZMA,       false,  "LZMA",                 &codec_entry::construct_compressor<chd_lzma_compressor>,     &codec_entry::construct_decompressor<chd_lzma_decompressor> },
 	{ CHD_CODEC_HUFFMAN,    false,  "Huffman",              &codec_entry::construct_compressor<chd_huffman_compressor>,  &codec_entry::construct_decompressor<chd_huffman_decompressor> },
 	{ CHD_CODEC_FLAC,       false,  "FLAC",                 &codec_entry::construct_compressor<chd_flac_compressor>,     &codec_entry::construct_decompressor<chd_flac_decompressor> },
@@ -688,6 +730,43 @@ const char *chd_codec_list::codec_name(chd_codec_type type)
 }
 
 
+//-------------------------------------------------
+//  codec_uses_dictionary - determine whether a
+//  codec wants a dictionary trained before
+//  compression begins
+//-------------------------------------------------
+
+bool chd_codec_list::codec_uses_dictionary(chd_codec_type type)
+{
+	return type == CHD_CODEC_ZSTD_DICT;
+}
+
+
+//-------------------------------------------------
+//  train_dictionary - build a dictionary of at
+//  most maxsize bytes from a set of samples
+//  stored back-to-back in a single buffer
+//-------------------------------------------------
+
+std::error_condition chd_codec_list::train_dictionary(chd_codec_type type, const std::vector<uint8_t> &samples, const std::vector<size_t> &sizes, uint32_t maxsize, std::vector<uint8_t> &dictionary)
+{
+	if (!codec_uses_dictionary(type))
+		return std::errc::not_supported;
+	if (sizes.empty() || !maxsize)
+		return std::errc::invalid_argument;
+
+	dictionary.resize(maxsize);
+	size_t const result = ZDICT_trainFromBuffer(&dictionary[0], dictionary.size(), &samples[0], &sizes[0], sizes.size());
+	if (ZDICT_isError(result))
+	{
+		dictionary.clear();
+		return chd_file::error::COMPRESSION_ERROR;
+	}
+	dictionary.resize(result);
+	return std::error_condition();
+}
+
+
 
 //**************************************************************************
 //  CODEC INSTANCE
@@ -1149,6 +1228,158 @@ void chd_zstd_decompressor::decompress(const uint8_t *src, uint32_t complen, uin
 
 
 
+//**************************************************************************
+//  ZSTANDARD DICTIONARY COMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_dict_compressor - constructor
+//-------------------------------------------------
+
+chd_zstd_dict_compressor::chd_zstd_dict_compressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_compressor(chd, hunkbytes, lossy)
+	, m_context(nullptr)
+	, m_dictionary(nullptr)
+{
+	// initialize the context
+	m_context = ZSTD_createCCtx();
+	if (!m_context)
+		throw std::bad_alloc();
+	ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, ZSTD_maxCLevel());
+
+	// load the dictionary if one has been trained; otherwise behave like plain Zstandard
+	std::vector<uint8_t> dictionary;
+	if (!chd.read_metadata(ZSTD_DICT_METADATA_TAG, 0, dictionary) && !dictionary.empty())
+	{
+		m_dictionary = ZSTD_createCDict(&dictionary[0], dictionary.size(), ZSTD_maxCLevel());
+		if (!m_dictionary)
+		{
+			ZSTD_freeCCtx(m_context);
+			throw std::bad_alloc();
+		}
+		ZSTD_CCtx_refCDict(m_context, m_dictionary);
+	}
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_dict_compressor - destructor
+//-------------------------------------------------
+
+chd_zstd_dict_compressor::~chd_zstd_dict_compressor()
+{
+	ZSTD_freeCCtx(m_context);
+	ZSTD_freeCDict(m_dictionary);
+}
+
+
+//-------------------------------------------------
+//  compress - compress data using the Zstandard
+//  codec and the image's dictionary
+//-------------------------------------------------
+
+uint32_t chd_zstd_dict_compressor::compress(const uint8_t *src, uint32_t srclen, uint8_t *dest)
+{
+	// reset the session; the level and dictionary stay attached
+	auto result = ZSTD_CCtx_reset(m_context, ZSTD_reset_session_only);
+	if (ZSTD_isError(result))
+		throw std::error_condition(chd_file::error::COMPRESSION_ERROR);
+
+	// do it
+	ZSTD_inBuffer input{ src, srclen, 0 };
+	ZSTD_outBuffer output = { dest, srclen, 0 };
+	while (output.pos < output.size)
+	{
+		result = ZSTD_compressStream2(m_context, &output, &input, ZSTD_e_end);
+		if (ZSTD_isError(result))
+			throw std::error_condition(chd_file::error::COMPRESSION_ERROR);
+		else if (!result)
+			break;
+	}
+
+	// if we ended up with more data than we started with, return an error
+	if (output.pos == output.size)
+		throw std::error_condition(chd_file::error::COMPRESSION_ERROR);
+
+	// otherwise, return the length
+	return output.pos;
+}
+
+
+
+//**************************************************************************
+//  ZSTANDARD DICTIONARY DECOMPRESSOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  chd_zstd_dict_decompressor - constructor
+//-------------------------------------------------
+
+chd_zstd_dict_decompressor::chd_zstd_dict_decompressor(chd_file &chd, uint32_t hunkbytes, bool lossy)
+	: chd_decompressor(chd, hunkbytes, lossy)
+	, m_context(nullptr)
+	, m_dictionary(nullptr)
+{
+	// initialize the context
+	m_context = ZSTD_createDCtx();
+	if (!m_context)
+		throw std::bad_alloc();
+
+	// load the dictionary; hunks compressed without one still decode
+	std::vector<uint8_t> dictionary;
+	if (!chd.read_metadata(ZSTD_DICT_METADATA_TAG, 0, dictionary) && !dictionary.empty())
+	{
+		m_dictionary = ZSTD_createDDict(&dictionary[0], dictionary.size());
+		if (!m_dictionary)
+		{
+			ZSTD_freeDCtx(m_context);
+			throw std::bad_alloc();
+		}
+		ZSTD_DCtx_refDDict(m_context, m_dictionary);
+	}
+}
+
+
+//-------------------------------------------------
+//  ~chd_zstd_dict_decompressor - destructor
+//-------------------------------------------------
+
+chd_zstd_dict_decompressor::~chd_zstd_dict_decompressor()
+{
+	ZSTD_freeDCtx(m_context);
+	ZSTD_freeDDict(m_dictionary);
+}
+
+
+//-------------------------------------------------
+//  decompress - decompress data using the
+//  Zstandard codec and the image's dictionary
+//-------------------------------------------------
+
+void chd_zstd_dict_decompressor::decompress(const uint8_t *src, uint32_t complen, uint8_t *dest, uint32_t destlen)
+{
+	// reset the session; the dictionary stays attached
+	auto result = ZSTD_DCtx_reset(m_context, ZSTD_reset_session_only);
+	if (ZSTD_isError(result))
+		throw std::error_condition(chd_file::error::DECOMPRESSION_ERROR);
+
+	// do it
+	ZSTD_inBuffer input{ src, complen, 0 };
+	ZSTD_outBuffer output = { dest, destlen, 0 };
+	while ((input.pos < input.size) && (output.pos < output.size))
+	{
+		result = ZSTD_decompressStream(m_context, &output, &input);
+		if (ZSTD_isError(result))
+			throw std::error_condition(chd_file::error::DECOMPRESSION_ERROR);
+	}
+
+	// ensure the expected amount of output was generated
+	if (output.pos != output.size)
+		throw std::error_condition(chd_file::error::DECOMPRESSION_ERROR);
+}
+
+
+
 //**************************************************************************
 //  LZMA ALLOCATOR HELPER
 //**************************************************************************
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <system_error>
 #include <vector>
 
 
@@ -106,6 +107,10 @@ public:
 	// utilities
 	static bool codec_exists(chd_codec_type type);
 	static const char *codec_name(chd_codec_type type);
+
+	// build a shared dictionary from sample hunks for codecs that support one
+	static bool codec_uses_dictionary(chd_codec_type type);
+	static std::error_condition train_dictionary(chd_codec_type type, const std::vector<uint8_t> &samples, const std::vector<size_t> &sizes, uint32_t maxsize, std::vector<uint8_t> &dictionary);
 };
 
 
@@ -156,6 +161,7 @@ constexpr chd_codec_type CHD_CODEC_NONE     = 0;
 // general codecs
 constexpr chd_codec_type CHD_CODEC_ZLIB     = CHD_MAKE_TAG('z','l','i','b');
 constexpr chd_codec_type CHD_CODEC_ZSTD     = CHD_MAKE_TAG('z','s','t','d');
+constexpr chd_codec_type CHD_CODEC_ZSTD_DICT = CHD_MAKE_TAG('z','s','d','c');
 constexpr chd_codec_type CHD_CODEC_LZMA     = CHD_MAKE_TAG('l','z','m','a');
 constexpr chd_codec_type CHD_CODEC_HUFFMAN  = CHD_MAKE_TAG('h','u','f','f');
 constexpr chd_codec_type CHD_CODEC_FLAC     = CHD_MAKE_TAG('f','l','a','c');
@@ -66,6 +66,8 @@ public:
 	virtual int vprintf(util::format_argument_pack<char> const &args) override { return m_file.vprintf(args); }
 	virtual std::error_condition truncate(std::uint64_t offset) override { return m_file.truncate(offset); }
 
+	virtual osd_file *osd_handle() noexcept override { return m_file.osd_handle(); }
+
 private:
 	core_file &m_file;
 };
@@ -227,6 +229,8 @@ public:
 
 	virtual std::error_condition truncate(std::uint64_t offset) override;
 
+	virtual osd_file *osd_handle() noexcept override { return m_file.get(); }
+
 protected:
 	bool is_buffered(std::uint64_t offset) const noexcept { return (offset >= m_bufferbase) && (offset < (m_bufferbase + m_bufferbytes)); }
 
@@ -95,6 +95,12 @@ public:
 
 	// file truncation
 	virtual std::error_condition truncate(std::uint64_t offset) = 0;
+
+
+	// ----- host access -----
+
+	// get the OSD file backing this file, or nullptr if there isn't one
+	virtual osd_file *osd_handle() noexcept { return nullptr; }
 };
 
 } // namespace util
@@ -62,7 +62,8 @@ public:
 		PAGED               = 0x00000002,
 		PAGED2LEVEL         = 0x00000006,
 		INTERNAL_DECRYPTION = 0x00000008,
-		SPLIT_DECRYPTION    = 0x00000018
+		SPLIT_DECRYPTION    = 0x00000018,
+		STATE_DEPENDENT     = 0x00000020  // output depends on CPU state as well as the bytes
 	};
 
 	virtual u32 interface_flags() const;
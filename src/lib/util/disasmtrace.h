@@ -0,0 +1,55 @@
+// license:BSD-3-Clause
+// copyright-holders:ehbc-mame contributors
+/***************************************************************************
+
+    disasmtrace.h
+
+    Binary instruction trace file format, written by the debugger's
+    trace command in binary mode and rendered to text by unidasm.
+
+    All multi-byte values are little-endian.  The file starts with:
+
+        char[8]   magic "MAMETRC1"
+        u8        flags (FLAG_*)
+        u8        length of the disassembler name, followed by the name
+                  (the device short name, e.g. "m68030")
+        u16       number of registers, followed for each by a u8 name
+                  length and the name (only with FLAG_REGISTERS)
+
+    It is followed by records, each starting with a u8 type:
+
+        RECORD_INSN   u32 pc, LEB128 cycles elapsed since the previous
+                      instruction, u8 opcode byte count, opcode bytes as
+                      returned by debug_disasm_buffer::data_get; with
+                      FLAG_REGISTERS, u16 count of changed registers and
+                      for each a u16 index and u64 value
+        RECORD_IRQ    u32 pc, s32 irq line
+        RECORD_LOOP   u32 number of instructions skipped by loop detection
+        RECORD_TEXT   u32 length, text (tracelog/logerror output)
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_UTIL_DISASMTRACE_H
+#define MAME_UTIL_DISASMTRACE_H
+
+#include "osdcomm.h"
+
+namespace util::disasm_trace {
+
+constexpr char MAGIC[8] = { 'M', 'A', 'M', 'E', 'T', 'R', 'C', '1' };
+
+constexpr osd::u8 FLAG_REGISTERS = 0x01;
+
+enum : osd::u8
+{
+	RECORD_INSN = 1,
+	RECORD_IRQ,
+	RECORD_LOOP,
+	RECORD_TEXT
+};
+
+} // namespace util::disasm_trace
+
+#endif // MAME_UTIL_DISASMTRACE_H
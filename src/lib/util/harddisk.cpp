@@ -16,6 +16,7 @@
 #include "osdcore.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <tuple>
 
 
@@ -25,6 +26,12 @@
 -------------------------------------------------*/
 
 hard_disk_file::hard_disk_file(chd_file *_chd)
+	: m_readahead(0)
+	, m_nextread(0)
+	, m_prefetched(0)
+	, m_overlay_mode(overlay_mode::NONE)
+	, m_merge_pending(false)
+	, m_merge_queue(nullptr)
 {
 	chd = _chd;
 	fhandle = nullptr;
@@ -48,6 +55,12 @@ hard_disk_file::hard_disk_file(chd_file *_chd)
 }
 
 hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipoffs)
+	: m_readahead(0)
+	, m_nextread(0)
+	, m_prefetched(0)
+	, m_overlay_mode(overlay_mode::NONE)
+	, m_merge_pending(false)
+	, m_merge_queue(nullptr)
 {
 	// bail if getting the file length fails
 	std::uint64_t length;
@@ -81,12 +94,35 @@ hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipo
 }
 
 
+/*-------------------------------------------------
+    constructor - open a hard disk handle for a
+    raw file that has been mapped into memory
+-------------------------------------------------*/
+
+hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipoffs, osd_file_mapping::ptr &&mapping)
+	: hard_disk_file(corefile, skipoffs)
+{
+	m_mapping = std::move(mapping);
+}
+
+
 /*-------------------------------------------------
     destructor - close a hard disk handle
 -------------------------------------------------*/
 
 hard_disk_file::~hard_disk_file()
 {
+	// make sure everything written through the overlay reaches the CHD
+	if (m_merge_queue)
+	{
+		flush_overlay();
+		osd_work_queue_free(m_merge_queue);
+	}
+
+	// push dirty pages back to the file before the mapping goes away
+	if (m_mapping && m_mapping->writeable())
+		m_mapping->flush();
+
 	if (fhandle)
 		fhandle->flush();
 }
@@ -109,11 +145,31 @@ hard_disk_file::~hard_disk_file()
 
 bool hard_disk_file::read(uint32_t lbasector, void *buffer)
 {
-	if (chd)
+	if (m_overlay_mode != overlay_mode::NONE)
+	{
+		return overlay_read(lbasector, buffer);
+	}
+	else if (chd)
 	{
 		std::error_condition err = chd->read_units(lbasector, buffer);
 		return !err;
 	}
+	else if (m_mapping)
+	{
+		uint64_t const offset = fileoffset + (uint64_t(lbasector) * hdinfo.sectorbytes);
+		if ((offset + hdinfo.sectorbytes) > m_mapping->size())
+			return false;
+		std::memcpy(buffer, reinterpret_cast<const uint8_t *>(m_mapping->data()) + offset, hdinfo.sectorbytes);
+
+		// keep a window ahead of sequential reads in flight, topping it up once it's half consumed
+		if (m_readahead && (lbasector == m_nextread) && ((offset + hdinfo.sectorbytes + (m_readahead / 2)) > m_prefetched))
+		{
+			m_mapping->prefetch(offset + hdinfo.sectorbytes, m_readahead);
+			m_prefetched = offset + hdinfo.sectorbytes + m_readahead;
+		}
+		m_nextread = lbasector + 1;
+		return true;
+	}
 	else
 	{
 		size_t actual = 0;
@@ -142,11 +198,23 @@ bool hard_disk_file::read(uint32_t lbasector, void *buffer)
 
 bool hard_disk_file::write(uint32_t lbasector, const void *buffer)
 {
-	if (chd)
+	if (m_overlay_mode != overlay_mode::NONE)
+	{
+		return overlay_write(lbasector, buffer);
+	}
+	else if (chd)
 	{
 		std::error_condition err = chd->write_units(lbasector, buffer);
 		return !err;
 	}
+	else if (m_mapping)
+	{
+		uint64_t const offset = fileoffset + (uint64_t(lbasector) * hdinfo.sectorbytes);
+		if (!m_mapping->writeable() || ((offset + hdinfo.sectorbytes) > m_mapping->size()))
+			return false;
+		std::memcpy(reinterpret_cast<uint8_t *>(m_mapping->data()) + offset, buffer, hdinfo.sectorbytes);
+		return true;
+	}
 	else
 	{
 		size_t actual = 0;
@@ -196,6 +264,207 @@ bool hard_disk_file::set_block_size(uint32_t blocksize)
 }
 
 
+/*-------------------------------------------------
+    set_overlay_mode - select how writes to a
+    CHD-backed hard disk are handled
+-------------------------------------------------*/
+
+/**
+ * @fn  bool set_overlay_mode(overlay_mode mode)
+ *
+ * @brief   Hard disk copy-on-write overlay selection (works only for CHD files)
+ *
+ * @param   mode            NONE to write straight to the CHD, MEMORY to keep all writes in
+ *                          memory, or WRITEBACK to keep writes in memory and merge them into
+ *                          the CHD on a background thread.
+ *
+ * @return  true on success, false if the disk is not backed by a CHD.  Switching modes
+ *          flushes any pending merges first; leaving MEMORY mode discards the overlay.
+ */
+
+bool hard_disk_file::set_overlay_mode(overlay_mode mode)
+{
+	if (!chd)
+		return false;
+
+	if (mode == m_overlay_mode)
+		return true;
+
+	// settle the current overlay before switching
+	if (m_overlay_mode == overlay_mode::WRITEBACK)
+		flush_overlay();
+	discard_overlay();
+
+	if ((mode == overlay_mode::WRITEBACK) && !m_merge_queue)
+		m_merge_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+	m_overlay_mode = mode;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    discard_overlay - throw away every hunk held
+    in the overlay, reverting reads to the CHD
+-------------------------------------------------*/
+
+void hard_disk_file::discard_overlay()
+{
+	// let an in-flight merge finish so we don't pull the data out from under it
+	if (m_merge_queue)
+		while (!osd_work_queue_wait(m_merge_queue, osd_ticks_per_second())) { }
+
+	std::lock_guard<std::mutex> lock(m_overlay_mutex);
+	m_overlay.clear();
+	m_dirty_hunks.clear();
+}
+
+
+/*-------------------------------------------------
+    flush_overlay - wait for all dirty hunks to be
+    merged into the CHD (WRITEBACK mode only)
+-------------------------------------------------*/
+
+void hard_disk_file::flush_overlay()
+{
+	if (m_overlay_mode != overlay_mode::WRITEBACK)
+		return;
+
+	// the local merge below mustn't overlap one on the queue
+	while (!osd_work_queue_wait(m_merge_queue, osd_ticks_per_second())) { }
+
+	// anything left over was queued after the merge finished; do it here
+	overlay_merge();
+}
+
+
+/*-------------------------------------------------
+    overlay_read - read a sector, preferring the
+    copy held in the overlay
+-------------------------------------------------*/
+
+bool hard_disk_file::overlay_read(uint32_t lbasector, void *buffer)
+{
+	uint32_t const unitbytes = chd->unit_bytes();
+	uint32_t const unitsperhunk = chd->hunk_bytes() / unitbytes;
+	uint32_t const hunknum = lbasector / unitsperhunk;
+
+	{
+		std::lock_guard<std::mutex> lock(m_overlay_mutex);
+		auto const found = m_overlay.find(hunknum);
+		if (found != m_overlay.end())
+		{
+			std::memcpy(buffer, &found->second.data[(lbasector % unitsperhunk) * unitbytes], unitbytes);
+			return true;
+		}
+	}
+
+	// not in the overlay; merged hunks are only evicted once they're in the CHD
+	std::lock_guard<std::mutex> lock(m_chd_mutex);
+	std::error_condition err = chd->read_units(lbasector, buffer);
+	return !err;
+}
+
+
+/*-------------------------------------------------
+    overlay_write - write a sector into the
+    overlay, pulling the hunk in on first touch
+-------------------------------------------------*/
+
+bool hard_disk_file::overlay_write(uint32_t lbasector, const void *buffer)
+{
+	uint32_t const hunkbytes = chd->hunk_bytes();
+	uint32_t const unitbytes = chd->unit_bytes();
+	uint32_t const unitsperhunk = hunkbytes / unitbytes;
+	uint32_t const hunknum = lbasector / unitsperhunk;
+
+	std::unique_lock<std::mutex> lock(m_overlay_mutex);
+	auto found = m_overlay.find(hunknum);
+	if (found == m_overlay.end())
+	{
+		// only this thread adds hunks, so it's safe to fill the new one without holding the lock
+		lock.unlock();
+		overlay_hunk hunk{ std::make_unique<uint8_t []>(hunkbytes), false };
+		{
+			std::lock_guard<std::mutex> chdlock(m_chd_mutex);
+			std::error_condition err = chd->read_hunk(hunknum, hunk.data.get());
+			if (err)
+				return false;
+		}
+		lock.lock();
+		found = m_overlay.emplace(hunknum, std::move(hunk)).first;
+	}
+
+	std::memcpy(&found->second.data[(lbasector % unitsperhunk) * unitbytes], buffer, unitbytes);
+
+	if (m_overlay_mode == overlay_mode::WRITEBACK)
+	{
+		if (!found->second.dirty)
+		{
+			found->second.dirty = true;
+			m_dirty_hunks.push_back(hunknum);
+		}
+		if (!m_merge_pending)
+		{
+			m_merge_pending = true;
+			osd_work_item_queue(m_merge_queue, overlay_merge_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+		}
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    overlay_merge - write dirty hunks back to the
+    CHD, evicting each one once it has landed
+-------------------------------------------------*/
+
+void *hard_disk_file::overlay_merge_static(void *param, int threadid)
+{
+	reinterpret_cast<hard_disk_file *>(param)->overlay_merge();
+	return nullptr;
+}
+
+void hard_disk_file::overlay_merge()
+{
+	uint32_t const hunkbytes = chd->hunk_bytes();
+	std::unique_ptr<uint8_t []> buffer = std::make_unique<uint8_t []>(hunkbytes);
+
+	std::unique_lock<std::mutex> lock(m_overlay_mutex);
+	while (!m_dirty_hunks.empty())
+	{
+		// snapshot the hunk so the emulation thread can keep writing to it
+		uint32_t const hunknum = m_dirty_hunks.front();
+		m_dirty_hunks.pop_front();
+		auto found = m_overlay.find(hunknum);
+		if (found == m_overlay.end())
+			continue;
+		std::memcpy(buffer.get(), found->second.data.get(), hunkbytes);
+		found->second.dirty = false;
+		lock.unlock();
+
+		std::error_condition err;
+		{
+			std::lock_guard<std::mutex> chdlock(m_chd_mutex);
+			err = chd->write_bytes(uint64_t(hunknum) * hunkbytes, buffer.get(), hunkbytes);
+		}
+
+		lock.lock();
+		found = m_overlay.find(hunknum);
+		if (err)
+		{
+			// keep the data in memory so reads stay correct
+			osd_printf_error("harddisk: failed to merge hunk %u into CHD (%s)\n", hunknum, err.message());
+		}
+		else if ((found != m_overlay.end()) && !found->second.dirty)
+		{
+			m_overlay.erase(found);
+		}
+	}
+	m_merge_pending = false;
+}
+
+
 std::error_condition hard_disk_file::get_inquiry_data(std::vector<uint8_t> &data) const
 {
 	if(chd)
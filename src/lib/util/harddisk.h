@@ -15,8 +15,15 @@
 
 #include "utilfwd.h"
 
+#include "osdcore.h"
+#include "osdfile.h"
+
 #include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <system_error>
+#include <unordered_map>
 #include <vector>
 
 
@@ -32,27 +39,69 @@ public:
 		uint32_t          sectorbytes;
 	};
 
+	// copy-on-write overlay modes
+	enum class overlay_mode
+	{
+		NONE,           // writes go straight to the CHD
+		MEMORY,         // writes are held in memory and never reach the CHD
+		WRITEBACK       // writes are held in memory and merged into the CHD in the background
+	};
+
 	hard_disk_file(chd_file *chd);
 	hard_disk_file(util::random_read_write &corefile, uint32_t skipoffs);
+	hard_disk_file(util::random_read_write &corefile, uint32_t skipoffs, osd_file_mapping::ptr &&mapping);
 
 	~hard_disk_file();
 
 	const info &get_info() const { return hdinfo; }
 
 	bool set_block_size(uint32_t blocksize);
+	void set_read_ahead(uint32_t bytes) { m_readahead = bytes; }
 
 	bool read(uint32_t lbasector, void *buffer);
 	bool write(uint32_t lbasector, const void *buffer);
 
+	bool set_overlay_mode(overlay_mode mode);
+	overlay_mode get_overlay_mode() const { return m_overlay_mode; }
+	void discard_overlay();
+	void flush_overlay();
+
 	std::error_condition get_inquiry_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_cis_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_disk_key_data(std::vector<uint8_t> &data) const;
 
 private:
+	// a single hunk held in the overlay
+	struct overlay_hunk
+	{
+		std::unique_ptr<uint8_t []> data;       // hunk contents
+		bool                        dirty;      // not yet merged into the CHD?
+	};
+
+	bool overlay_read(uint32_t lbasector, void *buffer);
+	bool overlay_write(uint32_t lbasector, const void *buffer);
+	static void *overlay_merge_static(void *param, int threadid);
+	void overlay_merge();
+
 	chd_file *                  chd;        // CHD file
 	util::random_read_write *   fhandle;    // file if not a CHD
 	info                        hdinfo;     // hard disk info
 	uint32_t                    fileoffset; // offset in the file where the HDD image starts.  not valid for CHDs.
+
+	// memory-mapped raw image
+	osd_file_mapping::ptr       m_mapping;      // mapping of the raw file, if any
+	uint32_t                    m_readahead;    // bytes to prefetch on sequential reads, or zero
+	uint32_t                    m_nextread;     // sector that would continue a sequential read
+	uint64_t                    m_prefetched;   // end of the last prefetched range
+
+	// copy-on-write overlay
+	overlay_mode                m_overlay_mode;     // current overlay mode
+	std::unordered_map<uint32_t, overlay_hunk> m_overlay; // hunks written since the overlay was enabled
+	std::deque<uint32_t>        m_dirty_hunks;      // hunks waiting to be merged, in write order
+	bool                        m_merge_pending;    // background merge queued or running?
+	std::mutex                  m_overlay_mutex;    // protects the overlay state
+	std::mutex                  m_chd_mutex;        // serialises access to the CHD
+	osd_work_queue *            m_merge_queue;      // queue for background merges
 };
 
 #endif // MAME_LIB_UTIL_HARDDISK_H
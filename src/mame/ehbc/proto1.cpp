@@ -9,7 +9,8 @@
 	- FPM/EDO DRAM up to 64 MiB
 
     TODO:
-	
+	- Find out which DMAC channel serves the AD1848; only programmed
+	  I/O playback reaches it for now
 
 ****************************************************************************/
 
@@ -442,9 +443,11 @@ void proto1_state::proto1(machine_config &config)
 		.set_extra_options("1M,2M,4M,8M,16M,32M,64M");
 
 	MC68901(config, m_mfp[0], 4_MHz_XTAL);
+	m_mfp[0]->set_timer_clock(4_MHz_XTAL);
 	m_mfp[0]->out_irq_cb().set(FUNC(proto1_state::irq_mfp0_handler));
 
 	MC68901(config, m_mfp[1], 4_MHz_XTAL);
+	m_mfp[1]->set_timer_clock(4_MHz_XTAL);
 	m_mfp[1]->out_irq_cb().set(FUNC(proto1_state::irq_mfp1_handler));
 
 	HD63450(config, m_dmac[0], 10_MHz_XTAL, "maincpu");
@@ -485,10 +488,12 @@ void proto1_state::proto1(machine_config &config)
 	RS232_PORT(config, m_serial[0], default_rs232_devices, "terminal");
 	m_serial[0]->rxd_handler().set(m_duart, FUNC(mc68681_device::rx_a_w));
 	m_serial[0]->cts_handler().set(m_duart, FUNC(mc68681_device::ip0_w));
+	m_serial[0]->set_dte_serial("duart:cha");
 
 	RS232_PORT(config, m_serial[1], default_rs232_devices, nullptr);
 	m_serial[1]->rxd_handler().set(m_duart, FUNC(mc68681_device::rx_b_w));
 	m_serial[1]->cts_handler().set(m_duart, FUNC(mc68681_device::ip1_w));
+	m_serial[1]->set_dte_serial("duart:chb");
 
 	PC8477B(config, m_fdc, 24_MHz_XTAL, pc8477b_device::mode_t::PS2);
 	m_fdc->intrq_wr_callback().set(FUNC(proto1_state::irq6_handler));
@@ -547,4 +552,4 @@ ROM_END
 //**************************************************************************
 
 //   YEAR  NAME    PARENT  COMPAT  MACHINE INPUT   CLASS         INIT        COMPANY    FULLNAME       FLAGS
-COMP(2024, proto1, 0,      0,      proto1, proto1, proto1_state, empty_init, "kms1212", "EHBC Proto1", MACHINE_IMPERFECT_GRAPHICS | MACHINE_NO_SOUND | MACHINE_SUPPORTS_SAVE)
+COMP(2024, proto1, 0,      0,      proto1, proto1, proto1_state, empty_init, "kms1212", "EHBC Proto1", MACHINE_IMPERFECT_GRAPHICS | MACHINE_IMPERFECT_SOUND | MACHINE_SUPPORTS_SAVE)
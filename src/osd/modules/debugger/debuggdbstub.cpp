@@ -12,6 +12,7 @@
 #include "debug/debugcon.h"
 #include "debug/debugcpu.h"
 #include "debug/points.h"
+#include "debug/reverse.h"
 #include "debug/textbuf.h"
 #include "debugger.h"
 
@@ -19,7 +20,10 @@
 #include "modules/osdmodule.h"
 
 #include "fileio.h"
+#include "osdfile.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <string_view>
 
@@ -29,7 +33,7 @@ namespace osd {
 namespace {
 
 //-------------------------------------------------------------------------
-#define MAX_PACKET_SIZE 16384
+#define MAX_PACKET_SIZE 65536
 
 //-------------------------------------------------------------------------
 enum gdb_register_type
@@ -540,7 +544,9 @@ public:
 		m_is_be(false),
 		m_initialized(false),
 		m_dettached(false),
+		m_connected(false),
 		m_extended_mode(false),
+		m_no_ack(false),
 		m_send_stop_packet(false),
 		m_target_xml_sent(false),
 		m_triggered_breakpoint(nullptr),
@@ -572,6 +578,9 @@ public:
 	bool is_thread_id_ok(const char *buf);
 
 	void handle_character(char ch);
+	std::error_condition open_socket();
+	void reopen_socket();
+	void wait_for_input();
 	void send_nack();
 	void send_ack();
 	void handle_packet();
@@ -586,6 +595,7 @@ public:
 
 	cmd_reply handle_exclamation(const char *buf);
 	cmd_reply handle_question(const char *buf);
+	cmd_reply handle_b(const char *buf);
 	cmd_reply handle_c(const char *buf);
 	cmd_reply handle_D(const char *buf);
 	cmd_reply handle_g(const char *buf);
@@ -599,8 +609,11 @@ public:
 	cmd_reply handle_p(const char *buf);
 	cmd_reply handle_P(const char *buf);
 	cmd_reply handle_q(const char *buf);
+	cmd_reply handle_Q(const char *buf);
 	cmd_reply handle_s(const char *buf);
 	cmd_reply handle_T(const char *buf);
+	cmd_reply handle_v(const char *buf);
+	cmd_reply handle_X(const char *buf);
 	cmd_reply handle_z(const char *buf);
 	cmd_reply handle_Z(const char *buf);
 
@@ -615,6 +628,7 @@ public:
 	readbuf_state m_readbuf_state;
 
 	void generate_target_xml();
+	void generate_memory_map_xml();
 
 	int readchar();
 
@@ -632,10 +646,13 @@ private:
 	std::string m_debugger_host;
 	int m_debugger_port;
 	emu_file m_socket;
+	osd_file_poller::ptr m_poller;
 	bool m_is_be;
 	bool m_initialized;
 	bool m_dettached;
+	bool m_connected;           // a client has been accepted on the socket
 	bool m_extended_mode;
+	bool m_no_ack;              // QStartNoAckMode: neither side sends '+'/'-' anymore
 	bool m_send_stop_packet;
 	bool m_target_xml_sent;     // the 'g', 'G', 'p', and 'P' commands only work once target.xml has been sent
 
@@ -658,8 +675,9 @@ private:
 	debug_watchpoint *m_triggered_watchpoint;
 
 	std::string m_target_xml;
+	std::string m_memory_map_xml;
 
-	uint8_t  m_readbuf[512];
+	uint8_t  m_readbuf[MAX_PACKET_SIZE];
 	uint32_t m_readbuf_len;
 	uint32_t m_readbuf_offset;
 
@@ -699,15 +717,72 @@ int debug_gdbstub::readchar()
 
 	if ( m_readbuf_offset == m_readbuf_len )
 	{
+		// Read from the OSD file so that the end of the connection can be
+		// told apart from no data being available yet.
+		osd_file *file = static_cast<util::core_file &>(m_socket).osd_handle();
+		uint32_t actual = 0;
+		std::error_condition const err = file != nullptr ? file->read(m_readbuf, 0, sizeof(m_readbuf), actual) : std::errc::bad_file_descriptor;
 		m_readbuf_offset = 0;
-		m_readbuf_len = m_socket.read(m_readbuf, sizeof(m_readbuf));
-		if ( m_readbuf_len == 0 )
+		m_readbuf_len = actual;
+		if ( actual == 0 )
+		{
+			// The first empty read without an error accepts a client;
+			// after that it means the client has gone away.
+			if ( !err && !m_connected )
+				m_connected = true;
+			else if ( err != std::errc::operation_would_block && m_connected )
+				reopen_socket();
 			return -1;
+		}
 	}
 
 	return (int) m_readbuf[m_readbuf_offset++];
 }
 
+//-------------------------------------------------------------------------
+std::error_condition debug_gdbstub::open_socket()
+{
+	std::string socket_name = string_format("socket.%s:%d", m_debugger_host, m_debugger_port);
+	return m_socket.open(socket_name);
+}
+
+//-------------------------------------------------------------------------
+void debug_gdbstub::reopen_socket()
+{
+	// Forget everything negotiated with the old client and wait for a new
+	// one. If the port can't be listened on again, wait_for_input falls
+	// back to sleeping.
+	m_socket.close();
+	m_connected = false;
+	m_extended_mode = false;
+	m_no_ack = false;
+	m_target_xml_sent = false;
+	m_readbuf_state = PACKET_START;
+	m_readbuf_len = 0;
+	m_readbuf_offset = 0;
+	if ( open_socket() )
+		osd_printf_error("gdbstub: client disconnected; failed to listen again on address %s port %d\n", m_debugger_host, m_debugger_port);
+	else
+		osd_printf_info("gdbstub: client disconnected; listening on address %s port %d\n", m_debugger_host, m_debugger_port);
+}
+
+//-------------------------------------------------------------------------
+void debug_gdbstub::wait_for_input()
+{
+	// Sleep until the socket becomes readable (or a client connects to
+	// the listening socket) instead of spinning on it. The timeout is
+	// only a safety net; hosts without readiness notification fall back
+	// to sleeping for 1 millisecond between polls.
+	osd_file *file = m_socket.is_open() ? static_cast<util::core_file &>(m_socket).osd_handle() : nullptr;
+	if ( m_poller && file != nullptr && !m_poller->arm(*file, file) )
+	{
+		std::vector<void *> ready;
+		m_poller->wait(std::chrono::milliseconds(100), ready);
+		return;
+	}
+	osd_sleep(osd_ticks_per_second() / 1000);
+}
+
 //-------------------------------------------------------------------------
 static std::string escape_packet(std::string_view src)
 {
@@ -743,6 +818,54 @@ void debug_gdbstub::generate_target_xml()
 	m_target_xml = escape_packet(target_xml);
 }
 
+//-------------------------------------------------------------------------
+void debug_gdbstub::generate_memory_map_xml()
+{
+	// Describe the program space as seen with address translation off.
+	// Regions mapped as ROM are reported as such so GDB uses hardware
+	// breakpoints there and refuses to load into them; everything else,
+	// including I/O and unmapped holes, is reported as RAM so that GDB
+	// never refuses an access the target would accept.
+	std::vector<std::pair<uint64_t, uint64_t> > roms;
+	const address_map *map = m_address_space->map();
+	if ( map != nullptr )
+	{
+		for ( const address_map_entry &entry : map->m_entrylist )
+		{
+			if ( entry.m_read.m_type != AMH_ROM || entry.m_write.m_type == AMH_RAM || entry.m_addrmirror != 0 )
+				continue;
+			uint64_t start = m_address_space->address_to_byte(entry.m_addrstart);
+			uint64_t end = m_address_space->address_to_byte_end(entry.m_addrend);
+			roms.emplace_back(start, end);
+		}
+	}
+	std::sort(roms.begin(), roms.end());
+
+	std::string xml;
+	xml += "<?xml version=\"1.0\"?>\n";
+	xml += "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">\n";
+	xml += "<memory-map>\n";
+	auto add_region = [&xml] (const char *type, uint64_t start, uint64_t end)
+	{
+		xml += string_format("  <memory type=\"%s\" start=\"0x%x\" length=\"0x%x\"/>\n", type, start, end - start + 1);
+	};
+	uint64_t next = 0;
+	uint64_t last = m_address_space->address_to_byte_end(m_address_space->addrmask());
+	for ( const auto &rom : roms )
+	{
+		if ( rom.first < next )
+			continue;
+		if ( rom.first > next )
+			add_region("ram", next, rom.first - 1);
+		add_region("rom", rom.first, rom.second);
+		next = rom.second + 1;
+	}
+	if ( next <= last )
+		add_region("ram", next, last);
+	xml += "</memory-map>\n";
+	m_memory_map_xml = escape_packet(xml);
+}
+
 //-------------------------------------------------------------------------
 void debug_gdbstub::wait_for_debugger(device_t &device, bool firststop)
 {
@@ -820,11 +943,12 @@ void debug_gdbstub::wait_for_debugger(device_t &device, bool firststop)
 			osd_printf_info(" %3d (%d) %d %d [%s]\n", reg.gdb_regnum, reg.state_index, reg.gdb_bitsize, reg.gdb_type, reg.gdb_name);
 #endif
 
-		std::string socket_name = string_format("socket.%s:%d", m_debugger_host, m_debugger_port);
-		std::error_condition const filerr = m_socket.open(socket_name);
+		std::error_condition const filerr = open_socket();
 		if ( filerr )
 			fatalerror("gdbstub: failed to start listening on address %s port %d\n", m_debugger_host, m_debugger_port);
 		osd_printf_info("gdbstub: listening on address %s port %d\n", m_debugger_host, m_debugger_port);
+		if ( osd_file_poller::create(m_poller) )
+			m_poller.reset();
 
 		m_initialized = true;
 	}
@@ -845,10 +969,7 @@ void debug_gdbstub::wait_for_debugger(device_t &device, bool firststop)
 		int ch = readchar();
 		if ( ch < 0 )
 		{
-			// TODO add support for timeout in *_osd_socket.
-			// To prevent 100% cpu usage while waiting for data to
-			// arrive from the socket, we sleep for 1 millisecond.
-			osd_sleep(osd_ticks_per_second() / 1000);
+			wait_for_input();
 			continue;
 		}
 		handle_character((char) ch);
@@ -870,13 +991,15 @@ void debug_gdbstub::debugger_update()
 //-------------------------------------------------------------------------
 void debug_gdbstub::send_nack()
 {
-	m_socket.write("-", 1);
+	if ( !m_no_ack )
+		m_socket.write("-", 1);
 }
 
 //-------------------------------------------------------------------------
 void debug_gdbstub::send_ack()
 {
-	m_socket.write("+", 1);
+	if ( !m_no_ack )
+		m_socket.write("+", 1);
 }
 
 //-------------------------------------------------------------------------
@@ -886,8 +1009,17 @@ void debug_gdbstub::send_reply(std::string_view str)
 	for ( char ch : str )
 		checksum += ch;
 
-	std::string reply = string_format("$%s#%02x", str, checksum);
-	m_socket.write(reply.c_str(), reply.length());
+	// Send the framing and the payload together without copying the
+	// payload, so the client gets the packet in one piece.
+	char const start = '$';
+	char const end[4] = { '#', "0123456789abcdef"[checksum >> 4], "0123456789abcdef"[checksum & 0x0f], '\0' };
+	osd_file *file = m_socket.is_open() ? static_cast<util::core_file &>(m_socket).osd_handle() : nullptr;
+	if ( file != nullptr )
+	{
+		osd_file::write_buffer const buffers[] = { { &start, 1 }, { str.data(), uint32_t(str.length()) }, { end, 3 } };
+		uint32_t actual;
+		file->write_gather(buffers, std::size(buffers), 0, actual);
+	}
 }
 
 
@@ -907,6 +1039,25 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_question(const char *buf)
 	return REPLY_NONE;
 }
 
+//-------------------------------------------------------------------------
+// Backward continue (bc) or backward single step (bs).
+debug_gdbstub::cmd_reply debug_gdbstub::handle_b(const char *buf)
+{
+	device_t *cpu = m_debugger_console->get_visible_cpu();
+	bool success;
+	if ( strcmp(buf, "c") == 0 )
+		success = m_debugger_cpu->reverse().continue_back(*cpu);
+	else if ( strcmp(buf, "s") == 0 )
+		success = m_debugger_cpu->reverse().step_back(*cpu);
+	else
+		return REPLY_UNSUPPORTED;
+
+	if ( !success )
+		return REPLY_ENN;
+	m_send_stop_packet = true;
+	return REPLY_NONE;
+}
+
 //-------------------------------------------------------------------------
 // Continue at addr.
 debug_gdbstub::cmd_reply debug_gdbstub::handle_c(const char *buf)
@@ -1004,21 +1155,37 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_m(const char *buf)
 	if ( !m_memory->translate(m_address_space->spacenum(), device_memory_interface::TR_READ, offset, tspace) )
 		return REPLY_ENN;
 
+	// The reply has to fit in the packet size we advertised.
+	length = std::min<uint64_t>(length, MAX_PACKET_SIZE / 2);
+
 	// Disable side effects while reading memory.
 	auto dis = m_machine->disable_side_effects();
 
-	std::string reply;
-	reply.reserve(length * 2);
+	static const char hexdigits[] = "0123456789abcdef";
+	std::string reply(length * 2, '0');
 	for ( int i = 0; i < length; i++ )
 	{
 		uint8_t value = tspace->read_byte(offset + i);
-		reply += string_format("%02x", value);
+		reply[i * 2 + 0] = hexdigits[value >> 4];
+		reply[i * 2 + 1] = hexdigits[value & 0x0f];
 	}
 	send_reply(reply);
 
 	return REPLY_NONE;
 }
 
+//-------------------------------------------------------------------------
+static int hex_nibble(char ch)
+{
+	if ( ch >= '0' && ch <= '9' )
+		return ch - '0';
+	if ( ch >= 'a' && ch <= 'f' )
+		return ch - 'a' + 10;
+	if ( ch >= 'A' && ch <= 'F' )
+		return ch - 'A' + 10;
+	return -1;
+}
+
 //-------------------------------------------------------------------------
 static bool hex_decode(std::vector<uint8_t> *_data, const char *buf, size_t length)
 {
@@ -1026,8 +1193,11 @@ static bool hex_decode(std::vector<uint8_t> *_data, const char *buf, size_t leng
 	data.resize(length);
 	for ( int i = 0; i < length; i++ )
 	{
-		if ( sscanf(buf, "%02hhx", &data[i]) != 1 )
+		int hi = hex_nibble(buf[0]);
+		int lo = (hi < 0) ? -1 : hex_nibble(buf[1]);
+		if ( lo < 0 )
 			return false;
+		data[i] = (hi << 4) | lo;
 		buf += 2;
 	}
 	if ( *buf != '\0' )
@@ -1056,6 +1226,54 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_M(const char *buf)
 
 	for ( int i = 0; i < length; i++ )
 		tspace->write_byte(offset + i, data[i]);
+	m_debugger_cpu->reverse().machine_changed();
+
+	return REPLY_OK;
+}
+
+//-------------------------------------------------------------------------
+// Write memory (binary data).
+debug_gdbstub::cmd_reply debug_gdbstub::handle_X(const char *buf)
+{
+	uint64_t address;
+	uint64_t length;
+	int buf_offset = -1;
+	if ( sscanf(buf, "%" PRIx64 ",%" PRIx64 ":%n", &address, &length, &buf_offset) != 2 || buf_offset < 0 )
+		return REPLY_ENN;
+
+	// The data may contain NUL bytes, so it is delimited by the packet
+	// length rather than by the terminator. '}' escapes the next byte,
+	// which is xored with 0x20.
+	const char *src = buf + buf_offset;
+	const char *end = (const char *) m_packet_buf + m_packet_len;
+	std::vector<uint8_t> data;
+	data.reserve(end - src);
+	while ( src < end )
+	{
+		uint8_t ch = *src++;
+		if ( ch == '}' )
+		{
+			if ( src == end )
+				return REPLY_ENN;
+			ch = *src++ ^ 0x20;
+		}
+		data.push_back(ch);
+	}
+	if ( data.size() != length )
+		return REPLY_ENN;
+
+	// GDB probes for X support with a zero-length write.
+	if ( length == 0 )
+		return REPLY_OK;
+
+	offs_t offset = address;
+	address_space *tspace;
+	if ( !m_memory->translate(m_address_space->spacenum(), device_memory_interface::TR_WRITE, offset, tspace) )
+		return REPLY_ENN;
+
+	for ( int i = 0; i < length; i++ )
+		tspace->write_byte(offset + i, data[i]);
+	m_debugger_cpu->reverse().machine_changed();
 
 	return REPLY_OK;
 }
@@ -1092,6 +1310,20 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_P(const char *buf)
 	return REPLY_OK;
 }
 
+//-------------------------------------------------------------------------
+static std::string xfer_chunk(const std::string &data, int offset, int length)
+{
+	offset = std::min(offset, (int) data.length());
+	length = std::min(length, (int) data.length() - offset);
+	std::string reply;
+	if ( offset + length < data.length() )
+		reply += 'm';
+	else
+		reply += 'l';
+	reply += data.substr(offset, length);
+	return reply;
+}
+
 //-------------------------------------------------------------------------
 // General query.
 debug_gdbstub::cmd_reply debug_gdbstub::handle_q(const char *buf)
@@ -1154,6 +1386,10 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_q(const char *buf)
 	{
 		std::string reply = string_format("PacketSize=%x", MAX_PACKET_SIZE);
 		reply += ";qXfer:features:read+";
+		reply += ";qXfer:memory-map:read+";
+		reply += ";QStartNoAckMode+";
+		reply += ";vContSupported+";
+		reply += ";ReverseStep+;ReverseContinue+";
 		send_reply(reply);
 		return REPLY_NONE;
 	}
@@ -1168,18 +1404,24 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_q(const char *buf)
 			{
 				if ( m_target_xml.empty() )
 					generate_target_xml();
-				length = std::min(length, (int) m_target_xml.length()-offset);
-				std::string reply;
-				if ( offset + length < m_target_xml.length() )
-					reply += 'm';
-				else
-					reply += 'l';
-				reply += m_target_xml.substr(offset, length);
-				send_reply(reply);
+				send_reply(xfer_chunk(m_target_xml, offset, length));
 				m_target_xml_sent = true;
 				return REPLY_NONE;
 			}
 		}
+		// "memory-map:read::0,3fff"
+		else if ( strncmp(params.c_str(), "memory-map:read::", 17) == 0 )
+		{
+			int offset = 0;
+			int length = 0;
+			if ( sscanf(params.c_str() + 17, "%x,%x", &offset, &length) == 2 )
+			{
+				if ( m_memory_map_xml.empty() )
+					generate_memory_map_xml();
+				send_reply(xfer_chunk(m_memory_map_xml, offset, length));
+				return REPLY_NONE;
+			}
+		}
 	}
 	else if ( name == "fThreadInfo" )
 	{
@@ -1195,6 +1437,21 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_q(const char *buf)
 	return REPLY_UNSUPPORTED;
 }
 
+//-------------------------------------------------------------------------
+// General set.
+debug_gdbstub::cmd_reply debug_gdbstub::handle_Q(const char *buf)
+{
+	if ( strcmp(buf, "StartNoAckMode") == 0 )
+	{
+		// This packet has already been acknowledged, and GDB will
+		// acknowledge our reply; nothing is acknowledged after that.
+		m_no_ack = true;
+		return REPLY_OK;
+	}
+
+	return REPLY_UNSUPPORTED;
+}
+
 //-------------------------------------------------------------------------
 // Single step, resuming at addr.
 debug_gdbstub::cmd_reply debug_gdbstub::handle_s(const char *buf)
@@ -1219,6 +1476,33 @@ debug_gdbstub::cmd_reply debug_gdbstub::handle_T(const char *buf)
 	return REPLY_ENN;
 }
 
+//-------------------------------------------------------------------------
+// Multi-letter packets.
+debug_gdbstub::cmd_reply debug_gdbstub::handle_v(const char *buf)
+{
+	if ( strcmp(buf, "Cont?") == 0 )
+	{
+		send_reply("vCont;c;C;s;S");
+		return REPLY_NONE;
+	}
+	if ( strncmp(buf, "Cont;", 5) == 0 )
+	{
+		// There is only one thread, so the first action applies to it
+		// and any others can be ignored. Signals are ignored as well.
+		switch ( buf[5] )
+		{
+			case 'c':
+			case 'C':
+				return handle_c("");
+			case 's':
+			case 'S':
+				return handle_s("");
+		}
+	}
+
+	return REPLY_UNSUPPORTED;
+}
+
 //-------------------------------------------------------------------------
 static bool remove_breakpoint(device_debug *debug, uint64_t address, int /*kind*/)
 {
@@ -1379,6 +1663,7 @@ void debug_gdbstub::handle_packet()
 	{
 		case '!': reply = handle_exclamation(buf); break;
 		case '?': reply = handle_question(buf); break;
+		case 'b': reply = handle_b(buf); break;
 		case 'c': reply = handle_c(buf); break;
 		case 'D': reply = handle_D(buf); break;
 		case 'g': reply = handle_g(buf); break;
@@ -1390,8 +1675,11 @@ void debug_gdbstub::handle_packet()
 		case 'p': reply = handle_p(buf); break;
 		case 'P': reply = handle_P(buf); break;
 		case 'q': reply = handle_q(buf); break;
+		case 'Q': reply = handle_Q(buf); break;
 		case 's': reply = handle_s(buf); break;
 		case 'T': reply = handle_T(buf); break;
+		case 'v': reply = handle_v(buf); break;
+		case 'X': reply = handle_X(buf); break;
 		case 'z': reply = handle_z(buf); break;
 		case 'Z': reply = handle_Z(buf); break;
 	}
@@ -1451,6 +1739,7 @@ void debug_gdbstub::set_register_value(int gdb_regnum, uint64_t value)
 {
 	const gdb_register &reg = m_gdb_registers[gdb_regnum];
 	m_state->set_state_int(reg.state_index, value);
+	m_debugger_cpu->reverse().machine_changed();
 }
 
 //-------------------------------------------------------------------------
@@ -47,11 +47,15 @@
 #include "osdcore.h"
 #include "unicode.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
 #include <type_traits>
 #include <vector>
 
@@ -61,6 +65,17 @@
 #include <cstdlib>
 #include <unistd.h>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 
 
 namespace {
@@ -78,7 +93,7 @@ constexpr char PATHSEPCH = '/';
 
 
 
-class posix_osd_file : public osd_file
+class posix_osd_file : public osd_file, public posix_osd_pollable
 {
 public:
 	posix_osd_file(posix_osd_file const &) = delete;
@@ -160,11 +175,177 @@ public:
 		return std::error_condition();
 	}
 
+	virtual int poll_descriptor() const noexcept override
+	{
+		// only useful for named pipes; the poller refuses plain files
+		return m_fd;
+	}
+
 private:
 	int m_fd;
 };
 
 
+#if !defined(_WIN32)
+
+class posix_osd_file_mapping : public osd_file_mapping
+{
+public:
+	posix_osd_file_mapping(posix_osd_file_mapping const &) = delete;
+	posix_osd_file_mapping(posix_osd_file_mapping &&) = delete;
+	posix_osd_file_mapping& operator=(posix_osd_file_mapping const &) = delete;
+	posix_osd_file_mapping& operator=(posix_osd_file_mapping &&) = delete;
+
+	posix_osd_file_mapping(void *base, std::uint64_t size, bool writeable) noexcept : m_base(base), m_size(size), m_writeable(writeable)
+	{
+		assert(m_base != MAP_FAILED);
+	}
+
+	virtual ~posix_osd_file_mapping() override
+	{
+		::munmap(m_base, size_t(m_size));
+	}
+
+	virtual void *data() const noexcept override { return m_base; }
+	virtual std::uint64_t size() const noexcept override { return m_size; }
+	virtual bool writeable() const noexcept override { return m_writeable; }
+
+	virtual void prefetch(std::uint64_t offset, std::uint64_t length) noexcept override
+	{
+		if (offset >= m_size)
+			return;
+		length = (std::min)(length, m_size - offset);
+
+		// madvise wants a page-aligned start address
+		std::uint64_t const pagemask = std::uint64_t(::sysconf(_SC_PAGESIZE)) - 1;
+		std::uint64_t const start = offset & ~pagemask;
+		::madvise(reinterpret_cast<std::uint8_t *>(m_base) + start, size_t(length + offset - start), MADV_WILLNEED);
+	}
+
+	virtual std::error_condition flush() noexcept override
+	{
+		if (::msync(m_base, size_t(m_size), MS_SYNC) < 0)
+			return std::error_condition(errno, std::generic_category());
+		return std::error_condition();
+	}
+
+private:
+	void *m_base;
+	std::uint64_t m_size;
+	bool m_writeable;
+};
+
+#endif // !defined(_WIN32)
+
+
+#if defined(__linux__)
+
+class posix_osd_file_poller : public osd_file_poller
+{
+public:
+	posix_osd_file_poller(posix_osd_file_poller const &) = delete;
+	posix_osd_file_poller(posix_osd_file_poller &&) = delete;
+	posix_osd_file_poller& operator=(posix_osd_file_poller const &) = delete;
+	posix_osd_file_poller& operator=(posix_osd_file_poller &&) = delete;
+
+	posix_osd_file_poller(int epoll, int event) noexcept : m_epoll(epoll), m_event(event)
+	{
+		assert(m_epoll >= 0);
+		assert(m_event >= 0);
+	}
+
+	virtual ~posix_osd_file_poller() override
+	{
+		::close(m_event);
+		::close(m_epoll);
+	}
+
+	virtual std::error_condition arm(osd_file &file, void *cookie) noexcept override
+	{
+		auto const pollable = dynamic_cast<posix_osd_pollable *>(&file);
+		if (!pollable)
+			return std::errc::not_supported;
+
+		// once the other end has gone away the file is readable (at end of
+		// file) for good, so it would be reported straight away every time
+		int const fd = pollable->poll_descriptor();
+		struct pollfd check;
+		check.fd = fd;
+		check.events = POLLIN | POLLRDHUP;
+		check.revents = 0;
+		if ((::poll(&check, 1, 0) > 0) && (check.revents & (POLLHUP | POLLRDHUP | POLLERR)))
+			return std::errc::broken_pipe;
+
+		// one-shot, so a file nobody is reading doesn't keep waking the waiting thread
+		struct epoll_event event;
+		event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+		event.data.ptr = cookie;
+		if (!::epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &event))
+			return std::error_condition();
+		if ((ENOENT == errno) && !::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event))
+			return std::error_condition();
+		else if (EPERM == errno)
+			return std::errc::not_supported; // plain files and directories can't be watched
+		else
+			return std::error_condition(errno, std::generic_category());
+	}
+
+	virtual void disarm(osd_file &file) noexcept override
+	{
+		auto const pollable = dynamic_cast<posix_osd_pollable *>(&file);
+		if (pollable)
+			::epoll_ctl(m_epoll, EPOLL_CTL_DEL, pollable->poll_descriptor(), nullptr);
+	}
+
+	virtual std::error_condition wait(std::chrono::milliseconds timeout, std::vector<void *> &ready) noexcept override
+	{
+		ready.clear();
+
+		struct epoll_event events[16];
+		int const limit = (timeout.count() < 0) ? -1 : int((std::min<std::chrono::milliseconds::rep>)(timeout.count(), std::numeric_limits<int>::max()));
+		int const count = ::epoll_wait(m_epoll, events, std::size(events), limit);
+		if (count < 0)
+			return std::error_condition(errno, std::generic_category());
+
+		bool interrupted = false;
+		try
+		{
+			for (int i = 0; count > i; ++i)
+			{
+				void *const cookie = events[i].data.ptr; // the structure is packed on some targets
+				if (cookie == this)
+				{
+					std::uint64_t value;
+					[[maybe_unused]] ssize_t const result = ::read(m_event, &value, sizeof(value));
+					interrupted = true;
+				}
+				else
+				{
+					ready.emplace_back(cookie);
+				}
+			}
+		}
+		catch (std::bad_alloc const &)
+		{
+			return std::errc::not_enough_memory;
+		}
+		return interrupted ? std::errc::interrupted : std::error_condition();
+	}
+
+	virtual void interrupt() noexcept override
+	{
+		std::uint64_t const value = 1;
+		[[maybe_unused]] ssize_t const result = ::write(m_event, &value, sizeof(value));
+	}
+
+private:
+	int m_epoll;
+	int m_event;
+};
+
+#endif // defined(__linux__)
+
+
 //============================================================
 //  is_path_separator
 //============================================================
@@ -329,6 +510,137 @@ std::error_condition osd_file::open(std::string const &path, std::uint32_t openf
 }
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+std::error_condition osd_file_mapping::open(std::string const &path, bool writeable, ptr &mapping) noexcept
+{
+#if defined(_WIN32)
+	return std::errc::not_supported;
+#else
+	if (posix_check_socket_path(path) || posix_check_ptty_path(path) || posix_check_domain_path(path))
+		return std::errc::not_supported;
+
+	int const fd = ::open(path.c_str(), writeable ? O_RDWR : O_RDONLY);
+	if (fd < 0)
+		return std::error_condition(errno, std::generic_category());
+
+	struct stat st;
+	if (::fstat(fd, &st) < 0)
+	{
+		std::error_condition staterr(errno, std::generic_category());
+		::close(fd);
+		return staterr;
+	}
+	if (!S_ISREG(st.st_mode) || !st.st_size || (std::uint64_t(st.st_size) > std::uint64_t(std::numeric_limits<size_t>::max())))
+	{
+		::close(fd);
+		return std::errc::not_supported;
+	}
+
+	// the mapping keeps the file referenced, so the descriptor isn't needed afterwards
+	std::uint64_t const size = std::uint64_t(std::make_unsigned_t<decltype(st.st_size)>(st.st_size));
+	void *const base = ::mmap(nullptr, size_t(size), writeable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	if (base == MAP_FAILED)
+	{
+		std::error_condition maperr(errno, std::generic_category());
+		::close(fd);
+		return maperr;
+	}
+	::close(fd);
+
+	osd_file_mapping::ptr result(new (std::nothrow) posix_osd_file_mapping(base, size, writeable));
+	if (!result)
+	{
+		::munmap(base, size_t(size));
+		return std::errc::not_enough_memory;
+	}
+	mapping = std::move(result);
+	return std::error_condition();
+#endif
+}
+
+
+//============================================================
+//  osd_file_poller::create
+//============================================================
+
+std::error_condition osd_file_poller::create(ptr &poller) noexcept
+{
+#if defined(__linux__)
+	int const epoll = ::epoll_create1(EPOLL_CLOEXEC);
+	if (epoll < 0)
+		return std::error_condition(errno, std::generic_category());
+
+	int const event = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (event < 0)
+	{
+		std::error_condition eventerr(errno, std::generic_category());
+		::close(epoll);
+		return eventerr;
+	}
+
+	osd_file_poller::ptr result(new (std::nothrow) posix_osd_file_poller(epoll, event));
+	if (!result)
+	{
+		::close(event);
+		::close(epoll);
+		return std::errc::not_enough_memory;
+	}
+
+	// the event descriptor stays armed so interrupt always ends a wait
+	struct epoll_event watch;
+	watch.events = EPOLLIN;
+	watch.data.ptr = result.get();
+	if (::epoll_ctl(epoll, EPOLL_CTL_ADD, event, &watch) < 0)
+		return std::error_condition(errno, std::generic_category());
+
+	poller = std::move(result);
+	return std::error_condition();
+#else
+	return std::errc::not_supported;
+#endif
+}
+
+
+//============================================================
+//  posix_write_gather
+//============================================================
+
+std::error_condition posix_write_gather(int fd, osd_file::write_buffer const *buffers, std::size_t count, std::uint32_t &actual) noexcept
+{
+#if defined(_WIN32)
+	return std::errc::not_supported;
+#else
+	actual = 0;
+	while (count)
+	{
+		struct iovec vec[16];
+		std::size_t const chunk = (std::min)(count, std::size(vec));
+		std::size_t expected = 0;
+		for (std::size_t i = 0; chunk > i; ++i)
+		{
+			vec[i].iov_base = const_cast<void *>(buffers[i].data);
+			vec[i].iov_len = buffers[i].length;
+			expected += buffers[i].length;
+		}
+
+		ssize_t const result = ::writev(fd, vec, int(chunk));
+		if (result < 0)
+			return std::error_condition(errno, std::generic_category());
+
+		actual += std::uint32_t(std::size_t(result));
+		if (std::size_t(result) < expected)
+			break;
+		buffers += chunk;
+		count -= chunk;
+	}
+	return std::error_condition();
+#endif
+}
+
+
 //============================================================
 //  osd_file::openpty
 //============================================================
@@ -14,11 +14,26 @@
 
 #include "osdfile.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <system_error>
 
 
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+// implemented by files that can be watched by the poller
+class posix_osd_pollable
+{
+public:
+	virtual ~posix_osd_pollable() = default;
+
+	virtual int poll_descriptor() const noexcept = 0;
+};
+
+
 //============================================================
 //  PROTOTYPES
 //============================================================
@@ -32,4 +47,6 @@ std::error_condition posix_open_domain(std::string const &path, std::uint32_t op
 bool posix_check_ptty_path(std::string const &path) noexcept;
 std::error_condition posix_open_ptty(std::uint32_t openflags, osd_file::ptr &file, std::uint64_t &filesize, std::string &name) noexcept;
 
+std::error_condition posix_write_gather(int fd, osd_file::write_buffer const *buffers, std::size_t count, std::uint32_t &actual) noexcept;
+
 #endif // MAME_OSD_MODULES_FILE_POSIXFILE_H
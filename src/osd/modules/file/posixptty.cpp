@@ -44,7 +44,7 @@ char const *const posix_ptty_identifier  = "/dev/pts";
 #endif
 
 
-class posix_osd_ptty : public osd_file
+class posix_osd_ptty : public osd_file, public posix_osd_pollable
 {
 public:
 	posix_osd_ptty(posix_osd_ptty const &) = delete;
@@ -82,6 +82,11 @@ public:
 		return std::error_condition();
 	}
 
+	virtual std::error_condition write_gather(write_buffer const *buffers, std::size_t count, std::uint64_t offset, std::uint32_t &actual) noexcept override
+	{
+		return posix_write_gather(m_fd, buffers, count, actual);
+	}
+
 	virtual std::error_condition truncate(std::uint64_t offset) noexcept override
 	{
 		// doesn't make sense on ptty
@@ -94,6 +99,11 @@ public:
 		return std::error_condition();
 	}
 
+	virtual int poll_descriptor() const noexcept override
+	{
+		return m_fd;
+	}
+
 private:
 	int m_fd;
 };
@@ -34,7 +34,7 @@ char const *const posixfile_socket_identifier  = "socket.";
 char const *const posixfile_domain_identifier  = "domain.";
 
 
-class posix_osd_socket : public osd_file
+class posix_osd_socket : public osd_file, public posix_osd_pollable
 {
 public:
 	posix_osd_socket(posix_osd_socket const &) = delete;
@@ -120,6 +120,13 @@ public:
 		return std::error_condition();
 	}
 
+	virtual std::error_condition write_gather(write_buffer const *buffers, std::size_t count, std::uint64_t offset, std::uint32_t &actual) noexcept override
+	{
+		if (m_listening)
+			return std::errc::not_connected;
+		return posix_write_gather(m_sock, buffers, count, actual);
+	}
+
 	virtual std::error_condition truncate(std::uint64_t offset) noexcept override
 	{
 		// doesn't make sense on socket
@@ -132,6 +139,12 @@ public:
 		return std::error_condition();
 	}
 
+	virtual int poll_descriptor() const noexcept override
+	{
+		// a listening socket becomes readable when a connection is waiting to be accepted
+		return m_sock;
+	}
+
 private:
 	int     m_sock;
 	bool    m_listening;
@@ -171,6 +171,26 @@ std::error_condition osd_file::open(std::string const &path, std::uint32_t openf
 }
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+std::error_condition osd_file_mapping::open(std::string const &path, bool writeable, ptr &mapping) noexcept
+{
+	return std::errc::not_supported;
+}
+
+
+//============================================================
+//  osd_file_poller::create
+//============================================================
+
+std::error_condition osd_file_poller::create(ptr &poller) noexcept
+{
+	return std::errc::not_supported;
+}
+
+
 //============================================================
 //  osd_openpty
 //============================================================
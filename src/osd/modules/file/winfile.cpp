@@ -116,6 +116,58 @@ private:
 };
 
 
+class win_osd_file_mapping : public osd_file_mapping
+{
+public:
+	win_osd_file_mapping(win_osd_file_mapping const &) = delete;
+	win_osd_file_mapping(win_osd_file_mapping &&) = delete;
+	win_osd_file_mapping& operator=(win_osd_file_mapping const &) = delete;
+	win_osd_file_mapping& operator=(win_osd_file_mapping &&) = delete;
+
+	win_osd_file_mapping(HANDLE file, HANDLE mapping, void *base, std::uint64_t size, bool writeable) noexcept
+		: m_file(file)
+		, m_mapping(mapping)
+		, m_base(base)
+		, m_size(size)
+		, m_writeable(writeable)
+	{
+		assert(m_base);
+	}
+
+	virtual ~win_osd_file_mapping() override
+	{
+		UnmapViewOfFile(m_base);
+		CloseHandle(m_mapping);
+		CloseHandle(m_file);
+	}
+
+	virtual void *data() const noexcept override { return m_base; }
+	virtual std::uint64_t size() const noexcept override { return m_size; }
+	virtual bool writeable() const noexcept override { return m_writeable; }
+
+	virtual void prefetch(std::uint64_t offset, std::uint64_t length) noexcept override
+	{
+		// PrefetchVirtualMemory needs Windows 8; rely on the cache manager's own read-ahead
+	}
+
+	virtual std::error_condition flush() noexcept override
+	{
+		if (!FlushViewOfFile(m_base, 0))
+			return win_error_to_error_condition(GetLastError());
+		if (m_writeable && !FlushFileBuffers(m_file))
+			return win_error_to_error_condition(GetLastError());
+		return std::error_condition();
+	}
+
+private:
+	HANDLE m_file;
+	HANDLE m_mapping;
+	void *m_base;
+	std::uint64_t m_size;
+	bool m_writeable;
+};
+
+
 
 //============================================================
 //  INLINE FUNCTIONS
@@ -272,6 +324,76 @@ std::error_condition osd_file::open(std::string const &path, uint32_t openflags,
 
 
 
+//============================================================
+//  osd_file_mapping::open
+//============================================================
+
+std::error_condition osd_file_mapping::open(std::string const &path, bool writeable, ptr &mapping) noexcept
+{
+	if (win_check_socket_path(path) || win_check_ptty_path(path) || is_path_to_physical_drive(path.c_str()))
+		return std::errc::not_supported;
+
+	osd::text::tstring t_path;
+	try { t_path = osd::text::to_tstring(path); }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	DWORD const access = writeable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+	HANDLE const file = CreateFile(t_path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+	if (INVALID_HANDLE_VALUE == file)
+		return win_error_to_error_condition(GetLastError());
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+	{
+		DWORD const err = GetLastError();
+		CloseHandle(file);
+		return size.QuadPart ? win_error_to_error_condition(err) : std::errc::not_supported;
+	}
+
+	HANDLE const section = CreateFileMapping(file, nullptr, writeable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	if (!section)
+	{
+		DWORD const err = GetLastError();
+		CloseHandle(file);
+		return win_error_to_error_condition(err);
+	}
+
+	void *const base = MapViewOfFile(section, writeable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+	if (!base)
+	{
+		DWORD const err = GetLastError();
+		CloseHandle(section);
+		CloseHandle(file);
+		return win_error_to_error_condition(err);
+	}
+
+	osd_file_mapping::ptr result(new (std::nothrow) win_osd_file_mapping(file, section, base, std::uint64_t(size.QuadPart), writeable));
+	if (!result)
+	{
+		UnmapViewOfFile(base);
+		CloseHandle(section);
+		CloseHandle(file);
+		return std::errc::not_enough_memory;
+	}
+	mapping = std::move(result);
+	return std::error_condition();
+}
+
+
+
+//============================================================
+//  osd_file_poller::create
+//============================================================
+
+std::error_condition osd_file_poller::create(ptr &poller) noexcept
+{
+	// readiness notification isn't available on Windows, so devices keep
+	// polling their host files with timers
+	return std::errc::not_supported;
+}
+
+
+
 //============================================================
 //  osd_openpty
 //============================================================
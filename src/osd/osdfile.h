@@ -13,6 +13,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -138,6 +139,44 @@ public:
 	/// \return Result of the operation.
 	virtual std::error_condition write(void const *buffer, std::uint64_t offset, std::uint32_t length, std::uint32_t &actual) noexcept = 0;
 
+	/// \brief Buffer descriptor for gathered writes
+	struct write_buffer
+	{
+		void const *data;       ///< Pointer to memory containing data to write.
+		std::uint32_t length;   ///< Number of bytes to write.
+	};
+
+	/// \brief Write several buffers to an open file
+	///
+	/// Writes the contents of the buffers back to back, as though they
+	/// had been concatenated.  Stream-like objects do this with a
+	/// single system call where the host supports it, so the data isn't
+	/// split into separate packets or wakeups at the other end.  The
+	/// default implementation writes the buffers one at a time.
+	/// \param [in] buffers Pointer to the buffer descriptors.
+	/// \param [in] count Number of buffer descriptors.
+	/// \param [in] offset Byte offset within the file to write at,
+	///   relative to the start of the file.  Ignored for stream-like
+	///   objects (e.g. TCP sockets or named pipes).
+	/// \param [out] actual Receives the total number of bytes written if
+	///   the operation succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.
+	virtual std::error_condition write_gather(write_buffer const *buffers, std::size_t count, std::uint64_t offset, std::uint32_t &actual) noexcept
+	{
+		actual = 0;
+		for (std::size_t i = 0; count > i; ++i)
+		{
+			std::uint32_t written;
+			std::error_condition const err = write(buffers[i].data, offset + actual, buffers[i].length, written);
+			if (err)
+				return err;
+			actual += written;
+			if (written < buffers[i].length)
+				break;
+		}
+		return std::error_condition();
+	}
+
 	/// \brief Change the size of an open file
 	///
 	/// \param [in] offset Desired size of the file.
@@ -159,6 +198,133 @@ public:
 };
 
 
+/// \brief Interface to memory-mapped files
+///
+/// Maps the whole of a plain file into the address space so its
+/// contents can be accessed with ordinary loads and stores.  Stores to
+/// a writeable mapping are reflected in the file.  Stream-like objects
+/// (e.g. TCP sockets or named pipes) cannot be mapped.
+class osd_file_mapping
+{
+public:
+	/// \brief Smart pointer to a file mapping
+	typedef std::unique_ptr<osd_file_mapping> ptr;
+
+	/// \brief Map a file into memory
+	///
+	/// \param [in] path Path to the file to map.
+	/// \param [in] writeable True to map the file for reading and
+	///   writing, or false to map it read-only.
+	/// \param [out] mapping Receives the mapping if the operation
+	///   succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.  Returns
+	///   std::errc::not_supported if the host can't map files.
+	static std::error_condition open(std::string const &path, bool writeable, ptr &mapping) noexcept;
+
+	/// \brief Unmap the file
+	///
+	/// Modified pages are written back to the file, but there is no
+	/// guarantee that they have reached persistent storage.
+	virtual ~osd_file_mapping() { }
+
+	/// \brief Get a pointer to the start of the mapped file
+	/// \return Pointer to the first byte of the file.
+	virtual void *data() const noexcept = 0;
+
+	/// \brief Get the size of the mapped file
+	/// \return Size of the mapping in bytes.
+	virtual std::uint64_t size() const noexcept = 0;
+
+	/// \brief Find out whether the mapping accepts stores
+	/// \return True if the file was mapped for writing.
+	virtual bool writeable() const noexcept = 0;
+
+	/// \brief Advise that a range will be accessed soon
+	///
+	/// Asks the host to start reading the range into memory.  This is
+	/// only a hint and may be ignored.
+	/// \param [in] offset Byte offset of the start of the range.
+	/// \param [in] length Length of the range in bytes.
+	virtual void prefetch(std::uint64_t offset, std::uint64_t length) noexcept = 0;
+
+	/// \brief Write modified pages back to the file
+	///
+	/// Waits until all modified pages have been written to the file.
+	/// \return Result of the operation.
+	virtual std::error_condition flush() noexcept = 0;
+};
+
+
+/// \brief Readiness notification for stream-like files
+///
+/// Lets a thread sleep until stream-like files (TCP sockets,
+/// pseudo-terminals, named pipes) have data available to read, rather
+/// than polling them.  A file is armed for a single notification; once
+/// it has been reported it must be armed again before it will be
+/// reported again.  Arming a file that already has data available
+/// reports it straight away.
+class osd_file_poller
+{
+public:
+	/// \brief Smart pointer to a poller
+	typedef std::unique_ptr<osd_file_poller> ptr;
+
+	/// \brief Create a poller
+	///
+	/// \param [out] poller Receives the poller if the operation
+	///   succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.  Returns
+	///   std::errc::not_supported if the host has no readiness
+	///   notification mechanism.  Only Linux (epoll) is supported at
+	///   present.
+	static std::error_condition create(ptr &poller) noexcept;
+
+	/// \brief Destroy the poller
+	///
+	/// Must not be called while another thread is waiting.
+	virtual ~osd_file_poller() { }
+
+	/// \brief Arm a file for a single notification
+	///
+	/// May be called while another thread is waiting.
+	/// \param [in] file File to watch.  Must stay open until it has
+	///   been reported or disarmed.
+	/// \param [in] cookie Value reported when the file becomes
+	///   readable.
+	/// \return Result of the operation.  Returns
+	///   std::errc::not_supported if the file can't be watched (e.g. a
+	///   plain file, which can always be read without blocking), or
+	///   std::errc::broken_pipe if the other end has hung up, as the
+	///   file would then be reported straight away every time.
+	virtual std::error_condition arm(osd_file &file, void *cookie) noexcept = 0;
+
+	/// \brief Stop watching a file
+	///
+	/// May be called while another thread is waiting.  A notification
+	/// for the file may still be reported by a wait that was already
+	/// in progress.
+	/// \param [in] file File to stop watching.
+	virtual void disarm(osd_file &file) noexcept = 0;
+
+	/// \brief Wait for armed files to become readable
+	///
+	/// \param [in] timeout Maximum time to wait, or a negative value
+	///   to wait indefinitely.
+	/// \param [out] ready Receives the cookies of files that became
+	///   readable.  Cleared before waiting.
+	/// \return Result of the operation.  Returns
+	///   std::errc::interrupted if the wait was ended by a call to
+	///   interrupt.
+	virtual std::error_condition wait(std::chrono::milliseconds timeout, std::vector<void *> &ready) noexcept = 0;
+
+	/// \brief End a wait in progress
+	///
+	/// May be called from any thread.  If no thread is waiting, the
+	/// next wait returns immediately.
+	virtual void interrupt() noexcept = 0;
+};
+
+
 /// \brief Describe geometry of physical drive
 ///
 /// If the given path points to a physical drive, return the geometry of
@@ -81,6 +81,11 @@ void osd_network_device::poll()
 	}
 }
 
+int osd_network_device::receive(uint8_t **buf)
+{
+	return m_stopped ? 0 : recv_dev(buf);
+}
+
 int osd_network_device::send(uint8_t *buf, int len)
 {
 	return 0;
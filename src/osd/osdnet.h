@@ -42,6 +42,7 @@ public:
 	void start();
 	void stop();
 	void poll();
+	int receive(uint8_t **buf);
 
 	virtual int send(uint8_t *buf, int len);
 	virtual void set_mac(const uint8_t *mac);
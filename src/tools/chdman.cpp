@@ -649,7 +649,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression or decompression" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -672,7 +672,8 @@ static const command_description s_commands[] =
 		{
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
-			OPTION_FIX
+			OPTION_FIX,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -764,7 +765,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -777,7 +779,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -801,7 +804,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -1361,6 +1365,56 @@ static void parse_numprocessors(const parameters_map &params)
 }
 
 
+//-------------------------------------------------
+//  read_chd_pipelined - feed a range of a CHD to
+//  a consumer in order, decompressing the next
+//  batch of hunks on worker threads meanwhile
+//-------------------------------------------------
+
+template <typename Consumer>
+static void read_chd_pipelined(chd_file &input_chd, const std::string &input_name, uint64_t start, uint64_t end, const char *action, Consumer &&consumer)
+{
+	const uint32_t hunkbytes = input_chd.hunk_bytes();
+	const uint32_t batchhunks = std::max<uint32_t>(TEMP_BUFFER_SIZE / hunkbytes, 1);
+	const uint32_t firsthunk = start / hunkbytes;
+	const uint32_t endhunk = (end + hunkbytes - 1) / hunkbytes;
+
+	std::vector<uint8_t> buffer[2];
+	buffer[0].resize(uint64_t(batchhunks) * hunkbytes);
+	buffer[1].resize(uint64_t(batchhunks) * hunkbytes);
+
+	chd_parallel_reader reader(input_chd);
+	auto const begin_batch =
+			[&] (uint32_t hunknum, std::vector<uint8_t> &dest)
+			{
+				std::error_condition err = reader.read_hunks_begin(hunknum, std::min(batchhunks, endhunk - hunknum), &dest[0]);
+				if (err)
+					report_error(1, "Error reading CHD file (%s): %s", input_name, err.message());
+			};
+
+	if (firsthunk < endhunk)
+		begin_batch(firsthunk, buffer[0]);
+	for (uint32_t hunknum = firsthunk, current = 0; hunknum < endhunk; hunknum += batchhunks, current ^= 1)
+	{
+		const uint64_t batchstart = uint64_t(hunknum) * hunkbytes;
+		progress(false, "%s, %.1f%% complete... \r", action, 100.0 * double(std::max(batchstart, start) - start) / double(end - start));
+
+		// wait for this batch, then get the next one going before consuming it
+		std::error_condition err = reader.read_hunks_end();
+		if (err)
+			report_error(1, "Error reading CHD file (%s): %s", input_name, err.message());
+		const uint32_t count = std::min(batchhunks, endhunk - hunknum);
+		if ((hunknum + count) < endhunk)
+			begin_batch(hunknum + count, buffer[current ^ 1]);
+
+		// trim partial hunks at either end of the requested range
+		const uint64_t datastart = std::max(batchstart, start);
+		const uint64_t dataend = std::min(batchstart + uint64_t(count) * hunkbytes, end);
+		consumer(&buffer[current][datastart - batchstart], uint32_t(dataend - datastart));
+	}
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1434,6 +1488,26 @@ static void create_output_chd(
 }
 
 
+//-------------------------------------------------
+//  train_dictionary - train a shared dictionary
+//  for codecs that use one
+//-------------------------------------------------
+
+static void train_dictionary(chd_file_compressor &chd)
+{
+	progress(true, "Training dictionary...\r");
+	std::error_condition const err = chd.train_dictionary();
+	if (err == std::errc::not_supported)
+		return;
+
+	// a failure here just means compressing without a dictionary
+	if (err)
+		progress(true, "Unable to train dictionary (%s); compressing without one\n", err.message());
+	else
+		progress(true, "Dictionary training complete            \n");
+}
+
+
 //-------------------------------------------------
 //  compress_common - standard compression loop
 //-------------------------------------------------
@@ -1735,25 +1809,12 @@ static void do_verify(parameters_map &params)
 	if (raw_sha1 == util::sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
-	// create an array to read into
-	std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
-
 	// read all the data and build up an SHA-1
+	parse_numprocessors(params);
 	util::sha1_creator rawsha1;
-	for (uint64_t offset = 0; offset < input_chd.logical_bytes(); )
-	{
-		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
-
-		// determine how much to read
-		uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_chd.logical_bytes() - offset);
-		std::error_condition err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-		if (err)
-			report_error(1, "Error reading CHD file (%s): %s", *params.find(OPTION_INPUT)->second, err.message());
-
-		// add to the checksum
-		rawsha1.append(&buffer[0], bytes_to_read);
-		offset += bytes_to_read;
-	}
+	read_chd_pipelined(
+			input_chd, *params.find(OPTION_INPUT)->second, 0, input_chd.logical_bytes(), "Verifying",
+			[&rawsha1] (const uint8_t *data, uint32_t length) { rawsha1.append(data, length); });
 	util::sha1_t computed_sha1 = rawsha1.finish();
 
 	// finish up
@@ -2069,7 +2130,10 @@ static void do_create_hd(parameters_map &params)
 
 		// compress it generically
 		if (input_file)
+		{
+			train_dictionary(*chd);
 			compress_common(*chd);
+		}
 	}
 	catch (...)
 	{
@@ -2423,6 +2487,9 @@ static void do_copy(parameters_map &params)
 				cdda_swap = redo_cd = true;
 				continue;
 			}
+			// dictionaries are retrained for the new compression settings
+			if (metatag == ZSTD_DICT_METADATA_TAG)
+				continue;
 
 			// otherwise, clone it
 			err = chd->write_metadata(metatag, CHDMETAINDEX_APPEND, metadata, metaflags);
@@ -2443,6 +2510,7 @@ static void do_copy(parameters_map &params)
 		}
 
 		// compress it generically
+		train_dictionary(*chd);
 		compress_common(*chd);
 	}
 	catch (...)
@@ -2493,25 +2561,15 @@ static void do_extract_raw(parameters_map &params)
 			report_error(1, "Unable to open file (%s): %s", *output_file_str->second, filerr.message());
 
 		// copy all data
-		std::vector<uint8_t> buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
-		for (uint64_t offset = input_start; offset < input_end; )
-		{
-			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
-
-			// determine how much to read
-			uint32_t bytes_to_read = (std::min<uint64_t>)(buffer.size(), input_end - offset);
-			std::error_condition err = input_chd.read_bytes(offset, &buffer[0], bytes_to_read);
-			if (err)
-				report_error(1, "Error reading CHD file (%s): %s", *params.find(OPTION_INPUT)->second, err.message());
-
-			// write to the output
-			auto const [writerr, count] = write(*output_file, &buffer[0], bytes_to_read);
-			if (writerr)
-				report_error(1, "Error writing to file; check disk space (%s)", *output_file_str->second);
-
-			// advance
-			offset += bytes_to_read;
-		}
+		parse_numprocessors(params);
+		read_chd_pipelined(
+				input_chd, *params.find(OPTION_INPUT)->second, input_start, input_end, "Extracting",
+				[&output_file, &output_file_str] (const uint8_t *data, uint32_t length)
+				{
+					auto const [writerr, count] = write(*output_file, data, length);
+					if (writerr)
+						report_error(1, "Error writing to file; check disk space (%s)", *output_file_str->second);
+				});
 
 		// finish up
 		output_file.reset();
@@ -10,6 +10,7 @@
 
 #include "formats/fsblk.h"
 
+#include "corefile.h"
 #include "corestr.h"
 #include "ioprocs.h"
 #include "path.h"
@@ -17,7 +18,10 @@
 
 #include "osdcomm.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cctype>
 #include <cstdarg>
 #include <cstdio>
@@ -25,6 +29,10 @@
 #include <cstring>
 #include <ctime>
 #include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
 
 
 static formats_table formats;
@@ -36,6 +44,7 @@ static void display_usage(const char *first_argument)
 	fprintf(stderr, "Usage: \n");
 	fprintf(stderr, "       %s identify <inputfile> [<inputfile> ...]                                 -- Identify an image format\n", exe_name.c_str());
 	fprintf(stderr, "       %s flopconvert [input_format|auto] output_format <inputfile> <outputfile> -- Convert a floppy image\n", exe_name.c_str());
+	fprintf(stderr, "       %s flopbatch [input_format|auto] output_format <inputdir> <outputdir> [-j <threads>] -- Convert a directory tree of floppy images\n", exe_name.c_str());
 	fprintf(stderr, "       %s flopcreate output_format filesystem <outputfile>                       -- Create a preformatted floppy image\n", exe_name.c_str());
 	fprintf(stderr, "       %s flopdir input_format filesystem <image>                                -- List the contents of a floppy image\n", exe_name.c_str());
 	fprintf(stderr, "       %s flopread input_format filesystem <image> <path> <outputfile>           -- Extract a file from a floppy image\n", exe_name.c_str());
@@ -229,6 +238,311 @@ static int flopconvert(int argc, char *argv[])
 	return 0;
 }
 
+// Batch conversion.  Every file below the input directory is converted
+// to the same relative place below the output directory, one image per
+// thread.  With auto-detection every file is identified on its own, as
+// files sharing an extension and size can still be different formats,
+// but the result is kept in a cache in the output directory.  A rerun
+// skips identification for files whose path, size and modification
+// time haven't changed.
+
+namespace {
+
+struct batch_file {
+	std::string m_path;
+	std::string m_dstpath;
+	uint64_t m_size;
+	int64_t m_mtime;
+};
+
+class identify_cache {
+public:
+	void load(const std::string &path);
+	bool save(const std::string &path) const;
+
+	const floppy_format_info *find(const batch_file &file) const;
+	void add(const batch_file &file, const floppy_format_info &format);
+	void remove(const batch_file &file);
+
+private:
+	struct entry {
+		uint64_t m_size;
+		int64_t m_mtime;
+		std::string m_format;
+	};
+
+	mutable std::mutex m_lock;
+	std::map<std::string, entry> m_entries;
+};
+
+} // anonymous namespace
+
+static const char BATCH_CACHE_NAME[] = ".flopbatch-cache";
+
+// One line per file: size, modification time, format and relative
+// path, separated by tabs.  The path is last so it may contain tabs.
+void identify_cache::load(const std::string &path)
+{
+	FILE *f = fopen(path.c_str(), "r");
+	if(!f)
+		return;
+
+	std::string line;
+	char buffer[1024];
+	while(fgets(buffer, sizeof(buffer), f)) {
+		line.append(buffer);
+		if(line.empty() || line.back() != '\n')
+			continue;
+		line.pop_back();
+
+		char *end;
+		uint64_t const size = strtoull(line.c_str(), &end, 10);
+		if(*end == '\t') {
+			int64_t const mtime = strtoll(end + 1, &end, 10);
+			if(*end == '\t') {
+				char *const format = end + 1;
+				char *const name = strchr(format, '\t');
+				if(name && name != format && name[1])
+					m_entries[name + 1] = entry{ size, mtime, std::string(format, name) };
+			}
+		}
+		line.clear();
+	}
+	fclose(f);
+}
+
+bool identify_cache::save(const std::string &path) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	FILE *f = fopen(path.c_str(), "w");
+	if(!f)
+		return false;
+
+	for(const auto &[name, info] : m_entries)
+		fprintf(f, "%llu\t%lld\t%s\t%s\n", (unsigned long long)info.m_size, (long long)info.m_mtime, info.m_format.c_str(), name.c_str());
+	return !fclose(f);
+}
+
+const floppy_format_info *identify_cache::find(const batch_file &file) const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	auto const found = m_entries.find(file.m_path);
+	if(found == m_entries.end() || found->second.m_size != file.m_size || found->second.m_mtime != file.m_mtime)
+		return nullptr;
+	return formats.find_floppy_format_info_by_key(found->second.m_format);
+}
+
+void identify_cache::add(const batch_file &file, const floppy_format_info &format)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_entries[file.m_path] = entry{ file.m_size, file.m_mtime, format.m_format->name() };
+}
+
+void identify_cache::remove(const batch_file &file)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_entries.erase(file.m_path);
+}
+
+static void batch_scan(const std::string &root, const std::string &relpath, std::vector<batch_file> &files)
+{
+	auto dir = osd::directory::open(relpath.empty() ? root : util::path_concat(root, relpath));
+	if(!dir) {
+		fprintf(stderr, "Error: Could not open directory %s\n", (relpath.empty() ? root : util::path_concat(root, relpath)).c_str());
+		return;
+	}
+
+	while(const osd::directory::entry *entry = dir->read()) {
+		if(!strcmp(entry->name, ".") || !strcmp(entry->name, ".."))
+			continue;
+		std::string path = relpath.empty() ? std::string(entry->name) : util::path_concat(relpath, entry->name);
+		if(entry->type == osd::directory::entry::entry_type::DIR)
+			batch_scan(root, path, files);
+		else if(entry->type == osd::directory::entry::entry_type::FILE && strcmp(entry->name, BATCH_CACHE_NAME))
+			files.emplace_back(batch_file{ std::move(path), std::string(), entry->size, std::chrono::duration_cast<std::chrono::nanoseconds>(entry->last_modified.time_since_epoch()).count() });
+	}
+}
+
+static const floppy_format_info *batch_source_format(const char *name, image_handler &ih, std::string &error)
+{
+	if(core_stricmp(name, "auto")) {
+		const floppy_format_info *source_format = formats.find_floppy_format_info_by_key(name);
+		if(!source_format)
+			error = util::string_format("Format '%s' unknown", name);
+		return source_format;
+	}
+
+	auto scores = ih.identify(formats);
+	if(scores.empty()) {
+		error = "Could not identify the format";
+		return nullptr;
+	}
+	if(scores.size() >= 2 && scores[0].first == scores[1].first) {
+		error = util::string_format("Ambiguous source format (%s, %s, ...)", scores[0].second->m_format->name(), scores[1].second->m_format->name());
+		return nullptr;
+	}
+
+	return scores[0].second;
+}
+
+static bool batch_convert(const char *source_name, const floppy_format_info &dest_format, const batch_file &file, const std::string &srcpath, identify_cache &cache, std::string &message)
+{
+	try {
+		image_handler ih;
+		ih.set_on_disk_path(srcpath);
+
+		// A cached format that no longer loads means the file changed
+		// without its size or time changing, so identify it again
+		bool const automatic = !core_stricmp(source_name, "auto");
+		const floppy_format_info *source_format = automatic ? cache.find(file) : nullptr;
+		if(source_format && ih.floppy_load(*source_format)) {
+			cache.remove(file);
+			source_format = nullptr;
+		}
+
+		if(!source_format) {
+			source_format = batch_source_format(source_name, ih, message);
+			if(!source_format)
+				return false;
+
+			if(ih.floppy_load(*source_format)) {
+				message = util::string_format("Loading as format '%s' failed", source_format->m_format->name());
+				return false;
+			}
+			if(automatic)
+				cache.add(file, *source_format);
+		}
+
+		// Create the file once through core_file so missing
+		// directories of the output tree get created too
+		util::core_file::ptr dstfile;
+		std::error_condition const filerr = util::core_file::open(file.m_dstpath, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, dstfile);
+		if(filerr) {
+			message = util::string_format("Could not create %s (%s)", file.m_dstpath, filerr.message());
+			return false;
+		}
+		dstfile.reset();
+
+		ih.set_on_disk_path(file.m_dstpath);
+		if(ih.floppy_save(dest_format)) {
+			message = util::string_format("Saving as format '%s' failed", dest_format.m_format->name());
+			return false;
+		}
+
+		message = util::string_format("%s -> %s", source_format->m_format->name(), dest_format.m_format->name());
+		return true;
+	} catch(const std::exception &err) {
+		message = err.what();
+		return false;
+	}
+}
+
+static int flopbatch(int argc, char *argv[])
+{
+	unsigned threads = std::thread::hardware_concurrency();
+	int new_argc = 0;
+	for(int i = 0; i < argc; i++) {
+		if(!strcmp(argv[i], "-j") && i < argc - 1) {
+			char *end;
+			unsigned long const value = strtoul(argv[++i], &end, 10);
+			if(!isdigit(u8(argv[i][0])) || *end || !value) {
+				fprintf(stderr, "Error: Invalid thread count '%s'\n", argv[i]);
+				return 1;
+			}
+			threads = unsigned(std::min<unsigned long>(value, std::numeric_limits<unsigned>::max()));
+		} else
+			argv[new_argc++] = argv[i];
+	}
+	argc = new_argc;
+
+	if(argc!=6) {
+		fprintf(stderr, "Incorrect number of arguments.\n\n");
+		display_usage(argv[0]);
+		return 1;
+	}
+
+	const floppy_format_info *dest_format = formats.find_floppy_format_info_by_key(argv[3]);
+	if(!dest_format) {
+		fprintf(stderr, "Error: Format '%s' unknown\n", argv[3]);
+		return 1;
+	}
+	if(!dest_format->m_format->supports_save()) {
+		fprintf(stderr, "Error: Saving to format '%s' unsupported\n", argv[3]);
+		return 1;
+	}
+
+	std::string const srcroot = argv[4];
+	std::string const dstroot = argv[5];
+	std::vector<batch_file> files;
+	batch_scan(srcroot, std::string(), files);
+	std::sort(files.begin(), files.end(), [] (const batch_file &a, const batch_file &b) { return a.m_path < b.m_path; });
+
+	// Output files take the first extension of the destination format,
+	// so images differing only in extension would overwrite each other
+	std::string_view extension(dest_format->m_format->extensions());
+	extension = extension.substr(0, extension.find(','));
+
+	std::map<std::string, const batch_file *> destinations;
+	bool clash = false;
+	for(batch_file &entry : files) {
+		std::string_view const srcext = core_filename_extract_extension(entry.m_path);
+		entry.m_dstpath = util::path_concat(dstroot, std::string(entry.m_path, 0, entry.m_path.size() - srcext.size()).append(".").append(extension));
+
+		auto const ins = destinations.emplace(entry.m_dstpath, &entry);
+		if(!ins.second) {
+			fprintf(stderr, "Error: %s and %s would both be converted to %s\n", ins.first->second->m_path.c_str(), entry.m_path.c_str(), entry.m_dstpath.c_str());
+			clash = true;
+		}
+	}
+	if(clash)
+		return 1;
+
+	if(!threads)
+		threads = 1;
+	threads = std::min<size_t>(threads, std::max<size_t>(files.size(), 1));
+
+	std::string const cachepath = util::path_concat(dstroot, BATCH_CACHE_NAME);
+	identify_cache cache;
+	cache.load(cachepath);
+
+	std::mutex output_lock;
+	std::atomic<size_t> next(0);
+	std::atomic<unsigned> failures(0);
+
+	auto const worker = [&] () {
+		for(;;) {
+			size_t const index = next++;
+			if(index >= files.size())
+				return;
+
+			const batch_file &entry = files[index];
+			std::string message;
+			bool const ok = batch_convert(argv[2], *dest_format, entry, util::path_concat(srcroot, entry.m_path), cache, message);
+			if(!ok)
+				failures++;
+
+			std::lock_guard<std::mutex> lock(output_lock);
+			if(ok)
+				printf("%s : %s\n", entry.m_path.c_str(), message.c_str());
+			else
+				fprintf(stderr, "%s : Error: %s\n", entry.m_path.c_str(), message.c_str());
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for(unsigned i = 1; i < threads; i++)
+		workers.emplace_back(worker);
+	worker();
+	for(auto &thread : workers)
+		thread.join();
+
+	if(!core_stricmp(argv[2], "auto") && !files.empty() && !cache.save(cachepath))
+		fprintf(stderr, "Warning: Could not write identification cache %s\n", cachepath.c_str());
+
+	printf("%u of %u images converted\n", unsigned(files.size()) - failures.load(), unsigned(files.size()));
+	return failures ? 1 : 0;
+}
+
 static fs::meta_data extract_meta_data(int &argc, char *argv[])
 {
 	fs::meta_data result;
@@ -703,6 +1017,8 @@ int CLIB_DECL main(int argc, char *argv[])
 			return identify(argc, argv);
 		else if(!core_stricmp("flopconvert", argv[1]))
 			return flopconvert(argc, argv);
+		else if(!core_stricmp("flopbatch", argv[1]))
+			return flopbatch(argc, argv);
 		else if(!core_stricmp("flopcreate", argv[1]))
 			return flopcreate(argc, argv);
 		else if(!core_stricmp("flopdir", argv[1]))
@@ -219,6 +219,7 @@ using util::BIT;
 #include "cpu/z8000/8000dasm.h"
 
 #include "corestr.h"
+#include "disasmtrace.h"
 #include "eminline.h"
 #include "endianness.h"
 #include "ioprocs.h"
@@ -386,6 +387,7 @@ struct options
 	uint32_t                skip;
 	uint32_t                count;
 	bool                    octal;
+	bool                    trace;
 };
 
 static const dasm_table_entry dasm_table[] =
@@ -1216,6 +1218,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 				opts->xchbytes = true;
 			else if(tolower((uint8_t)curarg[1]) == 'o')
 				opts->octal = true;
+			else if(tolower((uint8_t)curarg[1]) == 't')
+				opts->trace = true;
 			else
 				goto usage;
 
@@ -1262,8 +1266,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 	if(pending_base || pending_arch || pending_skip || pending_count)
 		goto usage;
 
-	// if no file or no architecture, fail
-	if(opts->filename == nullptr || opts->dasm == nullptr)
+	// if no file or no architecture, fail (traces name their own)
+	if(opts->filename == nullptr || (opts->dasm == nullptr && !opts->trace))
 		goto usage;
 
 	return 0;
@@ -1272,6 +1276,7 @@ usage:
 	printf("Usage: %s <filename> -arch <architecture> [-basepc <pc>] \n", argv[0]);
 	printf("   [-norawbytes] [-xchbytes] [-flipped] [-upper] [-lower]\n");
 	printf("   [-skip <n>] [-count <n>] [-octal]\n");
+	printf("       %s <filename> -trace [-arch <architecture>] [-upper] [-lower]\n", argv[0]);
 	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
@@ -1652,6 +1657,218 @@ int disasm_file(util::random_read &file, u64 length, options &opts)
 }
 
 
+// Sequential reader for binary traces, buffering the underlying file
+class trace_reader
+{
+public:
+	trace_reader(util::random_read &file) : m_file(file), m_pos(0) { }
+
+	bool get(void *dest, std::size_t length)
+	{
+		u8 *d = reinterpret_cast<u8 *>(dest);
+		while(length) {
+			if(m_pos == m_buffer.size() && !fill())
+				return false;
+			std::size_t const chunk = std::min(length, m_buffer.size() - m_pos);
+			std::memcpy(d, &m_buffer[m_pos], chunk);
+			m_pos += chunk;
+			d += chunk;
+			length -= chunk;
+		}
+		return true;
+	}
+
+	template<typename T> bool get(T &value)
+	{
+		u8 data[sizeof(T)];
+		if(!get(data, sizeof(T)))
+			return false;
+		u64 v = 0;
+		for(int i = 0; i != sizeof(T); i++)
+			v |= u64(data[i]) << (8*i);
+		value = T(v);
+		return true;
+	}
+
+	bool get_leb128(u64 &value)
+	{
+		value = 0;
+		for(int shift = 0; shift < 64; shift += 7) {
+			u8 byte;
+			if(!get(byte))
+				return false;
+			value |= u64(byte & 0x7f) << shift;
+			if(!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	bool get_string(std::string &str, std::size_t length)
+	{
+		str.resize(length);
+		return !length || get(&str[0], length);
+	}
+
+	bool eof()
+	{
+		return m_pos == m_buffer.size() && !fill();
+	}
+
+private:
+	bool fill()
+	{
+		m_buffer.resize(0x100000);
+		auto const [err, actual] = read(m_file, &m_buffer[0], m_buffer.size());
+		m_buffer.resize(err ? 0 : actual);
+		m_pos = 0;
+		return !m_buffer.empty();
+	}
+
+	util::random_read &m_file;
+	std::vector<u8> m_buffer;
+	std::size_t m_pos;
+};
+
+int disasm_trace(util::random_read &file, options &opts)
+{
+	trace_reader reader(file);
+
+	char magic[sizeof(util::disasm_trace::MAGIC)];
+	u8 flags, namelen;
+	std::string name;
+	if(!reader.get(magic, sizeof(magic)) || std::memcmp(magic, util::disasm_trace::MAGIC, sizeof(magic)) || !reader.get(flags) || !reader.get(namelen) || !reader.get_string(name, namelen)) {
+		std::fprintf(stderr, "File '%s' is not a binary trace\n", opts.filename);
+		return 1;
+	}
+
+	std::vector<std::string> registers;
+	if(flags & util::disasm_trace::FLAG_REGISTERS) {
+		u16 count;
+		if(!reader.get(count)) {
+			std::fprintf(stderr, "File '%s' has a truncated header\n", opts.filename);
+			return 1;
+		}
+		registers.resize(count);
+		for(auto &reg : registers)
+			if(!reader.get(namelen) || !reader.get_string(reg, namelen)) {
+				std::fprintf(stderr, "File '%s' has a truncated header\n", opts.filename);
+				return 1;
+			}
+	}
+
+	// The trace names the device, which normally matches a disassembler
+	if(!opts.dasm) {
+		auto const arch = std::find_if(
+				std::begin(dasm_table),
+				std::end(dasm_table),
+				[&name] (dasm_table_entry const &e) { return !core_stricmp(name, e.name); });
+		if(std::end(dasm_table) == arch) {
+			std::fprintf(stderr, "No disassembler named '%s', use -arch to select one\n", name.c_str());
+			return 1;
+		}
+		opts.dasm = &*arch;
+	}
+
+	std::unique_ptr<util::disasm_interface> disasm(opts.dasm->alloc());
+	unidasm_data_buffer buffer(disasm.get(), opts.dasm);
+
+	// Opcode bytes are recorded little-endian per opcode unit on word
+	// addressed cpus, undo that for big-endian ones
+	int const unit = opts.dasm->pcshift < 0 ? 1 << -opts.dasm->pcshift : 1;
+	bool const swap = unit > 1 && opts.dasm->endian == be;
+
+	auto const tf = [&opts] (std::string &&str) -> std::string {
+		if(opts.lower)
+			std::transform(str.begin(), str.end(), str.begin(), [](char c) { return tolower(c); });
+		else if(opts.upper)
+			std::transform(str.begin(), str.end(), str.begin(), [](char c) { return toupper(c); });
+		return std::move(str);
+	};
+
+	u64 cycles = 0;
+	std::string text;
+	while(!reader.eof()) {
+		u8 type;
+		if(!reader.get(type))
+			break;
+
+		switch(type) {
+		case util::disasm_trace::RECORD_INSN: {
+			u32 pc;
+			u64 delta;
+			u8 length;
+			if(!reader.get(pc) || !reader.get_leb128(delta) || !reader.get(length))
+				goto truncated;
+			buffer.data.resize(length + 8);
+			std::fill(buffer.data.begin(), buffer.data.end(), 0);
+			if(length && !reader.get(&buffer.data[0], length))
+				goto truncated;
+			if(swap)
+				for(int i = 0; i + unit <= length; i += unit)
+					std::reverse(&buffer.data[i], &buffer.data[i + unit]);
+			buffer.base_pc = pc;
+			buffer.size = length;
+			cycles += delta;
+
+			std::ostringstream stream;
+			disasm->disassemble(stream, pc, buffer, buffer);
+			std::string line = util::string_format("%12d %08x: %s", cycles, pc, tf(stream.str()));
+
+			if(!registers.empty()) {
+				u16 count;
+				if(!reader.get(count))
+					goto truncated;
+				for(int i = 0; i != count; i++) {
+					u16 index;
+					u64 value;
+					if(!reader.get(index) || !reader.get(value) || index >= registers.size())
+						goto truncated;
+					line += util::string_format("%s%s=%X", i ? " " : "   ; ", registers[index], value);
+				}
+			}
+			std::cout << line << '\n';
+			break;
+		}
+
+		case util::disasm_trace::RECORD_IRQ: {
+			u32 pc;
+			int32_t irqline;
+			if(!reader.get(pc) || !reader.get(irqline))
+				goto truncated;
+			util::stream_format(std::cout, "\n   (interrupted at %08x, IRQ %d)\n\n", pc, irqline);
+			break;
+		}
+
+		case util::disasm_trace::RECORD_LOOP: {
+			u32 loops;
+			if(!reader.get(loops))
+				goto truncated;
+			util::stream_format(std::cout, "\n   (loops for %d instructions)\n\n", loops);
+			break;
+		}
+
+		case util::disasm_trace::RECORD_TEXT: {
+			u32 length;
+			if(!reader.get(length) || !reader.get_string(text, length))
+				goto truncated;
+			std::cout << text;
+			break;
+		}
+
+		default:
+			std::fprintf(stderr, "Unknown record type %d in '%s'\n", type, opts.filename);
+			return 1;
+		}
+	}
+	return 0;
+
+truncated:
+	std::fprintf(stderr, "File '%s' is truncated\n", opts.filename);
+	return 1;
+}
+
+
 int main(int argc, char *argv[])
 {
 	// Parse options first
@@ -1713,7 +1930,7 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	int result = disasm_file(*file, length, opts);
+	int result = opts.trace ? disasm_trace(*file, opts) : disasm_file(*file, length, opts);
 
 	file.reset();
 	std::free(data);
@@ -0,0 +1,178 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "debug/express.h"
+
+#include <memory>
+#include <string>
+
+// memory references make the expression engine look up devices and
+// regions; these tests don't use them, so there is nothing to find
+memory_region *device_t::memregion(std::string_view) const { return nullptr; }
+device_t *device_t::subdevice_slow(std::string_view) const { return nullptr; }
+
+namespace {
+
+// these tests never touch memory or devices, so the symbol table only
+// needs something to hold a reference to
+struct expression_fixture
+{
+   expression_fixture()
+      : machine_storage(new u64[64])
+      , symtable(*reinterpret_cast<running_machine *>(machine_storage.get()))
+   {
+      symtable.add("seven", 7);
+      symtable.add("a", symbol_table::READ_WRITE, &a);
+      symtable.add("b", symbol_table::READ_WRITE, &b);
+      symtable.add("z", symbol_table::READ_WRITE, &scratch);
+      symtable.add("counter", [this] () { reads.push_back('c'); return ++counter; });
+      symtable.add("tick", [this] () { reads.push_back('t'); return u64(10); });
+      symtable.add("max", 2, 8, [] (int params, const u64 *param) {
+         u64 result = param[0];
+         for (int index = 1; index < params; index++)
+            if (param[index] > result)
+               result = param[index];
+         return result;
+      });
+   }
+
+   // the interpreter runs the whole expression when it contains an
+   // assignment, and the comma operator yields its right-hand side
+   u64 interpreted(std::string const &text)
+   {
+      parsed_expression expr(symtable, "z=0," + text);
+      REQUIRE(!expr.is_compiled());
+      return expr.execute();
+   }
+
+   std::unique_ptr<u64 []> machine_storage;
+   symbol_table symtable;
+   u64 a = 0x1234;
+   u64 b = 3;
+   u64 counter = 0;
+   u64 scratch = 0;
+   std::string reads;
+};
+
+} // anonymous namespace
+
+TEST_CASE("compiled expressions match the interpreter", "[emu]")
+{
+   expression_fixture fixture;
+
+   struct { char const *text; u64 expected; } const cases[] = {
+      { "1+2*3", 7 },
+      { "(1+2)*3", 9 },
+      { "a+b", 0x1237 },
+      { "a-b-1", 0x1230 },
+      { "a/b", 0x1234 / 3 },
+      { "a%b", 0x1234 % 3 },
+      { "a<<4", 0x12340 },
+      { "a>>b", 0x1234 >> 3 },
+      { "a&ff", 0x34 },
+      { "a|1", 0x1235 },
+      { "a^a", 0 },
+      { "~0", ~u64(0) },
+      { "-1", ~u64(0) },
+      { "!a", 0 },
+      { "!0", 1 },
+      { "a>b", 1 },
+      { "a<=b", 0 },
+      { "a==1234", 1 },
+      { "a!=1234", 0 },
+      { "b&&0", 0 },
+      { "b||0", 1 },
+      { "-1<0", 0 },
+      { "seven*seven", 49 },
+      { "max(1,a,b)", 0x1234 },
+      { "max(b,seven)", 7 },
+      { "1,2,3", 3 },
+      { "b*(a+seven)", 3 * (0x1234 + 7) }
+   };
+
+   for (auto const &c : cases)
+   {
+      INFO(c.text);
+      parsed_expression expr(fixture.symtable, c.text);
+      REQUIRE(expr.is_compiled());
+      REQUIRE(expr.execute() == c.expected);
+      REQUIRE(fixture.interpreted(c.text) == c.expected);
+   }
+}
+
+TEST_CASE("compiled expressions see symbol changes", "[emu]")
+{
+   expression_fixture fixture;
+   parsed_expression expr(fixture.symtable, "a*2+b");
+   REQUIRE(expr.is_compiled());
+   REQUIRE(expr.execute() == 0x246b);
+
+   fixture.a = 1;
+   fixture.b = 0;
+   REQUIRE(expr.execute() == 2);
+}
+
+TEST_CASE("compiled expressions read symbols like the interpreter", "[emu]")
+{
+   expression_fixture fixture;
+
+   // numbers are hexadecimal by default
+   parsed_expression expr(fixture.symtable, "counter*100+tick+counter");
+   REQUIRE(expr.is_compiled());
+   REQUIRE(expr.execute() == 0x100 + 0xa + 2);
+   std::string const compiled = fixture.reads;
+
+   fixture.reads.clear();
+   fixture.counter = 0;
+   REQUIRE(fixture.interpreted("counter*100+tick+counter") == 0x100 + 0xa + 2);
+   REQUIRE(fixture.reads == compiled);
+}
+
+TEST_CASE("expressions with side effects are interpreted", "[emu]")
+{
+   expression_fixture fixture;
+
+   parsed_expression assign(fixture.symtable, "a=b+1");
+   REQUIRE(!assign.is_compiled());
+   REQUIRE(assign.execute() == 4);
+   REQUIRE(fixture.a == 4);
+
+   parsed_expression increment(fixture.symtable, "b++");
+   REQUIRE(!increment.is_compiled());
+   REQUIRE(increment.execute() == 3);
+   REQUIRE(fixture.b == 4);
+}
+
+TEST_CASE("expressions report division by zero", "[emu]")
+{
+   expression_fixture fixture;
+   fixture.b = 0;
+
+   parsed_expression divide(fixture.symtable, "a/b");
+   REQUIRE(divide.is_compiled());
+   REQUIRE_THROWS_AS(divide.execute(), expression_error);
+   REQUIRE_THROWS_AS(fixture.interpreted("a/b"), expression_error);
+
+   parsed_expression modulo(fixture.symtable, "a%b");
+   REQUIRE(modulo.is_compiled());
+   REQUIRE_THROWS_AS(modulo.execute(), expression_error);
+   REQUIRE_THROWS_AS(fixture.interpreted("a%b"), expression_error);
+}
+
+TEST_CASE("copied expressions are compiled", "[emu]")
+{
+   expression_fixture fixture;
+   parsed_expression original(fixture.symtable, "a+b*2");
+   REQUIRE(original.is_compiled());
+
+   parsed_expression copied(original);
+   REQUIRE(copied.is_compiled());
+   REQUIRE(copied.execute() == original.execute());
+
+   parsed_expression assigned(fixture.symtable, "1");
+   assigned = original;
+   assigned = assigned;
+   REQUIRE(assigned.is_compiled());
+   REQUIRE(std::string(assigned.original_string()) == "a+b*2");
+   REQUIRE(assigned.execute() == 0x123a);
+}
@@ -0,0 +1,113 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "eminline.h"
+#include "debug/memsearch.h"
+
+#include <vector>
+
+TEST_CASE("memory search condition names", "[emu]")
+{
+   debug_memory_search::condition cond;
+   REQUIRE(debug_memory_search::parse_condition("eq", cond));
+   REQUIRE(cond == debug_memory_search::condition::EQ);
+   REQUIRE(debug_memory_search::parse_condition("gtv", cond));
+   REQUIRE(cond == debug_memory_search::condition::GTV);
+   REQUIRE(debug_memory_search::parse_condition("delta", cond));
+   REQUIRE(cond == debug_memory_search::condition::DELTA);
+   REQUIRE(!debug_memory_search::parse_condition("EQ", cond));
+   REQUIRE(!debug_memory_search::parse_condition("", cond));
+}
+
+TEST_CASE("memory search starts with every position", "[emu]")
+{
+   debug_memory_search bytes(16, 1, ENDIANNESS_LITTLE, false);
+   REQUIRE(bytes.count() == 16);
+
+   debug_memory_search words(16, 2, ENDIANNESS_LITTLE, false);
+   REQUIRE(words.count() == 8);
+   REQUIRE(words.matches(3) == (std::vector<size_t>{ 0, 2, 4 }));
+
+   // unaligned candidates stop where a whole value no longer fits
+   debug_memory_search stepped(16, 4, ENDIANNESS_LITTLE, false, 1);
+   REQUIRE(stepped.count() == 13);
+
+   debug_memory_search tiny(3, 4, ENDIANNESS_LITTLE, false);
+   REQUIRE(tiny.count() == 0);
+   REQUIRE(tiny.matches().empty());
+}
+
+TEST_CASE("memory search narrows across snapshots", "[emu]")
+{
+   u8 const first[8]  = { 5, 1, 5, 2, 5, 3, 5, 4 };
+   u8 const second[8] = { 5, 1, 6, 2, 5, 9, 4, 4 };
+   u8 const third[8]  = { 7, 1, 6, 2, 5, 9, 4, 4 };
+
+   debug_memory_search search(8, 1, ENDIANNESS_LITTLE, false);
+   search.filter(first, nullptr, debug_memory_search::condition::EQV, 5);
+   REQUIRE(search.matches() == (std::vector<size_t>{ 0, 2, 4, 6 }));
+
+   search.filter(second, first, debug_memory_search::condition::EQ, 0);
+   REQUIRE(search.matches() == (std::vector<size_t>{ 0, 4 }));
+
+   search.filter(third, second, debug_memory_search::condition::GT, 0);
+   REQUIRE(search.matches() == (std::vector<size_t>{ 0 }));
+   REQUIRE(search.count() == 1);
+
+   search.reset();
+   REQUIRE(search.count() == 8);
+}
+
+TEST_CASE("memory search byte order and sign", "[emu]")
+{
+   // 0x0102, 0xff00 and 0x0080 as big-endian words
+   u8 const data[6] = { 0x01, 0x02, 0xff, 0x00, 0x00, 0x80 };
+
+   debug_memory_search big(6, 2, ENDIANNESS_BIG, false);
+   REQUIRE(big.value(data, 0) == 0x0102);
+   big.filter(data, nullptr, debug_memory_search::condition::GTV, 0x0100);
+   REQUIRE(big.matches() == (std::vector<size_t>{ 0, 2 }));
+
+   debug_memory_search little(6, 2, ENDIANNESS_LITTLE, false);
+   REQUIRE(little.value(data, 0) == 0x0201);
+
+   // 0xff00 is negative when signed
+   debug_memory_search sbig(6, 2, ENDIANNESS_BIG, true);
+   REQUIRE(sbig.value(data, 2) == u64(s64(-256)));
+   sbig.filter(data, nullptr, debug_memory_search::condition::LTV, 0);
+   REQUIRE(sbig.matches() == (std::vector<size_t>{ 2 }));
+}
+
+TEST_CASE("memory search delta does not wrap", "[emu]")
+{
+   u8 const before[2] = { 250, 10 };
+   u8 const after[2]  = { 4, 20 };
+
+   debug_memory_search wrapped(2, 1, ENDIANNESS_LITTLE, false);
+   wrapped.filter(after, before, debug_memory_search::condition::DELTA, 10);
+   REQUIRE(wrapped.matches() == (std::vector<size_t>{ 1 }));
+
+   debug_memory_search negative(2, 1, ENDIANNESS_LITTLE, false);
+   negative.filter(after, before, debug_memory_search::condition::DELTA, u64(s64(-246)));
+   REQUIRE(negative.matches() == (std::vector<size_t>{ 0 }));
+}
+
+TEST_CASE("memory search keeps sparse matches across words", "[emu]")
+{
+   // enough candidates to span several 64-candidate words
+   std::vector<u8> data(1000, 0);
+   data[3] = 1;
+   data[130] = 1;
+   data[999] = 1;
+
+   debug_memory_search search(data.size(), 1, ENDIANNESS_LITTLE, false);
+   search.filter(&data[0], nullptr, debug_memory_search::condition::NEV, 0);
+   REQUIRE(search.count() == 3);
+   REQUIRE(search.matches() == (std::vector<size_t>{ 3, 130, 999 }));
+   REQUIRE(search.matches(2) == (std::vector<size_t>{ 3, 130 }));
+
+   // narrowing a sparse set only visits the survivors
+   data[130] = 2;
+   search.filter(&data[0], nullptr, debug_memory_search::condition::EQV, 1);
+   REQUIRE(search.matches() == (std::vector<size_t>{ 3, 999 }));
+}
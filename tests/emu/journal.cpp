@@ -0,0 +1,92 @@
+#include "catch.hpp"
+
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+#include "journalfmt.h"
+
+#include "ioprocsvec.h"
+
+#include <vector>
+
+namespace {
+
+std::vector<u8> encode(u64 value)
+{
+   u8 buffer[10];
+   unsigned const length = journal_format::encode_number(buffer, value);
+   return std::vector<u8>(buffer, buffer + length);
+}
+
+bool decode(std::vector<u8> data, u64 &value)
+{
+   util::vector_read_write_adapter<u8> stream(data);
+   return journal_format::decode_number(stream, value);
+}
+
+} // anonymous namespace
+
+TEST_CASE("journal numbers use LEB128", "[emu]")
+{
+   REQUIRE(encode(0) == std::vector<u8>{ 0x00 });
+   REQUIRE(encode(0x7f) == std::vector<u8>{ 0x7f });
+   REQUIRE(encode(0x80) == (std::vector<u8>{ 0x80, 0x01 }));
+   REQUIRE(encode(624485) == (std::vector<u8>{ 0xe5, 0x8e, 0x26 }));
+   REQUIRE(encode(~u64(0)).size() == 10);
+}
+
+TEST_CASE("journal numbers round trip", "[emu]")
+{
+   for (u64 const value : { u64(0), u64(1), u64(0x7f), u64(0x80), u64(0x3fff), u64(0x4000), u64(0xffffffff), u64(1) << 63, ~u64(0) })
+   {
+      u64 result = 0;
+      REQUIRE(decode(encode(value), result));
+      REQUIRE(result == value);
+   }
+}
+
+TEST_CASE("journal numbers are read back to back", "[emu]")
+{
+   std::vector<u8> data;
+   for (u64 const value : { u64(300), u64(0), u64(1) << 40 })
+   {
+      auto const bytes = encode(value);
+      data.insert(data.end(), bytes.begin(), bytes.end());
+   }
+   util::vector_read_write_adapter<u8> stream(data);
+   u64 a, b, c, d;
+   REQUIRE(journal_format::decode_number(stream, a));
+   REQUIRE(journal_format::decode_number(stream, b));
+   REQUIRE(journal_format::decode_number(stream, c));
+   REQUIRE(a == 300);
+   REQUIRE(b == 0);
+   REQUIRE(c == (u64(1) << 40));
+   REQUIRE_FALSE(journal_format::decode_number(stream, d));
+}
+
+TEST_CASE("journal rejects truncated and overlong numbers", "[emu]")
+{
+   u64 value;
+   REQUIRE_FALSE(decode(std::vector<u8>{ }, value));
+   REQUIRE_FALSE(decode(std::vector<u8>{ 0x80, 0x80 }, value));
+   REQUIRE_FALSE(decode(std::vector<u8>(10, 0x80), value));
+}
+
+TEST_CASE("journal record times round trip", "[emu]")
+{
+   attotime const base(12, 345);
+   for (attotime const now : { base, attotime(12, 346), attotime(13, 0), attotime(11, ATTOSECONDS_PER_SECOND - 1), attotime::zero })
+   {
+      auto const [seconds, attoseconds] = journal_format::encode_time(base, now);
+      REQUIRE(((seconds & 1) != 0) == (now < base));
+      attotime result;
+      REQUIRE(journal_format::decode_time(base, seconds, attoseconds, result));
+      REQUIRE(result == now);
+   }
+}
+
+TEST_CASE("journal rejects malformed record times", "[emu]")
+{
+   attotime result;
+   REQUIRE_FALSE(journal_format::decode_time(attotime::zero, 0, u64(ATTOSECONDS_PER_SECOND), result));
+}